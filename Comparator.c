@@ -1,24 +1,159 @@
 #include "Comparator.h"
+#include "HashTableCommon.h"
+#include <time.h>
 
 static uint32_t skipLeadingSpacesOrZeroes(const char* text, int32_t *numberOfZeroes);
 static int32_t compareRight(const char *one, const char *two);
 static int32_t compareEqual(const char *one, const char *two, int32_t numberOfZeroesOne, int32_t numberOfZeroesTwo);
+static uint32_t fnv1aHash(const char *key, uint32_t length, uint32_t hash);
+static uint32_t wyHash(const char *key, uint32_t length, uint64_t seed);
 
 static inline bool isNotDigitAndPunct(char ch) {
     return !isdigit(ch) && ch != '.' && ch != ',';
 }
 
+#define WY_SECRET_0 0x2d358dccaa6c78a5ull
+#define WY_SECRET_1 0x8bb84b93962eacc9ull
+#define WY_SECRET_2 0x4b33a62ed433d4a3ull
+#define WY_SECRET_3 0x4d5a2da51de1aa47ull
+
+static inline void wyMultiply(uint64_t *a, uint64_t *b) {   // 64x64->128 bit multiply, low half to `a` and high half to `b`
+#if defined(__SIZEOF_INT128__)
+    __uint128_t result = (__uint128_t) *a * *b;
+    *a = (uint64_t) result;
+    *b = (uint64_t) (result >> 64);
+#else
+    uint64_t highA = *a >> 32;
+    uint64_t highB = *b >> 32;
+    uint64_t lowA = (uint32_t) *a;
+    uint64_t lowB = (uint32_t) *b;
+    uint64_t high = highA * highB;
+    uint64_t middle0 = highA * lowB;
+    uint64_t middle1 = highB * lowA;
+    uint64_t low = lowA * lowB;
+    uint64_t tmp = low + (middle0 << 32);
+    uint64_t carry = tmp < low;
+    uint64_t result = tmp + (middle1 << 32);
+    carry += result < tmp;
+    *a = result;
+    *b = high + (middle0 >> 32) + (middle1 >> 32) + carry;
+#endif
+}
+
+static inline uint64_t wyMix(uint64_t a, uint64_t b) {
+    wyMultiply(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t wyRead8(const uint8_t *data) {   // Unaligned native endian read, compiles to single load
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static inline uint64_t wyRead4(const uint8_t *data) {
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
 
 uint32_t strHashCode(const char *key) {  // Returns a hashCode code for the provided string.
-    uint32_t hash = 2166136261u;
-    uint32_t keyLength = strlen(key);
-    for (uint32_t i = 0; i < keyLength; i++) {
+    return strHashCodeN(key, strlen(key));
+}
+
+uint32_t strHashCodeN(const char *key, uint32_t length) {
+#if STR_HASH_ALGORITHM == STR_HASH_WYHASH
+    return wyHashCode(key, length);
+#else
+    return fnv1aHashCode(key, length);
+#endif
+}
+
+uint32_t fnv1aHashCode(const char *key, uint32_t length) {
+    return fnv1aHash(key, length, 2166136261u);
+}
+
+uint32_t wyHashCode(const char *key, uint32_t length) {
+    return wyHash(key, length, 0);
+}
+
+uint32_t strHashCodeSeeded(const char *key, uint32_t length, uint32_t seed) {
+#if STR_HASH_ALGORITHM == STR_HASH_WYHASH
+    return wyHash(key, length, seed);
+#else
+    return seededHashCode(fnv1aHash(key, length, 2166136261u ^ seed), seed);   // low bits of FNV-1a don't depend on high bits of bytes, so mix all of them
+#endif
+}
+
+uint32_t hashSeedNext(void) {    // Weak default seed from clock, stack address and call counter, enough to make each map differ
+    static uint32_t counter = 0;
+    uint32_t stackMark = 0;
+#if defined(__ATOMIC_RELAXED) && defined(__GCC_ATOMIC_INT_LOCK_FREE) && __GCC_ATOMIC_INT_LOCK_FREE == 2 && __SIZEOF_INT__ == 4
+    uint32_t count = __atomic_add_fetch(&counter, 1, __ATOMIC_RELAXED);   // Maps can be created from any thread, e.g. ConcurrentHashMap shards
+#else
+    uint32_t count = ++counter;
+#endif
+    uint64_t state = (uint64_t) time(NULL) ^ ((uint64_t) clock() << 32) ^ (uint64_t) (uintptr_t) &stackMark;
+    state = wyMix(state ^ WY_SECRET_0, count ^ WY_SECRET_1);
+    return (uint32_t) (state ^ (state >> 32));
+}
+
+static uint32_t fnv1aHash(const char *key, uint32_t length, uint32_t hash) {
+    for (uint32_t i = 0; i < length; i++) {
         hash ^= (uint8_t) key[i];
         hash *= 16777619;
     }
     return hash;
 }
 
+static uint32_t wyHash(const char *key, uint32_t length, uint64_t seed) {  // wyhash final4 by Wang Yi (public domain) with default secret
+    const uint8_t *data = (const uint8_t *) key;
+    seed ^= wyMix(seed ^ WY_SECRET_0, WY_SECRET_1);
+    uint64_t a;
+    uint64_t b;
+
+    if (length <= 16) {
+        if (length >= 4) {
+            a = (wyRead4(data) << 32) | wyRead4(data + ((length >> 3) << 2));
+            b = (wyRead4(data + length - 4) << 32) | wyRead4(data + length - 4 - ((length >> 3) << 2));
+        } else if (length > 0) {
+            a = ((uint64_t) data[0] << 16) | ((uint64_t) data[length >> 1] << 8) | data[length - 1];
+            b = 0;
+        } else {
+            a = 0;
+            b = 0;
+        }
+    } else {
+        uint32_t remaining = length;
+        if (remaining > 48) {   // Three independent lanes keep multiplier busy
+            uint64_t seed1 = seed;
+            uint64_t seed2 = seed;
+            do {
+                seed = wyMix(wyRead8(data) ^ WY_SECRET_1, wyRead8(data + 8) ^ seed);
+                seed1 = wyMix(wyRead8(data + 16) ^ WY_SECRET_2, wyRead8(data + 24) ^ seed1);
+                seed2 = wyMix(wyRead8(data + 32) ^ WY_SECRET_3, wyRead8(data + 40) ^ seed2);
+                data += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (remaining > 16) {
+            seed = wyMix(wyRead8(data) ^ WY_SECRET_1, wyRead8(data + 8) ^ seed);
+            data += 16;
+            remaining -= 16;
+        }
+        a = wyRead8(data + remaining - 16);
+        b = wyRead8(data + remaining - 8);
+    }
+
+    a ^= WY_SECRET_1;
+    b ^= seed;
+    wyMultiply(&a, &b);
+    uint64_t hash = wyMix(a ^ WY_SECRET_0 ^ length, b ^ WY_SECRET_1);
+    return (uint32_t) (hash ^ (hash >> 32));
+}
+
 int doubleComparator(double one, double two) {
     if (one < two) {
         return -1;           // Neither val is NaN, 'one' is smaller
@@ -0,0 +1,168 @@
+#include "ConcurrentHashMap.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SHARD_SIZE_STORE(SHARD) __atomic_store_n(&(SHARD)->size, (SHARD)->hashMap->size, __ATOMIC_RELAXED)
+#define SHARD_SIZE_LOAD(SHARD) __atomic_load_n(&(SHARD)->size, __ATOMIC_RELAXED)
+#else
+#define SHARD_SIZE_STORE(SHARD) (*(volatile uint32_t *) &(SHARD)->size = (SHARD)->hashMap->size)
+#define SHARD_SIZE_LOAD(SHARD) (*(volatile uint32_t *) &(SHARD)->size)
+#endif
+
+static ConcurrentHashMap createConcurrentHashMap(uint32_t capacity, uint32_t shardCount, bool isKeyOwner);
+static ConcurrentHashMapShard *selectShard(ConcurrentHashMap map, const char *key, uint32_t length, uint32_t *hash);
+static void deleteShards(ConcurrentHashMap map, uint32_t count);
+
+
+ConcurrentHashMap getConcurrentHashMapInstance(uint32_t capacity, uint32_t shardCount) {
+    return createConcurrentHashMap(capacity, shardCount, false);
+}
+
+ConcurrentHashMap getKeyOwningConcurrentHashMapInstance(uint32_t capacity, uint32_t shardCount) {
+    return createConcurrentHashMap(capacity, shardCount, true);
+}
+
+bool concurrentHashMapPut(ConcurrentHashMap map, const char *key, MapValueType value) {
+    return key != NULL ? concurrentHashMapPutN(map, key, strlen(key), value) : false;
+}
+
+bool concurrentHashMapPutN(ConcurrentHashMap map, const char *key, uint32_t length, MapValueType value) {
+    if (map == NULL || key == NULL) return false;
+    uint32_t hash;
+    ConcurrentHashMapShard *shard = selectShard(map, key, length, &hash);
+    pthread_rwlock_wrlock(&shard->lock);
+    bool isPut = hashMapPutWithHash(shard->hashMap, key, length, hash, value);
+    SHARD_SIZE_STORE(shard);
+    pthread_rwlock_unlock(&shard->lock);
+    return isPut;
+}
+
+MapValueType concurrentHashMapGet(ConcurrentHashMap map, const char *key) {
+    return key != NULL ? concurrentHashMapGetN(map, key, strlen(key)) : (MapValueType) NULL;
+}
+
+MapValueType concurrentHashMapGetN(ConcurrentHashMap map, const char *key, uint32_t length) {
+    if (map == NULL || key == NULL) return (MapValueType) NULL;
+    uint32_t hash;
+    ConcurrentHashMapShard *shard = selectShard(map, key, length, &hash);
+    pthread_rwlock_rdlock(&shard->lock);    // HashMap lookup never writes to the table, so readers share the shard
+    MapValueType value = hashMapGetWithHash(shard->hashMap, key, length, hash);
+    pthread_rwlock_unlock(&shard->lock);
+    return value;
+}
+
+MapValueType concurrentHashMapRemove(ConcurrentHashMap map, const char *key) {
+    return key != NULL ? concurrentHashMapRemoveN(map, key, strlen(key)) : (MapValueType) NULL;
+}
+
+MapValueType concurrentHashMapRemoveN(ConcurrentHashMap map, const char *key, uint32_t length) {
+    if (map == NULL || key == NULL) return (MapValueType) NULL;
+    uint32_t hash;
+    ConcurrentHashMapShard *shard = selectShard(map, key, length, &hash);
+    pthread_rwlock_wrlock(&shard->lock);
+    MapValueType value = hashMapRemoveWithHash(shard->hashMap, key, length, hash);
+    SHARD_SIZE_STORE(shard);
+    pthread_rwlock_unlock(&shard->lock);
+    return value;
+}
+
+MapValueType concurrentHashMapCompute(ConcurrentHashMap map, const char *key, MapComputeFunction function, void *context) {
+    if (map == NULL || key == NULL || function == NULL) return (MapValueType) NULL;
+    uint32_t length = strlen(key);
+    uint32_t hash;
+    ConcurrentHashMapShard *shard = selectShard(map, key, length, &hash);
+    pthread_rwlock_wrlock(&shard->lock);    // Read, remap and write are atomic for other users of this key
+    MapValueType value = hashMapComputeWithHash(shard->hashMap, key, length, hash, function, context);
+    SHARD_SIZE_STORE(shard);
+    pthread_rwlock_unlock(&shard->lock);
+    return value;
+}
+
+bool isConcurrentHashMapContainsKey(ConcurrentHashMap map, const char *key) {
+    if (map == NULL || key == NULL) return false;
+    uint32_t length = strlen(key);
+    uint32_t hash;
+    ConcurrentHashMapShard *shard = selectShard(map, key, length, &hash);
+    pthread_rwlock_rdlock(&shard->lock);
+    bool isContains = hashMapGetEntryWithHash(shard->hashMap, key, length, hash) != NULL;
+    pthread_rwlock_unlock(&shard->lock);
+    return isContains;
+}
+
+void concurrentHashMapClear(ConcurrentHashMap map) {    // Shards are cleared one by one, puts to already cleared shards are kept
+    if (map == NULL) return;
+    for (uint32_t i = 0; i < map->shardCount; i++) {
+        ConcurrentHashMapShard *shard = &map->shards[i];
+        pthread_rwlock_wrlock(&shard->lock);
+        hashMapClear(shard->hashMap);
+        SHARD_SIZE_STORE(shard);
+        pthread_rwlock_unlock(&shard->lock);
+    }
+}
+
+uint32_t getConcurrentHashMapSize(ConcurrentHashMap map) {  // Striped counter, writers of different shards never touch the same size field
+    if (map == NULL) return 0;
+    uint32_t size = 0;
+    for (uint32_t i = 0; i < map->shardCount; i++) {
+        size += SHARD_SIZE_LOAD(&map->shards[i]);
+    }
+    return size;
+}
+
+bool isConcurrentHashMapEmpty(ConcurrentHashMap map) {
+    return getConcurrentHashMapSize(map) == 0;
+}
+
+void concurrentHashMapDelete(ConcurrentHashMap map) {   // No other thread may use the map during and after delete
+    if (map != NULL) {
+        deleteShards(map, map->shardCount);
+        free(map);
+    }
+}
+
+static ConcurrentHashMap createConcurrentHashMap(uint32_t capacity, uint32_t shardCount, bool isKeyOwner) {
+    if (shardCount == 0) {
+        shardCount = CONCURRENT_HASH_MAP_SHARD_COUNT;
+    }
+    uint32_t shardBits = 0;
+    while ((1UL << shardBits) < shardCount && shardBits < 16) {
+        shardBits++;
+    }
+
+    ConcurrentHashMap map = malloc(sizeof(struct ConcurrentHashMap));
+    if (map == NULL) return NULL;
+    map->shardCount = 1 << shardBits;
+    map->shardShift = 32 - shardBits;
+    map->isKeyOwner = isKeyOwner;
+    map->shards = calloc(map->shardCount, sizeof(ConcurrentHashMapShard));
+    if (map->shards == NULL) {
+        free(map);
+        return NULL;
+    }
+
+    uint32_t shardCapacity = capacity > map->shardCount ? capacity / map->shardCount : 1;
+    for (uint32_t i = 0; i < map->shardCount; i++) {
+        ConcurrentHashMapShard *shard = &map->shards[i];
+        shard->hashMap = isKeyOwner ? getKeyOwningHashMapInstance(shardCapacity) : getHashMapInstance(shardCapacity);
+        if (shard->hashMap == NULL || pthread_rwlock_init(&shard->lock, NULL) != 0) {
+            hashMapDelete(shard->hashMap);
+            deleteShards(map, i);
+            free(map);
+            return NULL;
+        }
+        shard->hashMap->seed = map->shards[0].hashMap->seed;    // Empty tables, so seed can be shared for single hash of each key
+    }
+    return map;
+}
+
+static ConcurrentHashMapShard *selectShard(ConcurrentHashMap map, const char *key, uint32_t length, uint32_t *hash) {
+    *hash = hashMapKeyHashCode(map->shards[0].hashMap, key, length);
+    return &map->shards[(uint32_t) ((uint64_t) *hash >> map->shardShift)];  // 64-bit shift gives shard 0 for single shard map
+}
+
+static void deleteShards(ConcurrentHashMap map, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        pthread_rwlock_destroy(&map->shards[i].lock);
+        hashMapDelete(map->shards[i].hashMap);
+    }
+    free(map->shards);
+}
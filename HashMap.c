@@ -1,9 +1,36 @@
 #include "HashMap.h"
-
-static MapEntry *findEntry(MapEntry *entries, uint32_t capacity, const char *key);
+#include "Comparator.h"
+
+static MapEntry *findEntry(MapEntry *entries, uint32_t capacity, const char *key, uint32_t length, uint32_t hash, uint16_t generation);
+static MapEntry *findExistingEntry(MapEntry *entries, uint32_t capacity, const char *key, uint32_t length, uint32_t hash, uint16_t generation);
+static MapEntry *lookupEntry(HashMap hashMap, const char *key, uint32_t length, uint32_t hash);
+static MapEntry *upsertEntry(HashMap hashMap, const char *key, uint32_t length, uint32_t hash, MapValueType value);
+static MapEntry *probeEntry(HashMap hashMap, const char *key, uint32_t length, uint32_t hash, MapEntry **freeEntry);
+static MapEntry *commitEntry(HashMap hashMap, MapEntry *freeEntry, const char *key, uint32_t length, uint32_t hash, MapValueType value);
+#ifdef HASH_MAP_ROBIN_HOOD
+static MapEntry *insertEntry(MapEntry *entries, uint32_t capacity, MapEntry entry, uint16_t generation);
+#else
+static MapEntry *findEmptyEntry(MapEntry *entries, uint32_t capacity, uint32_t hash, uint16_t generation);
+#endif
+static bool isLiveEntry(const MapEntry *entry, uint16_t generation);
+static void refreshEntry(MapEntry *entry, uint16_t generation);
+static void sweepStaleEntries(HashMap hashMap);
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+static void migrateEntries(HashMap hashMap, uint32_t slotCount);
+static void vacateEntry(MapEntry *entry);
+static bool isOldTableEntry(HashMap hashMap, MapEntry *entry);
+#endif
+static char *storeKey(HashMap hashMap, const char *key, uint32_t length);
+static bool isKeyArenaFragmented(HashMap hashMap);
+static bool reallocateKeyArena(HashMap hashMap, uint32_t reserveSize, bool isCompacted, char **previousArena);
+static uint32_t moveKeys(MapEntry *entries, uint32_t capacity, char *arena, uint32_t arenaSize);
+static void rebaseKeys(MapEntry *entries, uint32_t capacity, const char *fromArena, char *toArena);
 static uint32_t nextPowerOfTwo(uint32_t capacity);
-static uint32_t hashCode(const char *key);
+static uint32_t capacityForSize(uint32_t size);
 static bool adjustHashMapCapacity(HashMap hashMap, uint32_t capacity);
+#ifdef HASH_MAP_STATS
+static void addProbeLengths(HashTableStats *stats, MapEntry *entries, uint32_t capacity, uint16_t generation);
+#endif
 
 
 HashMap getHashMapInstance(uint32_t capacity) {
@@ -13,6 +40,21 @@ HashMap getHashMapInstance(uint32_t capacity) {
     hashMapInstance->size = 0;
     hashMapInstance->capacity = nextPowerOfTwo(capacity);
     hashMapInstance->deletedItemsCount = 0;
+    hashMapInstance->seed = HASH_MAP_NEW_SEED();
+    hashMapInstance->isKeyOwner = false;
+    hashMapInstance->keyArena = NULL;
+    hashMapInstance->keyArenaSize = 0;
+    hashMapInstance->keyArenaCapacity = 0;
+    hashMapInstance->keyArenaRemovedSize = 0;
+#ifdef HASH_MAP_STATS
+    hashMapInstance->resizeCount = 0;
+#endif
+    HASH_GENERATION_RESET(hashMapInstance);
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+    hashMapInstance->oldEntries = NULL;
+    hashMapInstance->oldCapacity = 0;
+    hashMapInstance->migrateIndex = 0;
+#endif
     hashMapInstance->entries = calloc(hashMapInstance->capacity, sizeof(MapEntry));
     if (hashMapInstance->entries == NULL) {
         free(hashMapInstance);
@@ -21,29 +63,65 @@ HashMap getHashMapInstance(uint32_t capacity) {
     return hashMapInstance;
 }
 
+HashMap getKeyOwningHashMapInstance(uint32_t capacity) {
+    HashMap hashMapInstance = getHashMapInstance(capacity);
+    if (hashMapInstance != NULL) {
+        hashMapInstance->isKeyOwner = true;
+    }
+    return hashMapInstance;
+}
+
 bool hashMapPut(HashMap hashMap, const char *key, MapValueType value) {
-    if (hashMap != NULL && key != NULL) {
-        if ((hashMap->size + hashMap->deletedItemsCount + 1) > (hashMap->capacity * HASH_MAP_LOAD_FACTOR)) {
-            uint32_t newCapacity = (hashMap->capacity * 2);
-            bool isMapCapacityChanged = adjustHashMapCapacity(hashMap, newCapacity);
-            if (!isMapCapacityChanged) return false;
-        }
+    return key != NULL ? hashMapPutN(hashMap, key, strlen(key), value) : false;
+}
 
-        MapEntry *entry = findEntry(hashMap->entries, hashMap->capacity, key);
-        bool isNewKey = entry->key == NULL;
-        if (isNewKey) {
-            hashMap->size++;
-        }
+bool hashMapPutN(HashMap hashMap, const char *key, uint32_t length, MapValueType value) {
+    return key != NULL ? hashMapPutWithHash(hashMap, key, length, hashMapKeyHashCode(hashMap, key, length), value) : false;
+}
 
-        if (entry->isDeleted) {
-            hashMap->deletedItemsCount--;
-        }
+bool hashMapPutWithHash(HashMap hashMap, const char *key, uint32_t length, uint32_t hash, MapValueType value) {
+    MapEntry *entry = upsertEntry(hashMap, key, length, hash, value);
+    if (entry == NULL) return false;
+    if (!hashMap->isKeyOwner) {
         entry->key = (char *) key;
-        entry->value = value;
-        entry->isDeleted = false;
-        return true;
     }
-    return false;
+    entry->value = value;
+    return true;
+}
+
+MapValueType hashMapCompute(HashMap hashMap, const char *key, MapComputeFunction function, void *context) {
+    if (key == NULL) return (MapValueType) NULL;
+    uint32_t length = strlen(key);
+    return hashMapComputeWithHash(hashMap, key, length, hashMapKeyHashCode(hashMap, key, length), function, context);
+}
+
+MapValueType hashMapComputeWithHash(HashMap hashMap, const char *key, uint32_t length, uint32_t hash, MapComputeFunction function, void *context) {
+    if (hashMap == NULL || key == NULL || function == NULL) return (MapValueType) NULL;
+    MapEntry *freeEntry = NULL;
+    MapEntry *entry = probeEntry(hashMap, key, length, hash, &freeEntry);
+    MapValueType value = function(key, entry != NULL ? entry->value : (MapValueType) NULL, context);
+
+    if (entry != NULL) {
+        if (value == NULL) {
+            hashMapRemoveEntry(hashMap, entry);
+        } else {
+            entry->value = value;
+        }
+        return value;
+    }
+    if (value == NULL) return (MapValueType) NULL;  // Absent key stays absent, table and key arena are not touched
+    return commitEntry(hashMap, freeEntry, key, length, hash, value) != NULL ? value : (MapValueType) NULL;
+}
+
+MapValueType *hashMapGetOrInsert(HashMap hashMap, const char *key, MapValueType defaultValue) {
+    if (key == NULL) return NULL;
+    uint32_t length = strlen(key);
+    return hashMapGetOrInsertWithHash(hashMap, key, length, hashMapKeyHashCode(hashMap, key, length), defaultValue);
+}
+
+MapValueType *hashMapGetOrInsertWithHash(HashMap hashMap, const char *key, uint32_t length, uint32_t hash, MapValueType defaultValue) {
+    MapEntry *entry = upsertEntry(hashMap, key, length, hash, defaultValue);
+    return entry != NULL ? &entry->value : NULL;
 }
 
 MapValueType hashMapGet(HashMap hashMap, const char *key) {
@@ -51,23 +129,83 @@ MapValueType hashMapGet(HashMap hashMap, const char *key) {
     return entry != NULL ? entry->value : (MapValueType) NULL;
 }
 
+MapValueType hashMapGetN(HashMap hashMap, const char *key, uint32_t length) {
+    return key != NULL ? hashMapGetWithHash(hashMap, key, length, hashMapKeyHashCode(hashMap, key, length)) : (MapValueType) NULL;
+}
+
+MapValueType hashMapGetWithHash(HashMap hashMap, const char *key, uint32_t length, uint32_t hash) {
+    MapEntry *entry = hashMapGetEntryWithHash(hashMap, key, length, hash);
+    return entry != NULL ? entry->value : (MapValueType) NULL;
+}
+
 MapValueType hashMapGetOrDefault(HashMap hashMap, const char *key, MapValueType defaultValue) {
     MapValueType mapValue = hashMapGet(hashMap, key);
     return mapValue != (MapValueType) NULL ? mapValue : defaultValue;
 }
 
+void hashMapGetBatch(HashMap hashMap, const char *keys[], uint32_t count, MapValueType values[]) {
+    uint32_t lengths[HASH_MAP_BATCH_SIZE];
+    uint32_t hashes[HASH_MAP_BATCH_SIZE];
+
+    for (uint32_t offset = 0; offset < count; offset += HASH_MAP_BATCH_SIZE) {
+        uint32_t batchSize = count - offset < HASH_MAP_BATCH_SIZE ? count - offset : HASH_MAP_BATCH_SIZE;
+        if (isHashMapEmpty(hashMap)) {
+            memset(&values[offset], 0, batchSize * sizeof(MapValueType));
+            continue;
+        }
+
+        for (uint32_t i = 0; i < batchSize; i++) {  // Hash all keys first, so home slots are loaded in parallel instead of one cache miss after another
+            const char *key = keys[offset + i];
+            if (key == NULL) continue;
+            lengths[i] = strlen(key);
+            hashes[i] = hashMapKeyHashCode(hashMap, key, lengths[i]);
+            HASH_MAP_PREFETCH(&hashMap->entries[hashes[i] & (hashMap->capacity - 1)]);
+        }
+
+        for (uint32_t i = 0; i < batchSize; i++) {  // Home slots are in cache now, request key of the first candidate for compare
+            MapEntry *entry = &hashMap->entries[hashes[i] & (hashMap->capacity - 1)];
+            if (keys[offset + i] != NULL && entry->key != NULL && entry->hash == hashes[i]) {
+                HASH_MAP_PREFETCH(entry->key);
+            }
+        }
+
+        for (uint32_t i = 0; i < batchSize; i++) {
+            const char *key = keys[offset + i];
+            MapEntry *entry = key != NULL ? lookupEntry(hashMap, key, lengths[i], hashes[i]) : NULL;
+            values[offset + i] = entry != NULL ? entry->value : (MapValueType) NULL;
+        }
+    }
+}
+
 MapEntry *hashMapGetEntry(HashMap hashMap, const char *key) {
     if (isHashMapNotEmpty(hashMap) && key != NULL) {
-        MapEntry *entry = findEntry(hashMap->entries, hashMap->capacity, key);
-        return entry->key != NULL ? entry : NULL;
+        uint32_t length = strlen(key);
+        return lookupEntry(hashMap, key, length, hashMapKeyHashCode(hashMap, key, length));
+    }
+    return NULL;
+}
+
+MapEntry *hashMapGetEntryWithHash(HashMap hashMap, const char *key, uint32_t length, uint32_t hash) {
+    if (isHashMapNotEmpty(hashMap) && key != NULL) {
+        return lookupEntry(hashMap, key, length, hash);
     }
     return NULL;
 }
 
 MapValueType hashMapRemove(HashMap hashMap, const char *key) {
+    return key != NULL ? hashMapRemoveN(hashMap, key, strlen(key)) : (MapValueType) NULL;
+}
+
+MapValueType hashMapRemoveN(HashMap hashMap, const char *key, uint32_t length) {
+    return key != NULL ? hashMapRemoveWithHash(hashMap, key, length, hashMapKeyHashCode(hashMap, key, length)) : (MapValueType) NULL;
+}
+
+MapValueType hashMapRemoveWithHash(HashMap hashMap, const char *key, uint32_t length, uint32_t hash) {
     if (isHashMapNotEmpty(hashMap) && key != NULL) {
-        MapEntry *entry = findEntry(hashMap->entries, hashMap->capacity, key);
-        return hashMapRemoveEntry(hashMap, entry);
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+        migrateEntries(hashMap, HASH_MAP_REHASH_STEP);
+#endif
+        return hashMapRemoveEntry(hashMap, lookupEntry(hashMap, key, length, hash));
     }
     return (MapValueType) NULL;
 }
@@ -77,30 +215,110 @@ MapValueType hashMapRemoveEntry(HashMap hashMap, MapEntry *entry) {
         return (MapValueType) NULL;
     }
 
+    MapValueType value = entry->value;
+    if (hashMap->isKeyOwner) {
+        hashMap->keyArenaRemovedSize += entry->keyLength + 1;
+    }
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+    if (isOldTableEntry(hashMap, entry)) {  // Keep old table probe chains untouched until migration ends
+        vacateEntry(entry);
+        hashMap->size--;
+        return value;
+    }
+#endif
+#ifdef HASH_MAP_ROBIN_HOOD
+    uint32_t index = (uint32_t) (entry - hashMap->entries);
+    uint32_t nextIndex = (index + 1) & (hashMap->capacity - 1);
+    while (isLiveEntry(&hashMap->entries[nextIndex], HASH_GENERATION_OF(hashMap)) && hashMap->entries[nextIndex].probeLength > 0) {   // Shift following entries back until empty slot or entry at its home
+        hashMap->entries[index] = hashMap->entries[nextIndex];
+        hashMap->entries[index].probeLength--;
+        index = nextIndex;
+        nextIndex = (nextIndex + 1) & (hashMap->capacity - 1);
+    }
+    hashMap->entries[index].key = NULL;
+    hashMap->entries[index].probeLength = 0;
+    hashMap->size--;
+#else
     entry->key = NULL;
     entry->isDeleted = true; // Place a tombstone in the entry.
     hashMap->size--;
     hashMap->deletedItemsCount++;
-    return entry->value;
+#endif
+    return value;
 }
 
 void hashMapAddAll(HashMap from, HashMap to) {
+    if (from == NULL || to == NULL) return;
+    hashMapReserve(to, to->size + from->size);  // At most single rehash, shared keys only leave some slots unused
     for (uint32_t i = 0; i < from->capacity; i++) {
         MapEntry *entry = &from->entries[i];
+        if (isLiveEntry(entry, HASH_GENERATION_OF(from))) {
+            uint32_t hash = from->seed == to->seed ? entry->hash : hashMapKeyHashCode(to, entry->key, entry->keyLength);
+            hashMapPutWithHash(to, entry->key, entry->keyLength, hash, entry->value);
+        }
+    }
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+    for (uint32_t i = 0; i < from->oldCapacity; i++) {
+        MapEntry *entry = &from->oldEntries[i];
         if (entry->key != NULL) {
-            hashMapPut(to, entry->key, entry->value);
+            uint32_t hash = from->seed == to->seed ? entry->hash : hashMapKeyHashCode(to, entry->key, entry->keyLength);
+            hashMapPutWithHash(to, entry->key, entry->keyLength, hash, entry->value);
         }
     }
+#endif
+}
+
+bool hashMapReserve(HashMap hashMap, uint32_t size) {
+    if (hashMap == NULL) return false;
+    if ((size + hashMap->deletedItemsCount) <= (hashMap->capacity * HASH_MAP_LOAD_FACTOR)) return true;  // Already fits without resize
+    uint32_t capacity = capacityForSize(size);
+    if (!adjustHashMapCapacity(hashMap, capacity > hashMap->capacity ? capacity : hashMap->capacity)) return false;    // Same capacity only drops tombstones
+#ifdef HASH_MAP_STATS
+    hashMap->resizeCount++;
+#endif
+    return true;
+}
+
+bool hashMapShrinkToFit(HashMap hashMap) {
+    if (hashMap == NULL) return false;
+    uint32_t capacity = capacityForSize(hashMap->size);
+    if (capacity < hashMap->capacity || hashMap->deletedItemsCount > 0) {
+        if (!adjustHashMapCapacity(hashMap, capacity < hashMap->capacity ? capacity : hashMap->capacity)) return false;
+#ifdef HASH_MAP_STATS
+        hashMap->resizeCount++;
+#endif
+    }
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+    migrateEntries(hashMap, hashMap->oldCapacity);  // Bigger table is released now, not after the next puts
+#endif
+    char *previousArena = NULL;
+    if (hashMap->isKeyOwner && hashMap->keyArenaRemovedSize > 0 && reallocateKeyArena(hashMap, 0, true, &previousArena)) {
+        free(previousArena);
+    }
+    return true;
 }
 
 void hashMapClear(HashMap hashMap) {
     if (hashMap != NULL) {
-        for (uint32_t i = 0; i < hashMap->capacity; i++) {
-            hashMap->entries[i].key = NULL;
-            hashMap->entries[i].isDeleted = false;
+        if (!HASH_GENERATION_ADVANCE(hashMap)) {    // Without generations or on their wraparound every slot is reset
+            for (uint32_t i = 0; i < hashMap->capacity; i++) {
+                hashMap->entries[i].key = NULL;
+#ifndef HASH_MAP_ROBIN_HOOD
+                hashMap->entries[i].isDeleted = false;
+#endif
+                HASH_GENERATION_STAMP(&hashMap->entries[i], HASH_GENERATION_OF(hashMap));
+            }
         }
         hashMap->size = 0;
         hashMap->deletedItemsCount = 0;
+        hashMap->keyArenaSize = 0;  // All owned keys are released at once, memory is kept for reuse
+        hashMap->keyArenaRemovedSize = 0;
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+        free(hashMap->oldEntries);
+        hashMap->oldEntries = NULL;
+        hashMap->oldCapacity = 0;
+        hashMap->migrateIndex = 0;
+#endif
     }
 }
 
@@ -118,25 +336,46 @@ bool isHashMapNotEmpty(HashMap hashMap) {
 
 bool isHashMapContainsKey(HashMap hashMap, const char *key) {
     if (key == NULL) return false;
-    MapEntry *entry = findEntry(hashMap->entries, hashMap->capacity, key);
-    return entry->key != NULL;
+    uint32_t length = strlen(key);
+    return lookupEntry(hashMap, key, length, hashMapKeyHashCode(hashMap, key, length)) != NULL;
 }
 
 HashMapIterator getHashMapIterator(HashMap hashMap) {
-    HashMapIterator iterator = {.hashMap = hashMap, .index = 0};
+    HashMapIterator iterator = {.hashMap = hashMap, .index = 0, .startIndex = 0};
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+    if (hashMap != NULL) {  // Iteration is linear anyway, so finish migration and walk single table
+        migrateEntries(hashMap, hashMap->oldCapacity);
+    }
+#endif
+    if (hashMap != NULL) {  // Start from empty slot, so removal of current key never shifts not visited entry before iterator
+        while (iterator.startIndex < hashMap->capacity && isLiveEntry(&hashMap->entries[iterator.startIndex], HASH_GENERATION_OF(hashMap))) {
+            iterator.startIndex++;
+        }
+    }
     return iterator;
 }
 
 bool hashMapHasNext(HashMapIterator *iterator) {
     if (iterator != NULL && iterator->hashMap != NULL) {
         HashMap hashMap = iterator->hashMap;
+        if (iterator->index > 0) {
+            MapEntry *previous = &hashMap->entries[(iterator->startIndex + iterator->index - 1) & (hashMap->capacity - 1)];
+            if (isLiveEntry(previous, HASH_GENERATION_OF(hashMap)) && previous->key != iterator->key) {  // Current key was removed and next entry shifted in its place
+                iterator->key = previous->key;
+                iterator->keyLength = previous->keyLength;
+                iterator->value = previous->value;
+                return true;
+            }
+        }
+
         while (iterator->index < hashMap->capacity) {
-            uint32_t indexValue = iterator->index;
+            uint32_t indexValue = (iterator->startIndex + iterator->index) & (hashMap->capacity - 1);
             iterator->index++;
 
-            if (hashMap->entries[indexValue].key != NULL) { // Found next non-empty item, update iterator key and value.
+            if (isLiveEntry(&hashMap->entries[indexValue], HASH_GENERATION_OF(hashMap))) { // Found next non-empty item, update iterator key and value.
                 MapEntry pair = hashMap->entries[indexValue];
                 iterator->key = pair.key;
+                iterator->keyLength = pair.keyLength;
                 iterator->value = pair.value;
                 return true;
             }
@@ -148,24 +387,99 @@ bool hashMapHasNext(HashMapIterator *iterator) {
 
 void hashMapDelete(HashMap hashMap) {
     if (hashMap != NULL) {
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+        free(hashMap->oldEntries);
+#endif
+        free(hashMap->keyArena);
         free(hashMap->entries);
         free(hashMap);
     }
 }
 
+#ifdef HASH_MAP_STATS
+void hashMapGetStats(HashMap hashMap, HashTableStats *stats) {
+    if (hashMap == NULL || stats == NULL) return;
+    size_t allocatedBytes = sizeof(struct HashMap) + hashMap->capacity * sizeof(MapEntry) + hashMap->keyArenaCapacity;
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+    allocatedBytes += hashMap->oldCapacity * sizeof(MapEntry);
+#endif
+    hashStatsInit(stats, hashMap->size, hashMap->capacity, hashMap->deletedItemsCount, hashMap->resizeCount, allocatedBytes);
+    addProbeLengths(stats, hashMap->entries, hashMap->capacity, HASH_GENERATION_OF(hashMap));
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+    if (hashMap->oldEntries != NULL) {  // Not migrated keys are counted by their place in the old table
+        addProbeLengths(stats, hashMap->oldEntries, hashMap->oldCapacity, HASH_GENERATION_OF(hashMap));
+    }
+#endif
+    hashStatsComplete(stats);
+}
+#endif
+
 void initSingletonHashMap(HashMap *hashMap, uint32_t capacity) {
     if (*hashMap == NULL) {
         *hashMap = getHashMapInstance(capacity);
     }
 }
 
-static MapEntry *findEntry(MapEntry *entries, uint32_t capacity, const char *key) {
-    uint32_t hash = hashCode(key);
+#ifdef HASH_MAP_ROBIN_HOOD
+static MapEntry *findEntry(MapEntry *entries, uint32_t capacity, const char *key, uint32_t length, uint32_t hash, uint16_t generation) {
+    uint32_t index = hash & (capacity - 1);
+    uint32_t probeLength = 0;
+
+    while (true) {
+        MapEntry *entry = &entries[index];
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+        if (entry->key == NULL && entry->probeLength == HASH_MAP_VACATED_SLOT) {   // Migrated or removed from old table, chain continues
+            index = (index + 1) & (capacity - 1);
+            probeLength++;
+            continue;
+        }
+#endif
+        if (!isLiveEntry(entry, generation) || entry->probeLength < probeLength) {   // Key would have taken this slot on insert, so it is absent
+            return NULL;
+        }
+        if (entry->hash == hash && entry->keyLength == length && memcmp(key, entry->key, length) == 0) {
+            return entry;
+        }
+        index = (index + 1) & (capacity - 1);
+        probeLength++;
+    }
+}
+
+static MapEntry *findExistingEntry(MapEntry *entries, uint32_t capacity, const char *key, uint32_t length, uint32_t hash, uint16_t generation) {
+    return findEntry(entries, capacity, key, length, hash, generation);
+}
+
+static MapEntry *insertEntry(MapEntry *entries, uint32_t capacity, MapEntry entry, uint16_t generation) {    // Key must be absent in the table, returns slot of inserted key
+    uint32_t index = entry.hash & (capacity - 1);
+    entry.probeLength = 0;
+    HASH_GENERATION_STAMP(&entry, generation);
+    MapEntry *inserted = NULL;
+
+    while (isLiveEntry(&entries[index], generation)) {
+        if (entries[index].probeLength < entry.probeLength) {  // Entry closer to its home gives slot to the farther one and continues probing
+            MapEntry displaced = entries[index];
+            entries[index] = entry;
+            entry = displaced;
+            if (inserted == NULL) {
+                inserted = &entries[index];
+            }
+        }
+        index = (index + 1) & (capacity - 1);
+        entry.probeLength++;
+    }
+    entries[index] = entry;
+    return inserted != NULL ? inserted : &entries[index];
+}
+#else
+static MapEntry *findEntry(MapEntry *entries, uint32_t capacity, const char *key, uint32_t length, uint32_t hash, uint16_t generation) {
     uint32_t index = hash & (capacity - 1);
     MapEntry *tombstone = NULL;
 
     while (true) {
         MapEntry *entry = &entries[index];
+        if (HASH_GENERATION_IS_STALE(entry, generation)) {  // Written before the last clear, probe chain ends here as on empty slot
+            return tombstone != NULL ? tombstone : entry;
+        }
         if (entry->key == NULL) {
             if (!entry->isDeleted) { // Empty entry.
                 return tombstone != NULL ? tombstone : entry;
@@ -174,13 +488,186 @@ static MapEntry *findEntry(MapEntry *entries, uint32_t capacity, const char *key
                     tombstone = entry;   // We found a tombstone.
                 }
             }
-        } else if (strcmp(key, entry->key) == 0) {   // If bucket has the same key, we’re done
+        } else if (entry->hash == hash && entry->keyLength == length && memcmp(key, entry->key, length) == 0) {   // If bucket has the same key, we’re done
             return entry;   // We found the key.
         }
         index = (index + 1) & (capacity - 1); // If we go past the end of the array, that second modulo operator wraps us back around to the beginning.
     }
 }
 
+static MapEntry *findEmptyEntry(MapEntry *entries, uint32_t capacity, uint32_t hash, uint16_t generation) {   // Keys are unique, so no compare needed, first empty or deleted slot is taken
+    uint32_t index = hash & (capacity - 1);
+    while (isLiveEntry(&entries[index], generation)) {
+        index = (index + 1) & (capacity - 1);
+    }
+    return &entries[index];
+}
+
+static MapEntry *findExistingEntry(MapEntry *entries, uint32_t capacity, const char *key, uint32_t length, uint32_t hash, uint16_t generation) {
+    MapEntry *entry = findEntry(entries, capacity, key, length, hash, generation);
+    return isLiveEntry(entry, generation) ? entry : NULL;
+}
+#endif
+
+static bool isLiveEntry(const MapEntry *entry, uint16_t generation) {
+    return entry->key != NULL && !HASH_GENERATION_IS_STALE(entry, generation);
+}
+
+static void refreshEntry(MapEntry *entry, uint16_t generation) {  // Slot written before the last clear becomes empty before write
+    if (HASH_GENERATION_IS_STALE(entry, generation)) {
+        entry->key = NULL;
+#ifdef HASH_MAP_ROBIN_HOOD
+        entry->probeLength = 0;
+#else
+        entry->isDeleted = false;
+#endif
+        HASH_GENERATION_STAMP(entry, generation);
+    }
+}
+
+static void sweepStaleEntries(HashMap hashMap) {  // Called by writes that walk all slots anyway, lookups and iteration only skip stale slots
+    if (!HASH_GENERATION_HAS_STALE_SLOTS(hashMap)) return;
+    for (uint32_t i = 0; i < hashMap->capacity; i++) {
+        refreshEntry(&hashMap->entries[i], HASH_GENERATION_OF(hashMap));
+    }
+    HASH_GENERATION_SWEPT(hashMap);
+}
+
+static MapEntry *upsertEntry(HashMap hashMap, const char *key, uint32_t length, uint32_t hash, MapValueType value) {  // Finds key entry or inserts key with value in the same probe
+    if (hashMap == NULL || key == NULL) return NULL;
+    MapEntry *freeEntry = NULL;
+    MapEntry *entry = probeEntry(hashMap, key, length, hash, &freeEntry);
+    return entry != NULL ? entry : commitEntry(hashMap, freeEntry, key, length, hash, value);
+}
+
+static MapEntry *probeEntry(HashMap hashMap, const char *key, uint32_t length, uint32_t hash, MapEntry **freeEntry) {  // Returns live key entry, or NULL and slot where absent key can be inserted
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+    migrateEntries(hashMap, HASH_MAP_REHASH_STEP);
+    MapEntry *oldEntry = hashMap->oldEntries != NULL ? findExistingEntry(hashMap->oldEntries, hashMap->oldCapacity, key, length, hash, HASH_GENERATION_OF(hashMap)) : NULL;
+    if (oldEntry != NULL) return oldEntry;  // Not migrated yet, updated in place
+#endif
+    MapEntry *entry = findEntry(hashMap->entries, hashMap->capacity, key, length, hash, HASH_GENERATION_OF(hashMap));
+#ifdef HASH_MAP_ROBIN_HOOD
+    *freeEntry = NULL;  // Insert shifts entries, so slot is found by insertEntry()
+    return entry;
+#else
+    if (isLiveEntry(entry, HASH_GENERATION_OF(hashMap))) return entry;
+    *freeEntry = entry;
+    return NULL;
+#endif
+}
+
+static MapEntry *commitEntry(HashMap hashMap, MapEntry *freeEntry, const char *key, uint32_t length, uint32_t hash, MapValueType value) {  // Inserts absent key to the slot found by probeEntry()
+    if ((hashMap->size + hashMap->deletedItemsCount + 1) > (hashMap->capacity * HASH_MAP_LOAD_FACTOR)) {
+        uint32_t newCapacity = (hashMap->capacity * 2);
+        bool isMapCapacityChanged = adjustHashMapCapacity(hashMap, newCapacity);
+        if (!isMapCapacityChanged) return NULL;
+#ifdef HASH_MAP_STATS
+        hashMap->resizeCount++;
+#endif
+        freeEntry = NULL;   // Probed slot belongs to the previous table
+    }
+    char *storedKey = hashMap->isKeyOwner ? storeKey(hashMap, key, length) : (char *) key;
+    if (storedKey == NULL) return NULL;
+
+#ifdef HASH_MAP_ROBIN_HOOD
+    MapEntry *entry = insertEntry(hashMap->entries, hashMap->capacity, (MapEntry) {.key = storedKey, .value = value, .hash = hash, .keyLength = length}, HASH_GENERATION_OF(hashMap));
+#else
+    MapEntry *entry = freeEntry != NULL ? freeEntry : findEntry(hashMap->entries, hashMap->capacity, key, length, hash, HASH_GENERATION_OF(hashMap));
+    refreshEntry(entry, HASH_GENERATION_OF(hashMap));
+    if (entry->isDeleted) {
+        hashMap->deletedItemsCount--;
+    }
+    entry->key = storedKey;
+    entry->value = value;
+    entry->hash = hash;
+    entry->keyLength = length;
+    entry->isDeleted = false;
+#endif
+    hashMap->size++;
+    return entry;
+}
+
+static MapEntry *lookupEntry(HashMap hashMap, const char *key, uint32_t length, uint32_t hash) {
+    MapEntry *entry = findExistingEntry(hashMap->entries, hashMap->capacity, key, length, hash, HASH_GENERATION_OF(hashMap));
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+    if (entry == NULL && hashMap->oldEntries != NULL) {  // Key can be in the old table until migration ends
+        entry = findExistingEntry(hashMap->oldEntries, hashMap->oldCapacity, key, length, hash, HASH_GENERATION_OF(hashMap));
+    }
+#endif
+    return entry;
+}
+
+static char *storeKey(HashMap hashMap, const char *key, uint32_t length) {  // Copies key with NUL terminator to the map arena
+    char *previousArena = NULL;
+    if (hashMap->keyArenaSize + length + 1 > hashMap->keyArenaCapacity) {
+        if (!reallocateKeyArena(hashMap, length + 1, isKeyArenaFragmented(hashMap), &previousArena)) return NULL;
+    }
+
+    char *storedKey = &hashMap->keyArena[hashMap->keyArenaSize];
+    memcpy(storedKey, key, length);
+    storedKey[length] = '\0';
+    hashMap->keyArenaSize += length + 1;
+    free(previousArena);    // Released only after copy, new key can point to the bytes of removed key
+    return storedKey;
+}
+
+static bool isKeyArenaFragmented(HashMap hashMap) {
+    return hashMap->keyArenaRemovedSize > 0 && hashMap->keyArenaRemovedSize >= hashMap->keyArenaSize / 4;
+}
+
+static bool reallocateKeyArena(HashMap hashMap, uint32_t reserveSize, bool isCompacted, char **previousArena) {
+    sweepStaleEntries(hashMap);     // Keys of stale slots are neither moved nor rebased
+    uint32_t usedSize = isCompacted ? hashMap->keyArenaSize - hashMap->keyArenaRemovedSize : hashMap->keyArenaSize;
+    uint32_t arenaCapacity = (usedSize + reserveSize) * 2;
+    if (arenaCapacity < HASH_MAP_KEY_ARENA_MIN_SIZE) {
+        arenaCapacity = HASH_MAP_KEY_ARENA_MIN_SIZE;
+    }
+    char *arena = malloc(arenaCapacity);
+    if (arena == NULL) return false;
+
+    if (isCompacted) {  // Only live keys are copied, bytes of removed keys are dropped
+        usedSize = moveKeys(hashMap->entries, hashMap->capacity, arena, 0);
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+        usedSize = moveKeys(hashMap->oldEntries, hashMap->oldCapacity, arena, usedSize);
+#endif
+        hashMap->keyArenaRemovedSize = 0;
+    } else if (hashMap->keyArena != NULL) {   // Whole arena is copied, so keys added together stay together
+        memcpy(arena, hashMap->keyArena, usedSize);
+        rebaseKeys(hashMap->entries, hashMap->capacity, hashMap->keyArena, arena);
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+        rebaseKeys(hashMap->oldEntries, hashMap->oldCapacity, hashMap->keyArena, arena);
+#endif
+    }
+
+    *previousArena = hashMap->keyArena;
+    hashMap->keyArena = arena;
+    hashMap->keyArenaSize = usedSize;
+    hashMap->keyArenaCapacity = arenaCapacity;
+    return true;
+}
+
+static uint32_t moveKeys(MapEntry *entries, uint32_t capacity, char *arena, uint32_t arenaSize) {
+    for (uint32_t i = 0; i < capacity; i++) {
+        MapEntry *entry = &entries[i];
+        if (entry->key != NULL) {
+            memcpy(&arena[arenaSize], entry->key, entry->keyLength + 1);
+            entry->key = &arena[arenaSize];
+            arenaSize += entry->keyLength + 1;
+        }
+    }
+    return arenaSize;
+}
+
+static void rebaseKeys(MapEntry *entries, uint32_t capacity, const char *fromArena, char *toArena) {
+    for (uint32_t i = 0; i < capacity; i++) {
+        MapEntry *entry = &entries[i];
+        if (entry->key != NULL) {
+            entry->key = &toArena[entry->key - fromArena];
+        }
+    }
+}
+
 static uint32_t nextPowerOfTwo(uint32_t capacity) {
     capacity--;
     uint32_t i = 0;
@@ -190,28 +677,103 @@ static uint32_t nextPowerOfTwo(uint32_t capacity) {
     return 1 << i;
 }
 
-static uint32_t hashCode(const char *key) {  // Returns a hashCode code for the provided string.
-    uint32_t hash = 2166136261u;
-    uint32_t keyLength = strlen(key);
-    for (uint32_t i = 0; i < keyLength; i++) {
-        hash ^= (uint8_t) key[i];
-        hash *= 16777619;
+static uint32_t capacityForSize(uint32_t size) {    // Smallest table that takes `size` keys without resize
+    uint32_t capacity = nextPowerOfTwo(size > 0 ? size : 1);
+    while (size > (capacity * HASH_MAP_LOAD_FACTOR)) {
+        capacity *= 2;
     }
-    return hash;
+    return capacity;
 }
 
+uint32_t hashMapKeyHashCode(HashMap hashMap, const char *key, uint32_t length) {  // Returns a hashCode code for the provided string, algorithm is selected by `STR_HASH_ALGORITHM`
+#ifdef HASH_MAP_SEEDED_HASH
+    return strHashCodeSeeded(key, length, hashMap->seed);
+#else
+    return strHashCodeN(key, length);
+#endif
+}
+
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+static void migrateEntries(HashMap hashMap, uint32_t slotCount) {
+    if (hashMap->oldEntries == NULL) return;
+
+    for (; slotCount > 0 && hashMap->migrateIndex < hashMap->oldCapacity; slotCount--) {
+        MapEntry *entry = &hashMap->oldEntries[hashMap->migrateIndex++];
+        if (entry->key == NULL) continue;
+
+#ifdef HASH_MAP_ROBIN_HOOD
+        insertEntry(hashMap->entries, hashMap->capacity, *entry, HASH_GENERATION_OF(hashMap));
+#else
+        MapEntry *destination = findEmptyEntry(hashMap->entries, hashMap->capacity, entry->hash, HASH_GENERATION_OF(hashMap));
+        refreshEntry(destination, HASH_GENERATION_OF(hashMap));
+        if (destination->isDeleted) {
+            hashMap->deletedItemsCount--;
+        }
+        destination->key = entry->key;
+        destination->value = entry->value;
+        destination->hash = entry->hash;
+        destination->keyLength = entry->keyLength;
+        destination->isDeleted = false;
+#endif
+        vacateEntry(entry);
+    }
+
+    if (hashMap->migrateIndex == hashMap->oldCapacity) {
+        free(hashMap->oldEntries);
+        hashMap->oldEntries = NULL;
+        hashMap->oldCapacity = 0;
+        hashMap->migrateIndex = 0;
+    }
+}
+
+static void vacateEntry(MapEntry *entry) {  // Slot stays part of probe chain, but never matches any key
+    entry->key = NULL;
+#ifdef HASH_MAP_ROBIN_HOOD
+    entry->probeLength = HASH_MAP_VACATED_SLOT;
+#else
+    entry->isDeleted = true;
+#endif
+}
+
+static bool isOldTableEntry(HashMap hashMap, MapEntry *entry) {
+    return hashMap->oldEntries != NULL && entry >= hashMap->oldEntries && entry < hashMap->oldEntries + hashMap->oldCapacity;
+}
+
+static bool adjustHashMapCapacity(HashMap hashMap, uint32_t capacity) {  // Only allocates new table, entries are moved by next put/remove calls
+    migrateEntries(hashMap, hashMap->oldCapacity);  // Previous migration must be finished before the next one starts
+    sweepStaleEntries(hashMap);     // Old table is walked by migration without generation checks
+    MapEntry *newEntries = calloc(capacity, sizeof(struct MapEntry));
+    if (newEntries == NULL) return false;
+
+    hashMap->oldEntries = hashMap->entries;
+    hashMap->oldCapacity = hashMap->capacity;
+    hashMap->migrateIndex = 0;
+    hashMap->entries = newEntries;
+    hashMap->capacity = capacity;
+    hashMap->deletedItemsCount = 0;  // Tombstones stay in the old table
+    return true;
+}
+#else
 static bool adjustHashMapCapacity(HashMap hashMap, uint32_t capacity) {
     MapEntry *newEntries = calloc(capacity, sizeof(struct MapEntry));
     if (newEntries == NULL) return false;
+    sweepStaleEntries(hashMap);
 
     hashMap->size = 0;  // Don’t copy the tombstones over. Recalculate the count since it may change during a resize
     for (uint32_t i = 0; i < hashMap->capacity; i++) {
         MapEntry *entry = &hashMap->entries[i];
         if (entry->key == NULL) continue;
 
-        MapEntry *destination = findEntry(newEntries, capacity, entry->key);
+#ifdef HASH_MAP_ROBIN_HOOD
+        insertEntry(newEntries, capacity, *entry, HASH_GENERATION_OF(hashMap));
+#else
+        MapEntry *destination = findEmptyEntry(newEntries, capacity, entry->hash, HASH_GENERATION_OF(hashMap));
+        refreshEntry(destination, HASH_GENERATION_OF(hashMap));
         destination->key = entry->key;
         destination->value = entry->value;
+        destination->hash = entry->hash;
+        destination->keyLength = entry->keyLength;
+#endif
         hashMap->size++;
     }
 
@@ -219,5 +781,21 @@ static bool adjustHashMapCapacity(HashMap hashMap, uint32_t capacity) {
     hashMap->entries = newEntries;
     hashMap->capacity = capacity;
     hashMap->deletedItemsCount = 0;
+
+    char *previousArena = NULL;
+    if (hashMap->isKeyOwner && isKeyArenaFragmented(hashMap) && reallocateKeyArena(hashMap, 0, true, &previousArena)) {   // Table is rebuilt anyway, drop bytes of removed keys
+        free(previousArena);
+    }
     return true;
 }
+#endif
+
+#ifdef HASH_MAP_STATS
+static void addProbeLengths(HashTableStats *stats, MapEntry *entries, uint32_t capacity, uint16_t generation) {
+    for (uint32_t i = 0; i < capacity; i++) {
+        if (isLiveEntry(&entries[i], generation)) {
+            hashStatsAddProbeLength(stats, (i - entries[i].hash) & (capacity - 1));
+        }
+    }
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "ReadMostlyHashMap.h"
+
+static HashMap copySnapshot(HashMap snapshot, uint32_t extraSize);
+static uint32_t countNewKeys(HashMap snapshot, HashMap from);
+static bool publishSnapshot(ReadMostlyHashMap map, HashMap snapshot);
+static void reclaimSnapshots(ReadMostlyHashMap map);
+static void deleteRetiredSnapshots(RetiredHashMap *retired);
+
+
+ReadMostlyHashMap getReadMostlyHashMapInstance(uint32_t capacity, uint32_t maxReaders) {
+    ReadMostlyHashMap map = malloc(sizeof(struct ReadMostlyHashMap));
+    if (map == NULL) return NULL;
+    map->readerCount = maxReaders > 0 ? maxReaders : READ_MOSTLY_HASH_MAP_MAX_READERS;
+    map->readers = calloc(map->readerCount, sizeof(ReadMostlyReader));
+    map->snapshot = getKeyOwningHashMapInstance(capacity);  // Keys are copied to each snapshot arena, caller buffers are never referenced
+    if (map->readers == NULL || map->snapshot == NULL || pthread_mutex_init(&map->writeLock, NULL) != 0) {
+        hashMapDelete(map->snapshot);
+        free(map->readers);
+        free(map);
+        return NULL;
+    }
+    map->epoch = READ_MOSTLY_READER_IDLE + 1;
+    map->size = 0;
+    map->retired = NULL;
+    return map;
+}
+
+ReadMostlyReader *readMostlyHashMapRegisterReader(ReadMostlyHashMap map) {
+    if (map == NULL) return NULL;
+    for (uint32_t i = 0; i < map->readerCount; i++) {
+        uint32_t isRegistered = false;
+        if (__atomic_compare_exchange_n(&map->readers[i].isRegistered, &isRegistered, true, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            return &map->readers[i];
+        }
+    }
+    return NULL;
+}
+
+void readMostlyHashMapUnregisterReader(ReadMostlyReader *reader) {
+    if (reader != NULL) {
+        __atomic_store_n(&reader->epoch, READ_MOSTLY_READER_IDLE, __ATOMIC_RELEASE);
+        __atomic_store_n(&reader->isRegistered, false, __ATOMIC_RELEASE);
+    }
+}
+
+MapValueType readMostlyHashMapGet(ReadMostlyHashMap map, ReadMostlyReader *reader, const char *key) {
+    return key != NULL ? readMostlyHashMapGetN(map, reader, key, strlen(key)) : (MapValueType) NULL;
+}
+
+MapValueType readMostlyHashMapGetN(ReadMostlyHashMap map, ReadMostlyReader *reader, const char *key, uint32_t length) {
+    if (map == NULL || reader == NULL || key == NULL) return (MapValueType) NULL;
+    HashMap snapshot = readMostlyHashMapReadBegin(map, reader);
+    MapValueType value = hashMapGetN(snapshot, key, length);
+    readMostlyHashMapReadEnd(reader);
+    return value;
+}
+
+HashMap readMostlyHashMapReadBegin(ReadMostlyHashMap map, ReadMostlyReader *reader) {   // No locks and no retries, reader only announces epoch it started in
+    uint64_t epoch = __atomic_load_n(&map->epoch, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&reader->epoch, epoch, __ATOMIC_SEQ_CST);  // Announced before snapshot load, so writer that retires this snapshot sees it
+    return __atomic_load_n(&map->snapshot, __ATOMIC_SEQ_CST);
+}
+
+void readMostlyHashMapReadEnd(ReadMostlyReader *reader) {
+    __atomic_store_n(&reader->epoch, READ_MOSTLY_READER_IDLE, __ATOMIC_RELEASE);
+}
+
+bool readMostlyHashMapPut(ReadMostlyHashMap map, const char *key, MapValueType value) {
+    if (map == NULL || key == NULL) return false;
+    pthread_mutex_lock(&map->writeLock);
+    HashMap snapshot = copySnapshot(map->snapshot, 1);
+    bool isPut = snapshot != NULL && hashMapPut(snapshot, key, value) && publishSnapshot(map, snapshot);
+    if (!isPut) {
+        hashMapDelete(snapshot);
+    }
+    pthread_mutex_unlock(&map->writeLock);
+    return isPut;
+}
+
+bool readMostlyHashMapPutAll(ReadMostlyHashMap map, HashMap from) {
+    if (map == NULL || from == NULL) return false;
+    pthread_mutex_lock(&map->writeLock);
+    HashMap snapshot = copySnapshot(map->snapshot, getHashMapSize(from));
+    bool isPut = false;
+    if (snapshot != NULL) {
+        uint32_t expectedSize = snapshot->size + countNewKeys(snapshot, from);
+        hashMapAddAll(from, snapshot);
+        isPut = snapshot->size == expectedSize && publishSnapshot(map, snapshot);  // Partly filled copy is never published
+        if (!isPut) {
+            hashMapDelete(snapshot);
+        }
+    }
+    pthread_mutex_unlock(&map->writeLock);
+    return isPut;
+}
+
+MapValueType readMostlyHashMapRemove(ReadMostlyHashMap map, const char *key) {
+    if (map == NULL || key == NULL) return (MapValueType) NULL;
+    pthread_mutex_lock(&map->writeLock);
+    MapValueType value = (MapValueType) NULL;
+    if (hashMapGetEntry(map->snapshot, key) != NULL) {  // Absent key costs no copy
+        HashMap snapshot = copySnapshot(map->snapshot, 0);
+        if (snapshot != NULL) {
+            value = hashMapRemove(snapshot, key);
+            if (!publishSnapshot(map, snapshot)) {
+                hashMapDelete(snapshot);
+                value = (MapValueType) NULL;
+            }
+        }
+    }
+    pthread_mutex_unlock(&map->writeLock);
+    return value;
+}
+
+bool readMostlyHashMapClear(ReadMostlyHashMap map) {
+    if (map == NULL) return false;
+    pthread_mutex_lock(&map->writeLock);
+    HashMap snapshot = getKeyOwningHashMapInstance(map->snapshot->capacity);
+    bool isCleared = snapshot != NULL && publishSnapshot(map, snapshot);
+    if (!isCleared) {
+        hashMapDelete(snapshot);
+    }
+    pthread_mutex_unlock(&map->writeLock);
+    return isCleared;
+}
+
+uint32_t getReadMostlyHashMapSize(ReadMostlyHashMap map) {
+    return map != NULL ? __atomic_load_n(&map->size, __ATOMIC_RELAXED) : 0;
+}
+
+void readMostlyHashMapDelete(ReadMostlyHashMap map) {   // No reader may be inside read section
+    if (map != NULL) {
+        deleteRetiredSnapshots(map->retired);
+        hashMapDelete(map->snapshot);
+        pthread_mutex_destroy(&map->writeLock);
+        free(map->readers);
+        free(map);
+    }
+}
+
+static HashMap copySnapshot(HashMap snapshot, uint32_t extraSize) {
+    uint32_t capacity = snapshot->capacity;
+    while ((snapshot->size + extraSize + 1) > capacity * HASH_MAP_LOAD_FACTOR) {    // Presized, so copy never resizes and published table has no pending migration
+        capacity *= 2;
+    }
+    HashMap copy = getKeyOwningHashMapInstance(capacity);
+    if (copy == NULL) return NULL;
+    hashMapAddAll(snapshot, copy);  // Removed keys leave no tombstones in the copy
+    if (copy->size != snapshot->size) { // Out of memory for key copies
+        hashMapDelete(copy);
+        return NULL;
+    }
+    return copy;
+}
+
+static uint32_t countNewKeys(HashMap snapshot, HashMap from) {
+    uint32_t count = 0;
+    HashMapIterator iterator = getHashMapIterator(from);
+    while (hashMapHasNext(&iterator)) {
+        uint32_t hash = hashMapKeyHashCode(snapshot, iterator.key, iterator.keyLength);
+        count += hashMapGetEntryWithHash(snapshot, iterator.key, iterator.keyLength, hash) == NULL;
+    }
+    return count;
+}
+
+static bool publishSnapshot(ReadMostlyHashMap map, HashMap snapshot) {
+    RetiredHashMap *retired = malloc(sizeof(RetiredHashMap));
+    if (retired == NULL) return false;
+    retired->hashMap = map->snapshot;
+    __atomic_store_n(&map->snapshot, snapshot, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&map->size, snapshot->size, __ATOMIC_RELAXED);
+    retired->epoch = __atomic_fetch_add(&map->epoch, 1, __ATOMIC_SEQ_CST);  // Readers that started after this epoch see the new snapshot
+    retired->next = map->retired;
+    map->retired = retired;
+    reclaimSnapshots(map);
+    return true;
+}
+
+static void reclaimSnapshots(ReadMostlyHashMap map) {  // Called by writers only, snapshot still used by slow reader waits for the next write
+    uint64_t oldestEpoch = UINT64_MAX;
+    for (uint32_t i = 0; i < map->readerCount; i++) {
+        uint64_t epoch = __atomic_load_n(&map->readers[i].epoch, __ATOMIC_SEQ_CST);
+        if (epoch != READ_MOSTLY_READER_IDLE && epoch < oldestEpoch) {
+            oldestEpoch = epoch;
+        }
+    }
+
+    RetiredHashMap **link = &map->retired;
+    while (*link != NULL) {
+        RetiredHashMap *retired = *link;
+        if (retired->epoch < oldestEpoch) {
+            *link = retired->next;
+            hashMapDelete(retired->hashMap);
+            free(retired);
+        } else {
+            link = &retired->next;
+        }
+    }
+}
+
+static void deleteRetiredSnapshots(RetiredHashMap *retired) {
+    while (retired != NULL) {
+        RetiredHashMap *next = retired->next;
+        hashMapDelete(retired->hashMap);
+        free(retired);
+        retired = next;
+    }
+}
@@ -30,6 +30,10 @@ static char *generateRandomString(size_t size) {
     return string;
 }
 
+static inline uint32_t clusteredHashCode(uint32_t value) {  // a few home slots for all keys, builds long clusters in layout tests
+    return value % 4;
+}
+
 typedef struct User {   // Some test custom type
     char *name;
     int age;
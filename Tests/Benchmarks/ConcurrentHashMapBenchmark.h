@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stdio.h>
+#include "BaseTestTemplate.h"
+#include "ConcurrentHashMap.h"
+
+#define CONCURRENT_BENCH_THREAD_COUNT 4
+#define CONCURRENT_BENCH_KEY_COUNT 4096
+#define CONCURRENT_BENCH_THREAD_OPERATIONS 500000
+
+typedef struct ConcurrentBenchWorker {
+    ConcurrentHashMap map;
+    HashMap lockedMap;  // baseline map behind single mutex
+    pthread_mutex_t *mutex;
+    uint32_t id;
+    uint32_t foundCount;
+} ConcurrentBenchWorker;
+
+static char concurrentBenchKeys[CONCURRENT_BENCH_KEY_COUNT][16];
+
+
+static void fillConcurrentBenchKeys() {
+    for (uint32_t i = 0; i < CONCURRENT_BENCH_KEY_COUNT; i++) {
+        sprintf(concurrentBenchKeys[i], "session:%u", i);
+    }
+}
+
+static void *runConcurrentBenchWorker(void *data) {  // 90% lookups, 10% updates of existing keys
+    ConcurrentBenchWorker *worker = data;
+    uint32_t random = worker->id * 2654435761U + 1;
+    for (uint32_t i = 0; i < CONCURRENT_BENCH_THREAD_OPERATIONS; i++) {
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        const char *key = concurrentBenchKeys[random % CONCURRENT_BENCH_KEY_COUNT];
+        bool isUpdate = (random >> 24) % 10 == 0;
+        if (worker->map != NULL) {
+            if (isUpdate) {
+                concurrentHashMapPut(worker->map, key, (MapValueType) (uintptr_t) i);
+            } else {
+                worker->foundCount += concurrentHashMapGet(worker->map, key) != NULL;
+            }
+        } else {
+            pthread_mutex_lock(worker->mutex);
+            if (isUpdate) {
+                hashMapPut(worker->lockedMap, key, (MapValueType) (uintptr_t) i);
+            } else {
+                worker->foundCount += hashMapGet(worker->lockedMap, key) != NULL;
+            }
+            pthread_mutex_unlock(worker->mutex);
+        }
+    }
+    return NULL;
+}
+
+static uint32_t runConcurrentBenchWorkers(ConcurrentBenchWorker *workers) {
+    pthread_t threads[CONCURRENT_BENCH_THREAD_COUNT];
+    for (uint32_t i = 0; i < CONCURRENT_BENCH_THREAD_COUNT; i++) {
+        assert_int(pthread_create(&threads[i], NULL, runConcurrentBenchWorker, &workers[i]), ==, 0);
+    }
+    uint32_t foundCount = 0;
+    for (uint32_t i = 0; i < CONCURRENT_BENCH_THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+        foundCount += workers[i].foundCount;
+    }
+    return foundCount;
+}
+
+static MunitResult benchGlobalMutexMap(const MunitParameter params[], void *data) {
+    fillConcurrentBenchKeys();
+    HashMap lockedMap = getHashMapInstance(CONCURRENT_BENCH_KEY_COUNT * 2);
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    for (uint32_t i = 0; i < CONCURRENT_BENCH_KEY_COUNT; i++) {
+        hashMapPut(lockedMap, concurrentBenchKeys[i], (MapValueType) (uintptr_t) (i + 1));
+    }
+
+    ConcurrentBenchWorker workers[CONCURRENT_BENCH_THREAD_COUNT];
+    for (uint32_t i = 0; i < CONCURRENT_BENCH_THREAD_COUNT; i++) {
+        workers[i] = (ConcurrentBenchWorker) {.lockedMap = lockedMap, .mutex = &mutex, .id = i};
+    }
+    runConcurrentBenchWorkers(workers);
+    hashMapDelete(lockedMap);
+    return MUNIT_OK;
+}
+
+static MunitResult benchConcurrentMap(const MunitParameter params[], void *data) {
+    fillConcurrentBenchKeys();
+    ConcurrentHashMap map = getConcurrentHashMapInstance(CONCURRENT_BENCH_KEY_COUNT * 2, 0);
+    for (uint32_t i = 0; i < CONCURRENT_BENCH_KEY_COUNT; i++) {
+        concurrentHashMapPut(map, concurrentBenchKeys[i], (MapValueType) (uintptr_t) (i + 1));
+    }
+
+    ConcurrentBenchWorker workers[CONCURRENT_BENCH_THREAD_COUNT];
+    for (uint32_t i = 0; i < CONCURRENT_BENCH_THREAD_COUNT; i++) {
+        workers[i] = (ConcurrentBenchWorker) {.map = map, .id = i};
+    }
+    runConcurrentBenchWorkers(workers);
+    concurrentHashMapDelete(map);
+    return MUNIT_OK;
+}
+
+
+static MunitTest concurrentHashMapBenchmarks[] = {
+        {.name =  "Global mutex HashMap - read mostly traffic from 4 threads", .test = benchGlobalMutexMap},
+        {.name =  "ConcurrentHashMap - same traffic over sharded locks", .test = benchConcurrentMap},
+        END_OF_TESTS
+};
+
+static const MunitSuite concurrentHashMapBenchmarkSuite = {
+        .prefix = "ConcurrentHashMap benchmark: ",
+        .tests = concurrentHashMapBenchmarks,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
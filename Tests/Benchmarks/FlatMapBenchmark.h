@@ -0,0 +1,53 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "BufferFlatMap.h"
+#include "BufferHashMap.h"
+
+#define FLAT_BENCH_KEYS 32
+#define FLAT_BENCH_LOOKUPS 20000000
+
+CREATE_FLAT_MAP_TYPE(uint32_t, uint32_t, flatBench, flatBench);
+CREATE_HASH_MAP_TYPE(uint32_t, uint32_t, hashBench, hashBench);
+
+
+static MunitResult benchFlatMapLookup(const MunitParameter params[], void *data) {
+    flatBench_flatBenchMap *map = NEW_FLAT_MAP(uint32_t, uint32_t, flatBench, flatBench, FLAT_BENCH_KEYS);
+    for (uint32_t i = 0; i < FLAT_BENCH_KEYS; i++) {
+        flatBench_flatBenchMapAdd(map, i * 2654435761U, i + 1);
+    }
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < FLAT_BENCH_LOOKUPS; i++) {   // every other lookup misses
+        found += flatBench_flatBenchMapGet(map, (i % (FLAT_BENCH_KEYS * 2)) * 2654435761U) != 0;
+    }
+    assert_uint32(found, ==, FLAT_BENCH_LOOKUPS / 2);   // keeps lookups from being optimized out
+    return MUNIT_OK;
+}
+
+static MunitResult benchHashMapLookup(const MunitParameter params[], void *data) {
+    hashBench_hashBenchMap *map = NEW_HASH_MAP(uint32_t, uint32_t, hashBench, hashBench, FLAT_BENCH_KEYS);
+    for (uint32_t i = 0; i < FLAT_BENCH_KEYS; i++) {
+        hashBench_hashBenchMapAdd(map, i * 2654435761U, i + 1);
+    }
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < FLAT_BENCH_LOOKUPS; i++) {
+        found += hashBench_hashBenchMapGet(map, (i % (FLAT_BENCH_KEYS * 2)) * 2654435761U) != 0;
+    }
+    assert_uint32(found, ==, FLAT_BENCH_LOOKUPS / 2);
+    return MUNIT_OK;
+}
+
+
+static MunitTest flatMapBenchmarks[] = {
+        {.name =  "Flat map lookup - binary search in 32 sorted keys", .test = benchFlatMapLookup},
+        {.name =  "Hash map lookup - same keys and lookups in BufferHashMap", .test = benchHashMapLookup},
+        END_OF_TESTS
+};
+
+static const MunitSuite flatMapBenchmarkSuite = {
+        .prefix = "BufferFlatMap benchmark: ",
+        .tests = flatMapBenchmarks,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <stdio.h>
+#include "BaseTestTemplate.h"
+#include "ReadMostlyHashMap.h"
+
+#define READ_MOSTLY_BENCH_THREAD_COUNT 4
+#define READ_MOSTLY_BENCH_KEY_COUNT 1024
+#define READ_MOSTLY_BENCH_THREAD_LOOKUPS 1000000
+#define READ_MOSTLY_BENCH_WRITE_PERIOD 100000   // lookups of the first thread between updates
+
+typedef struct ReadMostlyBenchWorker {
+    ReadMostlyHashMap map;
+    HashMap lockedMap;  // baseline map behind reader-writer lock
+    pthread_rwlock_t *lock;
+    uint32_t id;
+    uint32_t foundCount;
+} ReadMostlyBenchWorker;
+
+static char readMostlyBenchKeys[READ_MOSTLY_BENCH_KEY_COUNT][16];
+
+
+static void fillReadMostlyBenchKeys() {
+    for (uint32_t i = 0; i < READ_MOSTLY_BENCH_KEY_COUNT; i++) {
+        sprintf(readMostlyBenchKeys[i], "route:%u", i);
+    }
+}
+
+static void *runReadMostlyBenchLookups(void *data) {
+    ReadMostlyBenchWorker *worker = data;
+    ReadMostlyReader *reader = worker->map != NULL ? readMostlyHashMapRegisterReader(worker->map) : NULL;
+    uint32_t random = worker->id * 2654435761U + 1;
+    for (uint32_t i = 0; i < READ_MOSTLY_BENCH_THREAD_LOOKUPS; i++) {
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        const char *key = readMostlyBenchKeys[random % READ_MOSTLY_BENCH_KEY_COUNT];
+        bool isUpdate = worker->id == 0 && i % READ_MOSTLY_BENCH_WRITE_PERIOD == 0;
+        if (worker->map != NULL) {
+            if (isUpdate) {
+                readMostlyHashMapPut(worker->map, key, (MapValueType) (uintptr_t) (i + 1));
+            }
+            worker->foundCount += readMostlyHashMapGet(worker->map, reader, key) != NULL;
+        } else {
+            if (isUpdate) {
+                pthread_rwlock_wrlock(worker->lock);
+                hashMapPut(worker->lockedMap, key, (MapValueType) (uintptr_t) (i + 1));
+                pthread_rwlock_unlock(worker->lock);
+            }
+            pthread_rwlock_rdlock(worker->lock);
+            worker->foundCount += hashMapGet(worker->lockedMap, key) != NULL;
+            pthread_rwlock_unlock(worker->lock);
+        }
+    }
+    readMostlyHashMapUnregisterReader(reader);
+    return NULL;
+}
+
+static uint32_t runReadMostlyBenchWorkers(ReadMostlyBenchWorker *workers) {
+    pthread_t threads[READ_MOSTLY_BENCH_THREAD_COUNT];
+    for (uint32_t i = 0; i < READ_MOSTLY_BENCH_THREAD_COUNT; i++) {
+        assert_int(pthread_create(&threads[i], NULL, runReadMostlyBenchLookups, &workers[i]), ==, 0);
+    }
+    uint32_t foundCount = 0;
+    for (uint32_t i = 0; i < READ_MOSTLY_BENCH_THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+        foundCount += workers[i].foundCount;
+    }
+    return foundCount;
+}
+
+static MunitResult benchReadWriteLockMap(const MunitParameter params[], void *data) {
+    fillReadMostlyBenchKeys();
+    HashMap lockedMap = getHashMapInstance(READ_MOSTLY_BENCH_KEY_COUNT * 2);
+    pthread_rwlock_t lock = PTHREAD_RWLOCK_INITIALIZER;
+    for (uint32_t i = 0; i < READ_MOSTLY_BENCH_KEY_COUNT; i++) {
+        hashMapPut(lockedMap, readMostlyBenchKeys[i], (MapValueType) (uintptr_t) (i + 1));
+    }
+
+    ReadMostlyBenchWorker workers[READ_MOSTLY_BENCH_THREAD_COUNT];
+    for (uint32_t i = 0; i < READ_MOSTLY_BENCH_THREAD_COUNT; i++) {
+        workers[i] = (ReadMostlyBenchWorker) {.lockedMap = lockedMap, .lock = &lock, .id = i};
+    }
+    runReadMostlyBenchWorkers(workers);
+    hashMapDelete(lockedMap);
+    return MUNIT_OK;
+}
+
+static MunitResult benchReadMostlyMap(const MunitParameter params[], void *data) {
+    fillReadMostlyBenchKeys();
+    ReadMostlyHashMap map = getReadMostlyHashMapInstance(READ_MOSTLY_BENCH_KEY_COUNT * 2, 0);
+    HashMap routes = getHashMapInstance(READ_MOSTLY_BENCH_KEY_COUNT * 2);
+    for (uint32_t i = 0; i < READ_MOSTLY_BENCH_KEY_COUNT; i++) {
+        hashMapPut(routes, readMostlyBenchKeys[i], (MapValueType) (uintptr_t) (i + 1));
+    }
+    readMostlyHashMapPutAll(map, routes);
+    hashMapDelete(routes);
+
+    ReadMostlyBenchWorker workers[READ_MOSTLY_BENCH_THREAD_COUNT];
+    for (uint32_t i = 0; i < READ_MOSTLY_BENCH_THREAD_COUNT; i++) {
+        workers[i] = (ReadMostlyBenchWorker) {.map = map, .id = i};
+    }
+    runReadMostlyBenchWorkers(workers);
+    readMostlyHashMapDelete(map);
+    return MUNIT_OK;
+}
+
+
+static MunitTest readMostlyHashMapBenchmarks[] = {
+        {.name =  "Reader-writer lock HashMap - read mostly lookups from 4 threads", .test = benchReadWriteLockMap},
+        {.name =  "ReadMostlyHashMap - same lookups without reader locks", .test = benchReadMostlyMap},
+        END_OF_TESTS
+};
+
+static const MunitSuite readMostlyHashMapBenchmarkSuite = {
+        .prefix = "ReadMostlyHashMap benchmark: ",
+        .tests = readMostlyHashMapBenchmarks,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,22 @@
+#include "Benchmarks/FlatMapBenchmark.h"
+#ifdef CONCURRENT_HASH_MAP
+#include "Benchmarks/ConcurrentHashMapBenchmark.h"
+#include "Benchmarks/ReadMostlyHashMapBenchmark.h"
+#endif
+
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {   // Throughput comparisons only, behavior is checked by Tests
+    MunitSuite benchmarkSuiteArray[] = {
+            flatMapBenchmarkSuite,
+#ifdef CONCURRENT_HASH_MAP
+            concurrentHashMapBenchmarkSuite,
+            readMostlyHashMapBenchmarkSuite,
+#endif
+    };
+
+    for (int i = 0; i < ARRAY_SIZE(benchmarkSuiteArray); i++) {
+        int result = munit_suite_main(&benchmarkSuiteArray[i], (void *) "µnit", argc, argv);
+        if (result != EXIT_SUCCESS) return result;
+    }
+    return EXIT_SUCCESS;
+}
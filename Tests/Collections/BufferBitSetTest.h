@@ -0,0 +1,182 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "BufferBitSet.h"
+
+#define BIT_SET_LOAD_CAPACITY 65536
+#define BIT_SET_LOAD_ROUNDS 2000
+
+
+CREATE_BIT_SET_TYPE(uint8_t);
+CREATE_BIT_SET_TYPE(uint16_t, flag);
+
+static uint64_t bitSetLoadWordsA[BIT_SET_WORD_COUNT(BIT_SET_LOAD_CAPACITY)];
+static uint64_t bitSetLoadWordsB[BIT_SET_WORD_COUNT(BIT_SET_LOAD_CAPACITY)];
+static uint64_t bitSetLoadWordsC[BIT_SET_WORD_COUNT(BIT_SET_LOAD_CAPACITY)];
+
+
+static MunitResult testBitSetCreation(const MunitParameter params[], void *data) {
+    uint8_tBitSet *set = NEW_BIT_SET(uint8_t, 256);
+    assert_not_null(set);
+    assert_uint32(set->wordCount, ==, 4);
+    assert_uint32(uint8_tBitSetSize(set), ==, 0);
+    assert_true(isuint8_tBitSetEmpty(set));
+    assert_uint32(uint8_tBitSetFirst(set), ==, BIT_SET_NOT_FOUND);
+    assert_uint32(NEW_BIT_SET(flag, 65)->wordCount, ==, 2);
+    assert_uint32(NEW_BIT_SET_1024(flag)->wordCount, ==, 16);
+    assert_null(newuint8_tBitSet(&(uint8_tBitSet) {0}, NULL, 8));
+    assert_false(uint8_tBitSetAdd(NULL, 1));
+    assert_false(uint8_tBitSetContains(NULL, 1));
+    assert_uint32(uint8_tBitSetSize(NULL), ==, 0);
+
+    flagBitSet *ofSet = NEW_BIT_SET_OF(flag, 100, 1, 64, 99, 100);
+    assert_uint32(flagBitSetSize(ofSet), ==, 3);    // 100 is out of capacity
+    return MUNIT_OK;
+}
+
+static MunitResult testBitSetAddRemove(const MunitParameter params[], void *data) {
+    flagBitSet *set = NEW_BIT_SET(flag, 130);
+    assert_true(flagBitSetAdd(set, 0));
+    assert_true(flagBitSetAdd(set, 63));
+    assert_true(flagBitSetAdd(set, 64));
+    assert_true(flagBitSetAdd(set, 129));
+    assert_false(flagBitSetAdd(set, 64));   // already present
+    assert_false(flagBitSetAdd(set, 130));  // out of capacity
+    assert_uint32(flagBitSetSize(set), ==, 4);
+    assert_true(flagBitSetContains(set, 63));
+    assert_false(flagBitSetContains(set, 62));
+    assert_false(flagBitSetContains(set, 1000));
+
+    assert_true(flagBitSetRemove(set, 63));
+    assert_false(flagBitSetRemove(set, 63));
+    assert_false(flagBitSetRemove(set, 1000));
+    assert_false(flagBitSetContains(set, 63));
+    assert_uint32(flagBitSetSize(set), ==, 3);
+    assert_true(isflagBitSetNotEmpty(set));
+
+    flagBitSetClear(set);
+    assert_true(isflagBitSetEmpty(set));
+    return MUNIT_OK;
+}
+
+static MunitResult testBitSetAlgebra(const MunitParameter params[], void *data) {
+    uint8_tBitSet *first = NEW_BIT_SET_OF(uint8_t, 256, 1, 2, 3, 100, 200, 255);
+    uint8_tBitSet *second = NEW_BIT_SET_OF(uint8_t, 256, 3, 4, 200);
+    uint8_tBitSet *result = NEW_BIT_SET_256(uint8_t);
+
+    uint8_tBitSetUnion(result, first);
+    uint8_tBitSetUnion(result, second);
+    assert_uint32(uint8_tBitSetSize(result), ==, 7);
+    assert_true(uint8_tBitSetContainsAll(result, first));
+    assert_true(uint8_tBitSetContainsAll(result, second));
+    assert_false(uint8_tBitSetContainsAll(second, result));
+
+    uint8_tBitSetIntersect(result, second);
+    assert_uint32(uint8_tBitSetSize(result), ==, 3);
+    assert_true(uint8_tBitSetContainsAll(second, result));
+
+    uint8_tBitSetUnion(result, first);
+    uint8_tBitSetSubtract(result, second);
+    assert_uint32(uint8_tBitSetSize(result), ==, 4);
+    assert_true(uint8_tBitSetContains(result, 1));
+    assert_true(uint8_tBitSetContains(result, 255));
+    assert_false(uint8_tBitSetContains(result, 3));
+    assert_false(uint8_tBitSetContains(result, 4));
+
+    // different capacities: smaller set drops values out of its range
+    uint8_tBitSet *small = NEW_BIT_SET(uint8_t, 70);
+    uint8_tBitSetUnion(small, first);
+    assert_uint32(uint8_tBitSetSize(small), ==, 3);
+    assert_uint32(uint8_tBitSetNextSet(small, 4), ==, BIT_SET_NOT_FOUND);
+    uint8_tBitSetIntersect(first, small);
+    assert_uint32(uint8_tBitSetSize(first), ==, 3);
+    assert_false(uint8_tBitSetContains(first, 255));
+    return MUNIT_OK;
+}
+
+static MunitResult testBitSetFindAndIterate(const MunitParameter params[], void *data) {
+    flagBitSet *set = NEW_BIT_SET(flag, 1000);
+    uint16_t values[] = {0, 5, 63, 64, 127, 500, 999};
+    for (uint32_t i = 0; i < ARRAY_SIZE(values); i++) {
+        flagBitSetAdd(set, values[i]);
+    }
+
+    assert_uint32(flagBitSetFirst(set), ==, 0);
+    assert_uint32(flagBitSetNextSet(set, 1), ==, 5);
+    assert_uint32(flagBitSetNextSet(set, 64), ==, 64);
+    assert_uint32(flagBitSetNextSet(set, 128), ==, 500);
+    assert_uint32(flagBitSetNextSet(set, 1000), ==, BIT_SET_NOT_FOUND);
+
+    uint32_t index = 0;
+    for (uint32_t value = flagBitSetFirst(set); value != BIT_SET_NOT_FOUND; value = flagBitSetNextSet(set, value + 1)) {
+        assert_uint16(value, ==, values[index++]);
+    }
+    assert_uint32(index, ==, ARRAY_SIZE(values));
+
+    index = 0;
+    flagBitSetIterator iterator = flagBitSetIter(set);
+    while (flagBitSetHasNext(&iterator)) {
+        assert_uint16(iterator.value, ==, values[index++]);
+    }
+    assert_uint32(index, ==, ARRAY_SIZE(values));
+
+    flagBitSetIterator emptyIterator = flagBitSetIter(NEW_BIT_SET_64(flag));
+    assert_false(flagBitSetHasNext(&emptyIterator));
+    flagBitSetIterator nullIterator = flagBitSetIter(NULL);
+    assert_false(flagBitSetHasNext(&nullIterator));
+    return MUNIT_OK;
+}
+
+static MunitResult testBitSetLoad(const MunitParameter params[], void *data) {
+    flagBitSet first;
+    flagBitSet second;
+    flagBitSet result;
+    newflagBitSet(&first, bitSetLoadWordsA, BIT_SET_LOAD_CAPACITY);
+    newflagBitSet(&second, bitSetLoadWordsB, BIT_SET_LOAD_CAPACITY);
+    newflagBitSet(&result, bitSetLoadWordsC, BIT_SET_LOAD_CAPACITY);
+    for (uint32_t i = 0; i < BIT_SET_LOAD_CAPACITY; i += 3) {
+        flagBitSetAdd(&first, i);
+    }
+    for (uint32_t i = 0; i < BIT_SET_LOAD_CAPACITY; i += 5) {
+        flagBitSetAdd(&second, i);
+    }
+
+    uint64_t checksum = 0;
+    for (uint32_t round = 0; round < BIT_SET_LOAD_ROUNDS; round++) {
+        flagBitSetClear(&result);
+        flagBitSetUnion(&result, &first);
+        flagBitSetIntersect(&result, &second);  // multiples of 15
+        checksum += flagBitSetSize(&result);
+        flagBitSetUnion(&result, &first);
+        flagBitSetSubtract(&result, &second);
+        checksum += flagBitSetSize(&result);
+    }
+    assert_uint64(checksum, ==, (uint64_t) BIT_SET_LOAD_ROUNDS * (4370 + 21846 - 4370));
+
+    uint32_t count = 0;
+    flagBitSetIterator iterator = flagBitSetIter(&result);
+    while (flagBitSetHasNext(&iterator)) {
+        assert_uint16(iterator.value % 3, ==, 0);
+        count++;
+    }
+    assert_uint32(count, ==, 21846 - 4370);
+    return MUNIT_OK;
+}
+
+
+static MunitTest bufferBitSetTests[] = {
+        {.name =  "Test new BitSet - should correctly create and init set", .test = testBitSetCreation},
+        {.name =  "Test <type>BitSetAdd()/Remove() - should set and reset single bits", .test = testBitSetAddRemove},
+        {.name =  "Test <type>BitSetUnion()/Intersect()/Subtract() - should combine sets word by word", .test = testBitSetAlgebra},
+        {.name =  "Test <type>BitSetNextSet()/Iter() - should visit set values in ascending order", .test = testBitSetFindAndIterate},
+        {.name =  "Test BitSet Algebra Load - should combine and count big sets", .test = testBitSetLoad},
+        END_OF_TESTS
+};
+
+static const MunitSuite bufferBitSetTestSuite = {
+        .prefix = "BufferBitSet: ",
+        .tests = bufferBitSetTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "BufferBloomFilter.h"
+
+#define BLOOM_LOAD_VALUES 100000
+#define BLOOM_LOAD_ROUNDS 20
+
+
+CREATE_BLOOM_FILTER_TYPE(uint32_t);
+CREATE_BLOOM_FILTER_TYPE(char*, strKey, strHashCode);
+
+static BloomFilterBlock bloomLoadBlocks[BLOOM_FILTER_BLOCK_COUNT(BLOOM_LOAD_VALUES)];
+static uint32_t bloomLoadValues[BLOOM_LOAD_VALUES];
+static bool bloomLoadResults[BLOOM_LOAD_VALUES];
+
+
+static MunitResult testBloomFilterCreation(const MunitParameter params[], void *data) {
+    uint32_tBloomFilter *filter = NEW_BLOOM_FILTER(uint32_t, 100);
+    assert_not_null(filter);
+    assert_uint32(filter->blockCount, ==, 7);     // 1600 bits in 256 bit blocks
+    assert_uint32(uint32_tBloomSize(filter), ==, 0);
+    assert_true(isuint32_tBloomEmpty(filter));
+    assert_false(uint32_tBloomContains(filter, 0));
+    assert_uint32(NEW_BLOOM_FILTER_16(uint32_t)->blockCount, ==, 1);
+    assert_uint32(NEW_BLOOM_FILTER_1024(uint32_t)->blockCount, ==, 64);
+    assert_null(newuint32_tBloomFilter(&(uint32_tBloomFilter) {0}, NULL, 1));
+    assert_false(uint32_tBloomAdd(NULL, 1));
+    assert_false(uint32_tBloomContains(NULL, 1));
+    return MUNIT_OK;
+}
+
+static MunitResult testBloomFilterAddContains(const MunitParameter params[], void *data) {
+    uint32_tBloomFilter *filter = NEW_BLOOM_FILTER(uint32_t, 1024);
+    for (uint32_t i = 0; i < 1024; i++) {
+        uint32_tBloomAdd(filter, i * 4096);     // strided keys are mixed by filter
+    }
+    assert_uint32(uint32_tBloomSize(filter), >, 1000);    // values with all bits already set are not counted
+    assert_false(uint32_tBloomAdd(filter, 4096));         // nothing new
+    for (uint32_t i = 0; i < 1024; i++) {       // no false negatives
+        assert_true(uint32_tBloomContains(filter, i * 4096));
+    }
+
+    uint32_t falsePositives = 0;
+    for (uint32_t i = 0; i < 100000; i++) {
+        falsePositives += uint32_tBloomContains(filter, i * 4096 + 1);
+    }
+    assert_uint32(falsePositives, <, 500);   // < 0.5% at 16 bits per value
+
+    uint32_tBloomClear(filter);
+    assert_true(isuint32_tBloomEmpty(filter));
+    assert_false(uint32_tBloomContains(filter, 4096));
+    return MUNIT_OK;
+}
+
+static MunitResult testBloomFilterBatch(const MunitParameter params[], void *data) {
+    uint32_tBloomFilter *filter = NEW_BLOOM_FILTER(uint32_t, 512);
+    uint32_t values[100];
+    bool results[100];
+    for (uint32_t i = 0; i < 100; i++) {
+        values[i] = i * 3;
+    }
+    uint32_tBloomAddAll(filter, values, 50);    // batch smaller than and not multiple of prefetch batch
+    assert_uint32(uint32_tBloomContainsBatch(filter, values, 100, results), >=, 50);
+    for (uint32_t i = 0; i < 100; i++) {
+        assert_true(results[i] == uint32_tBloomContains(filter, values[i]));
+        if (i < 50) {
+            assert_true(results[i]);
+        }
+    }
+    assert_uint32(uint32_tBloomContainsBatch(NULL, values, 100, results), ==, 0);
+    assert_false(results[0]);
+    return MUNIT_OK;
+}
+
+static MunitResult testBloomFilterStrings(const MunitParameter params[], void *data) {
+    strKeyBloomFilter *filter = NEW_BLOOM_FILTER(strKey, 64);
+    assert_true(strKeyBloomAdd(filter, "user:1"));
+    assert_true(strKeyBloomAdd(filter, "user:2"));
+    char key[16] = "user:1";
+    assert_true(strKeyBloomContains(filter, key));  // hashed by content, not pointer
+    assert_false(strKeyBloomContains(filter, "user:3"));
+    assert_uint32(strKeyBloomSize(filter), ==, 2);
+    return MUNIT_OK;
+}
+
+static MunitResult testBloomFilterLoad(const MunitParameter params[], void *data) {
+    uint32_tBloomFilter filter;
+    assert_not_null(newuint32_tBloomFilter(&filter, bloomLoadBlocks, ARRAY_SIZE(bloomLoadBlocks)));
+    for (uint32_t i = 0; i < BLOOM_LOAD_VALUES; i++) {
+        bloomLoadValues[i] = i * 16;
+    }
+    uint32_tBloomAddAll(&filter, bloomLoadValues, BLOOM_LOAD_VALUES);
+
+    for (uint32_t round = 0; round < BLOOM_LOAD_ROUNDS; round++) {
+        for (uint32_t i = 0; i < BLOOM_LOAD_VALUES; i++) {
+            bloomLoadValues[i] = i * 16 + (round & 1);  // odd rounds query absent values
+        }
+        uint32_t containedCount = uint32_tBloomContainsBatch(&filter, bloomLoadValues, BLOOM_LOAD_VALUES, bloomLoadResults);
+        if (round % 2 == 0) {
+            assert_uint32(containedCount, ==, BLOOM_LOAD_VALUES);
+        } else {
+            assert_uint32(containedCount, <, BLOOM_LOAD_VALUES / 200);
+        }
+    }
+    return MUNIT_OK;
+}
+
+
+static MunitTest bufferBloomFilterTests[] = {
+        {.name =  "Test new BloomFilter - should correctly create and init filter", .test = testBloomFilterCreation},
+        {.name =  "Test <type>BloomAdd()/Contains() - should have no false negatives and few false positives", .test = testBloomFilterAddContains},
+        {.name =  "Test <type>BloomAddAll()/ContainsBatch() - should match single value calls", .test = testBloomFilterBatch},
+        {.name =  "Test string BloomFilter - should hash strings by content", .test = testBloomFilterStrings},
+        {.name =  "Test BloomFilter Batch Lookup Load - should query a lot of values with prefetch", .test = testBloomFilterLoad},
+        END_OF_TESTS
+};
+
+static const MunitSuite bufferBloomFilterTestSuite = {
+        .prefix = "BufferBloomFilter: ",
+        .tests = bufferBloomFilterTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
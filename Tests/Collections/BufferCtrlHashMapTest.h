@@ -0,0 +1,185 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "BufferCtrlHashMap.h"
+
+
+CREATE_CTRL_HASH_MAP_TYPE(uint32_t, uint32_t, u32, u32);
+CREATE_CTRL_HASH_MAP_TYPE(char*, char*, ctrlStr, ctrlStr, strComparator, strHashCode);
+
+static uint32_t collidingHashCode(uint32_t value) {  // all keys land in the same group with the same tag
+    (void) value;
+    return 0;
+}
+CREATE_CTRL_HASH_MAP_TYPE(uint32_t, uint32_t, clash, clash, uint32_tComparator, collidingHashCode);
+
+
+static MunitResult testCtrlMapCreation(const MunitParameter params[], void *data) {
+    u32_u32Map *map = NEW_CTRL_HASH_MAP(uint32_t, uint32_t, u32, u32, 4);
+    assert_uint32(map->size, ==, 0);
+    assert_uint32(map->capacity, ==, 16);
+    assert_uint32(map->ctrl[0], ==, HASH_MAP_CTRL_EMPTY);
+    assert_uint32(map->ctrl[15], ==, HASH_MAP_CTRL_EMPTY);
+
+    assert_uint32(NEW_CTRL_HASH_MAP_64(uint32_t, uint32_t, u32, u32)->capacity, ==, 128);
+    assert_uint32(NEW_CTRL_HASH_MAP(uint32_t, uint32_t, u32, u32, 112)->capacity, ==, 128);
+    assert_uint32(NEW_CTRL_HASH_MAP(uint32_t, uint32_t, u32, u32, 113)->capacity, ==, 256);
+
+    ctrlStr_ctrlStrMap *strMap = CTRL_HASH_MAP_OF(ctrlStr, ctrlStr, "k1", "v1", "k2", "v2", "k3", "v3");
+    assert_uint32(strMap->size, ==, 3);
+    assert_uint32(strMap->capacity, ==, 16);
+    assert_string_equal(ctrlStr_ctrlStrMapGet(strMap, "k2"), "v2");
+
+    u32_u32Map *ofMap = NEW_CTRL_HASH_MAP_OF(20, u32, u32, {1, 10}, {2, 20});
+    assert_uint32(ofMap->size, ==, 2);
+    assert_uint32(ofMap->capacity, ==, 32);
+    assert_uint32(u32_u32MapGet(ofMap, 2), ==, 20);
+    return MUNIT_OK;
+}
+
+static MunitResult testCtrlMapAddGetRemove(const MunitParameter params[], void *data) {
+    u32_u32Map *map = NEW_CTRL_HASH_MAP(uint32_t, uint32_t, u32, u32, 4);
+    for (uint32_t i = 0; i < 14; i++) {     // 7/8 of 16 slots
+        assert_true(u32_u32MapAdd(map, i, i * 10));
+    }
+    assert_false(u32_u32MapAdd(map, 100, 1000));    // full
+    assert_uint32(u32_u32MapSize(map), ==, 14);
+
+    for (uint32_t i = 0; i < 14; i++) {
+        assert_true(u32_u32MapContains(map, i));
+        assert_uint32(u32_u32MapGet(map, i), ==, i * 10);
+    }
+    assert_false(u32_u32MapContains(map, 100));
+    assert_uint32(u32_u32MapGetOrDefault(map, 100, 7), ==, 7);
+
+    assert_uint32(u32_u32MapRemove(map, 3), ==, 30);
+    assert_uint32(u32_u32MapRemove(map, 3), ==, 0);
+    assert_false(u32_u32MapContains(map, 3));
+    assert_uint32(u32_u32MapSize(map), ==, 13);
+
+    assert_true(u32_u32MapAdd(map, 100, 1000));
+    assert_false(u32_u32MapAdd(map, 100, 1001));    // existing key, value replaced
+    assert_uint32(u32_u32MapGet(map, 100), ==, 1000);
+    return MUNIT_OK;
+}
+
+static MunitResult testCtrlMapCollisions(const MunitParameter params[], void *data) {
+    clash_clashMap *map = NEW_CTRL_HASH_MAP(uint32_t, uint32_t, clash, clash, 50);
+    for (uint32_t i = 0; i < 50; i++) {     // overflow first group to the next ones
+        assert_true(clash_clashMapAdd(map, i, i + 1));
+    }
+    for (uint32_t i = 0; i < 50; i++) {
+        assert_uint32(clash_clashMapGet(map, i), ==, i + 1);
+    }
+
+    for (uint32_t i = 0; i < 50; i += 2) {  // tombstones in full groups must keep chain for the rest keys
+        assert_uint32(clash_clashMapRemove(map, i), ==, i + 1);
+    }
+    assert_uint32(map->deletedItemsCount, >, 0);
+    for (uint32_t i = 1; i < 50; i += 2) {
+        assert_uint32(clash_clashMapGet(map, i), ==, i + 1);
+    }
+    for (uint32_t i = 0; i < 50; i += 2) {
+        assert_false(clash_clashMapContains(map, i));
+        assert_true(clash_clashMapAdd(map, i, i + 1));
+    }
+    assert_uint32(clash_clashMapSize(map), ==, 50);
+    return MUNIT_OK;
+}
+
+static MunitResult testCtrlMapCompact(const MunitParameter params[], void *data) {
+    clash_clashMap *map = NEW_CTRL_HASH_MAP(uint32_t, uint32_t, clash, clash, 50);
+    for (uint32_t i = 0; i < 50; i++) {
+        assert_true(clash_clashMapAdd(map, i, i + 1));
+    }
+    for (uint32_t i = 0; i < 50; i += 2) {
+        clash_clashMapRemove(map, i);
+    }
+    assert_uint32(map->deletedItemsCount, ==, 24);     // key 48 was in the group that has never been full, no tombstone for it
+
+    clash_clashMapCompact(map);
+    assert_uint32(map->deletedItemsCount, ==, 0);
+    assert_uint32(clash_clashMapSize(map), ==, 25);
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        assert_uint32(map->ctrl[i], !=, HASH_MAP_CTRL_DELETED);
+    }
+    for (uint32_t i = 0; i < 50; i++) {
+        assert_uint32(clash_clashMapGet(map, i), ==, i % 2 == 1 ? i + 1 : 0);
+    }
+
+    u32_u32Map *churnMap = NEW_CTRL_HASH_MAP(uint32_t, uint32_t, u32, u32, 100);
+    uint32_t window = HASH_MAP_CTRL_MAX_LOAD(churnMap->capacity) - 1;
+    for (uint32_t i = 0; i < 100000; i++) {    // sliding window near max load, add reuses tombstones but takes empty slots
+        assert_true(u32_u32MapAdd(churnMap, i, i));
+        if (i >= window) {
+            assert_uint32(u32_u32MapRemove(churnMap, i - window), ==, i - window);
+        }
+        uint32_t emptySlots = churnMap->capacity - churnMap->size - churnMap->deletedItemsCount;
+        assert_uint32(emptySlots, >=, churnMap->capacity / HASH_MAP_GROUP_WIDTH);   // without purge all empty slots are used up
+    }
+    for (uint32_t i = 100000 - window; i < 100000; i++) {
+        assert_uint32(u32_u32MapGet(churnMap, i), ==, i);
+    }
+    assert_false(u32_u32MapContains(churnMap, 0));
+    return MUNIT_OK;
+}
+
+static MunitResult testCtrlMapIterAndClear(const MunitParameter params[], void *data) {
+    ctrlStr_ctrlStrMap *strMap = CTRL_HASH_MAP_OF(ctrlStr, ctrlStr, "k1", "v1", "k2", "v2", "k3", "v3");
+    ctrlStr_ctrlStrMap *otherMap = NEW_CTRL_HASH_MAP_8(char*, char*, ctrlStr, ctrlStr);
+    ctrlStr_ctrlStrMapAddAll(strMap, otherMap);
+    assert_uint32(ctrlStr_ctrlStrMapSize(otherMap), ==, 3);
+
+    uint32_t count = 0;
+    ctrlStr_ctrlStrMapIterator iterator = ctrlStr_ctrlStrMapIter(otherMap);
+    while (ctrlStr_ctrlStrMapHasNext(&iterator)) {
+        assert_string_equal(ctrlStr_ctrlStrMapGet(strMap, iterator.key), iterator.value);
+        count++;
+    }
+    assert_uint32(count, ==, 3);
+
+    ctrlStr_ctrlStrMapClear(otherMap);
+    assert_true(is_ctrlStr_ctrlStrMapEmpty(otherMap));
+    assert_false(ctrlStr_ctrlStrMapContains(otherMap, "k1"));
+    iterator = ctrlStr_ctrlStrMapIter(otherMap);
+    assert_false(ctrlStr_ctrlStrMapHasNext(&iterator));
+    return MUNIT_OK;
+}
+
+static MunitResult testCtrlMapLoad(const MunitParameter params[], void *data) {
+    u32_u32Map *map = NEW_CTRL_HASH_MAP(uint32_t, uint32_t, u32, u32, 14000);   // 16384 slots near max load
+    for (uint32_t i = 0; i < 14000; i++) {
+        assert_true(u32_u32MapAdd(map, i * 16, i));
+    }
+
+    for (uint32_t round = 0; round < 50; round++) {     // churn keeps map near full
+        for (uint32_t i = 0; i < 14000; i++) {
+            assert_uint32(u32_u32MapGet(map, i * 16), ==, i);
+        }
+        for (uint32_t i = round; i < 14000; i += 50) {
+            assert_uint32(u32_u32MapRemove(map, i * 16), ==, i);
+            assert_true(u32_u32MapAdd(map, i * 16, i));
+        }
+    }
+    assert_uint32(u32_u32MapSize(map), ==, 14000);
+    return MUNIT_OK;
+}
+
+
+static MunitTest bufferCtrlHashMapTests[] = {
+        {.name =  "Test new ctrl Map - should correctly create and init map", .test = testCtrlMapCreation},
+        {.name =  "Test <key>_<value>MapAdd()/Get()/Remove() - should correctly handle elements", .test = testCtrlMapAddGetRemove},
+        {.name =  "Test colliding keys - should probe next groups", .test = testCtrlMapCollisions},
+        {.name =  "Test <key>_<value>MapCompact() - should purge tombstones in place", .test = testCtrlMapCompact},
+        {.name =  "Test <key>_<value>MapIter()/Clear() - should iterate and clear map", .test = testCtrlMapIterAndClear},
+        {.name =  "Test ctrl map Load - should keep working under churn at high load factor", .test = testCtrlMapLoad},
+        END_OF_TESTS
+};
+
+static const MunitSuite bufferCtrlHashMapTestSuite = {
+        .prefix = "BufferCtrlHashMap: ",
+        .tests = bufferCtrlHashMapTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
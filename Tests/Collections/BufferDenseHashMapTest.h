@@ -0,0 +1,189 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "BufferDenseHashMap.h"
+
+
+CREATE_DENSE_HASH_MAP_TYPE(uint32_t, uint32_t, dense, dense);
+CREATE_DENSE_HASH_MAP_TYPE(char*, char*, denseStr, denseStr, strComparator, strHashCode);
+
+CREATE_DENSE_HASH_MAP_TYPE(uint32_t, uint32_t, denseClash, denseClash, uint32_tComparator, clusteredHashCode);
+
+
+static MunitResult testDenseMapCreation(const MunitParameter params[], void *data) {
+    dense_denseMap *map = NEW_DENSE_HASH_MAP(uint32_t, uint32_t, dense, dense, 4);
+    assert_uint32(map->size, ==, 0);
+    assert_uint32(map->capacity, ==, 8);
+    assert_uint32(map->slots[0], ==, DENSE_HASH_MAP_EMPTY_SLOT);
+    assert_uint32(NEW_DENSE_HASH_MAP_64(uint32_t, uint32_t, dense, dense)->capacity, ==, 128);
+
+    denseStr_denseStrMap *strMap = DENSE_HASH_MAP_OF(denseStr, denseStr, "k1", "v1", "k2", "v2", "k3", "v3");
+    assert_uint32(strMap->size, ==, 3);
+    assert_uint32(strMap->capacity, ==, 8);
+    assert_string_equal(denseStr_denseStrMapGet(strMap, "k2"), "v2");
+
+    dense_denseMap *ofMap = NEW_DENSE_HASH_MAP_OF(20, dense, dense, {1, 10}, {2, 20});
+    assert_uint32(ofMap->size, ==, 2);
+    assert_uint32(ofMap->capacity, ==, 64);
+    assert_uint32(dense_denseMapGet(ofMap, 2), ==, 20);
+    return MUNIT_OK;
+}
+
+static MunitResult testDenseMapAddGetRemove(const MunitParameter params[], void *data) {
+    denseClash_denseClashMap *map = NEW_DENSE_HASH_MAP(uint32_t, uint32_t, denseClash, denseClash, 32);
+    for (uint32_t i = 0; i < 32; i++) {
+        assert_true(denseClash_denseClashMapAdd(map, i, i + 1));
+    }
+    assert_false(denseClash_denseClashMapAdd(map, 100, 100));  // full
+    assert_false(denseClash_denseClashMapContains(map, 100));
+    for (uint32_t i = 0; i < 32; i++) {
+        assert_uint32(map->entries[i].key, ==, i);  // insertion order
+    }
+
+    for (uint32_t i = 0; i < 32; i += 2) {  // removal moves last entry to the gap and shifts slot cluster back
+        assert_uint32(denseClash_denseClashMapRemove(map, i), ==, i + 1);
+        assert_uint32(denseClash_denseClashMapRemove(map, i), ==, 0);
+    }
+    assert_uint32(denseClash_denseClashMapSize(map), ==, 16);
+    for (uint32_t i = 0; i < 32; i++) {
+        assert_uint32(denseClash_denseClashMapGet(map, i), ==, i % 2 == 1 ? i + 1 : 0);
+    }
+
+    uint32_t usedSlots = 0;
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        if (map->slots[i] != DENSE_HASH_MAP_EMPTY_SLOT) {
+            assert_uint32(map->slots[i], <=, map->size);
+            usedSlots++;
+        }
+    }
+    assert_uint32(usedSlots, ==, 16);
+
+    assert_false(denseClash_denseClashMapAdd(map, 1, 100));   // existing key, value replaced
+    assert_uint32(denseClash_denseClashMapGet(map, 1), ==, 100);
+    assert_uint32(map->deletedItemsCount, ==, 0);
+    return MUNIT_OK;
+}
+
+static MunitResult testDenseMapIterAndRemove(const MunitParameter params[], void *data) {
+    denseClash_denseClashMap *map = NEW_DENSE_HASH_MAP(uint32_t, uint32_t, denseClash, denseClash, 64);
+    for (uint32_t i = 0; i < 64; i++) {
+        denseClash_denseClashMapAdd(map, i, i + 1);
+    }
+
+    uint32_t expectedKey = 0;
+    denseClash_denseClashMapIterator iterator = denseClash_denseClashMapIter(map);
+    while (denseClash_denseClashMapHasNext(&iterator)) {
+        assert_uint32(iterator.key, ==, expectedKey++);
+    }
+    assert_uint32(expectedKey, ==, 64);
+
+    denseClash_denseClashMap *copy = NEW_DENSE_HASH_MAP(uint32_t, uint32_t, denseClash, denseClash, 64);
+    denseClash_denseClashMapAddAll(map, copy);
+    assert_uint32(denseClash_denseClashMapSize(copy), ==, 64);
+
+    uint32_t count = 0;
+    iterator = denseClash_denseClashMapIter(map);
+    while (denseClash_denseClashMapHasNext(&iterator)) {  // last entry moved to the place of removed one should not be missed
+        assert_uint32(iterator.value, ==, iterator.key + 1);
+        assert_uint32(denseClash_denseClashMapRemove(map, iterator.key), ==, iterator.key + 1);
+        count++;
+    }
+    assert_uint32(count, ==, 64);
+    assert_true(is_denseClash_denseClashMapEmpty(map));
+
+    denseClash_denseClashMapClear(copy);
+    assert_true(is_denseClash_denseClashMapEmpty(copy));
+    for (uint32_t i = 0; i < copy->capacity; i++) {
+        assert_uint32(copy->slots[i], ==, DENSE_HASH_MAP_EMPTY_SLOT);
+    }
+    assert_false(denseClash_denseClashMapContains(copy, 1));
+    iterator = denseClash_denseClashMapIter(copy);
+    assert_false(denseClash_denseClashMapHasNext(&iterator));
+    return MUNIT_OK;
+}
+
+static uint32_t denseClashSlotOf(denseClash_denseClashMap *map, uint32_t entryIndex) {
+    uint32_t slotCount = 0;
+    uint32_t slotIndex = map->capacity;
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        if (map->slots[i] == entryIndex + 1) {
+            slotIndex = i;
+            slotCount++;
+        }
+    }
+    return slotCount == 1 ? slotIndex : map->capacity;  // each entry is referenced by exactly one slot
+}
+
+static MunitResult testDenseMapRemoveMovesLastEntry(const MunitParameter params[], void *data) {
+    denseClash_denseClashMap *map = NEW_DENSE_HASH_MAP(uint32_t, uint32_t, denseClash, denseClash, 16);
+    for (uint32_t i = 0; i < 8; i++) {
+        denseClash_denseClashMapAdd(map, i, i + 1);
+    }
+
+    assert_uint32(denseClash_denseClashMapRemove(map, 2), ==, 3);
+    assert_uint32(map->size, ==, 7);
+    assert_uint32(map->entries[2].key, ==, 7);     // last entry fills the gap
+    assert_uint32(map->entries[2].value, ==, 8);
+    assert_uint32(map->entries[7].key, ==, 0);     // freed place is reset
+    uint32_t movedSlot = denseClashSlotOf(map, 2);
+    assert_uint32(movedSlot, <, map->capacity);    // slot of moved entry points to its new index
+    assert_uint32(denseClashSlotOf(map, 7), ==, map->capacity);
+    assert_uint32(denseClash_denseClashMapGet(map, 7), ==, 8);
+
+    assert_uint32(denseClash_denseClashMapRemove(map, 6), ==, 7);   // last entry itself, nothing moves
+    assert_uint32(map->entries[2].key, ==, 7);
+    assert_uint32(denseClashSlotOf(map, 2), <, map->capacity);
+
+    while (map->size > 0) {     // removal from the front moves the last entry every time
+        uint32_t lastKey = map->entries[map->size - 1].key;
+        denseClash_denseClashMapRemove(map, map->entries[0].key);
+        if (map->size > 0) {
+            assert_uint32(map->entries[0].key, ==, lastKey);
+            assert_uint32(denseClash_denseClashMapGet(map, lastKey), ==, lastKey + 1);
+        }
+        for (uint32_t i = 0; i < map->size; i++) {
+            assert_uint32(denseClashSlotOf(map, i), <, map->capacity);
+        }
+    }
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        assert_uint32(map->slots[i], ==, DENSE_HASH_MAP_EMPTY_SLOT);
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult testDenseMapDrainedIter(const MunitParameter params[], void *data) {
+    dense_denseMap *map = NEW_DENSE_HASH_MAP(uint32_t, uint32_t, dense, dense, 1024);
+    for (uint32_t i = 0; i < 512; i++) {
+        assert_true(dense_denseMapAdd(map, i * 16, i));
+    }
+    for (uint32_t i = 16; i < 512; i++) {     // drained, only few entries left in the big table
+        assert_uint32(dense_denseMapRemove(map, i * 16), ==, i);
+    }
+
+    uint32_t sum = 0;
+    dense_denseMapIterator iterator = dense_denseMapIter(map);
+    while (dense_denseMapHasNext(&iterator)) {
+        sum += iterator.value;
+    }
+    assert_uint32(sum, ==, 120);
+    assert_uint32(iterator.index, ==, 16);  // live entries only are visited, not table slots
+    return MUNIT_OK;
+}
+
+
+static MunitTest bufferDenseHashMapTests[] = {
+        {.name =  "Test new dense Map - should correctly create and init map", .test = testDenseMapCreation},
+        {.name =  "Test <key>_<value>MapAdd()/Get()/Remove() - should keep entries dense", .test = testDenseMapAddGetRemove},
+        {.name =  "Test <key>_<value>MapIter() - should iterate in insertion order and remove all keys while iterating", .test = testDenseMapIterAndRemove},
+        {.name =  "Test <key>_<value>MapRemove() - should move last entry to the gap and fix its slot index", .test = testDenseMapRemoveMovesLastEntry},
+        {.name =  "Test <key>_<value>MapIter() - should iterate drained map by live entries only", .test = testDenseMapDrainedIter},
+        END_OF_TESTS
+};
+
+static const MunitSuite bufferDenseHashMapTestSuite = {
+        .prefix = "BufferDenseHashMap: ",
+        .tests = bufferDenseHashMapTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "BufferFlatMap.h"
+
+#define FLAT_MAP_LOOKUP_KEYS 32
+
+CREATE_FLAT_MAP_TYPE(uint32_t, uint32_t, flat, flat);
+CREATE_FLAT_MAP_TYPE(char*, int, flatStr, flatInt, strComparator);
+
+
+static MunitResult testFlatMapCreation(const MunitParameter params[], void *data) {
+    flat_flatMap *map = NEW_FLAT_MAP(uint32_t, uint32_t, flat, flat, 8);
+    assert_not_null(map);
+    assert_uint32(map->entries.capacity, ==, 8);    // no slack for empty slots
+    assert_true(is_flat_flatMapEmpty(map));
+
+    map = NEW_FLAT_MAP_OF(8, flat, flat, {3, 30}, {1, 10}, {2, 20}, {1, 11});
+    assert_uint32(flat_flatMapSize(map), ==, 3);    // sorted in place, duplicated key kept once
+    assert_uint32(map->entries.items[0].key, ==, 1);
+    assert_uint32(map->entries.items[2].key, ==, 3);
+    assert_uint32(flat_flatMapGet(map, 2), ==, 20);
+    assert_uint32(flat_flatMapGet(map, 1), ==, 11);     // last of duplicated keys is kept
+
+    flatStr_flatIntMap *strMap = FLAT_MAP_OF(flatStr, flatInt, "b", 2, "a", 1, "c", 3);
+    assert_uint32(flatStr_flatIntMapSize(strMap), ==, 3);
+    assert_int(flatStr_flatIntMapGet(strMap, "a"), ==, 1);
+    assert_int(flatStr_flatIntMapGet(strMap, "c"), ==, 3);
+    assert_int(flatStr_flatIntMapGet(strMap, "d"), ==, 0);
+
+    flat_flatMapEntry entries[4];
+    assert_null(new_flat_flatBufferFlatMap(NULL, entries, 4));
+    assert_null(new_flat_flatBufferFlatMap(map, entries, 0));
+    return MUNIT_OK;
+}
+
+static MunitResult testFlatMapAddGetRemove(const MunitParameter params[], void *data) {
+    flat_flatMap *map = NEW_FLAT_MAP(uint32_t, uint32_t, flat, flat, 4);
+    assert_true(flat_flatMapAdd(map, 30, 3));
+    assert_true(flat_flatMapAdd(map, 10, 1));
+    assert_true(flat_flatMapAdd(map, 40, 4));
+    assert_true(flat_flatMapAdd(map, 20, 2));
+    assert_false(flat_flatMapAdd(map, 50, 5));     // full
+    assert_false(flat_flatMapAdd(map, 20, 22));    // existing key is updated even when full
+    assert_uint32(flat_flatMapGet(map, 20), ==, 22);
+    assert_uint32(flat_flatMapGetOrDefault(map, 50, 7), ==, 7);
+    assert_true(flat_flatMapContains(map, 40));
+    assert_false(flat_flatMapContains(map, 0));
+
+    uint32_t previousKey = 0;
+    flat_flatMapIterator iterator = flat_flatMapIter(map);
+    while (flat_flatMapHasNext(&iterator)) {    // keys come in order
+        assert_uint32(iterator.key, >, previousKey);
+        previousKey = iterator.key;
+    }
+    assert_uint32(previousKey, ==, 40);
+
+    assert_uint32(flat_flatMapRemove(map, 10), ==, 1);
+    assert_uint32(flat_flatMapRemove(map, 10), ==, 0);
+    assert_uint32(flat_flatMapSize(map), ==, 3);
+    assert_uint32(map->entries.items[0].key, ==, 20);
+    assert_true(flat_flatMapAdd(map, 50, 5));
+
+    flat_flatMap *copy = NEW_FLAT_MAP(uint32_t, uint32_t, flat, flat, 8);
+    flat_flatMapAdd(copy, 25, 0);
+    flat_flatMapAddAll(map, copy);
+    assert_uint32(flat_flatMapSize(copy), ==, 5);
+    assert_uint32(copy->entries.items[1].key, ==, 25);
+
+    flat_flatMapClear(map);
+    assert_true(is_flat_flatMapEmpty(map));
+    assert_false(flat_flatMapAdd(NULL, 1, 1));
+    assert_uint32(flat_flatMapGet(NULL, 1), ==, 0);
+    assert_uint32(flat_flatMapSize(NULL), ==, 0);
+    return MUNIT_OK;
+}
+
+static MunitResult testFlatMapFromArrayAndRange(const MunitParameter params[], void *data) {
+    flat_flatMap *map = NEW_FLAT_MAP(uint32_t, uint32_t, flat, flat, 64);
+    flat_flatMapEntry entries[50];
+    for (uint32_t i = 0; i < 50; i++) {
+        entries[i] = (flat_flatMapEntry) {.key = i * 2 + 1, .value = i};   // odd keys 1..99, already sorted
+    }
+    assert_true(flat_flatMapFromArray(map, entries, 50));
+    assert_uint32(flat_flatMapSize(map), ==, 50);
+
+    uint32_t expectedKey = 11;
+    flat_flatMapIterator iterator = flat_flatMapRangeIter(map, 10, 20);    // [10, 20)
+    while (flat_flatMapHasNext(&iterator)) {
+        assert_uint32(iterator.key, ==, expectedKey);
+        expectedKey += 2;
+    }
+    assert_uint32(expectedKey, ==, 21);
+    assert_uint32(flat_flatMapRangeSize(map, 10, 20), ==, 5);
+    assert_uint32(flat_flatMapRangeSize(map, 0, 1000), ==, 50);
+    assert_uint32(flat_flatMapRangeSize(map, 20, 10), ==, 0);
+    assert_uint32(flat_flatMapLowerBound(map, 0), ==, 0);
+    assert_uint32(flat_flatMapLowerBound(map, 99), ==, 49);
+    assert_uint32(flat_flatMapLowerBound(map, 100), ==, 50);
+
+    for (uint32_t i = 0; i < 50; i++) {
+        entries[i] = (flat_flatMapEntry) {.key = (i * 37) % 50, .value = i};  // shuffled, replaces previous content
+    }
+    assert_true(flat_flatMapFromArray(map, entries, 50));
+    assert_uint32(flat_flatMapSize(map), ==, 50);
+    for (uint32_t i = 0; i < 50; i++) {
+        assert_uint32(map->entries.items[i].key, ==, i);
+        assert_uint32(flat_flatMapGet(map, (i * 37) % 50), ==, i);
+    }
+
+    for (uint32_t i = 0; i < 50; i++) {
+        entries[i] = (flat_flatMapEntry) {.key = (i * 3) % 10, .value = i};    // unsorted, each key repeated 5 times
+    }
+    assert_true(flat_flatMapFromArray(map, entries, 50));
+    assert_uint32(flat_flatMapSize(map), ==, 10);
+    for (uint32_t i = 40; i < 50; i++) {
+        assert_uint32(flat_flatMapGet(map, (i * 3) % 10), ==, i);   // sort is stable, value of the last duplicate survives
+    }
+
+    flat_flatMapEntry tooMany[65] = {0};
+    assert_false(flat_flatMapFromArray(map, tooMany, 65));
+    return MUNIT_OK;
+}
+
+static MunitResult testFlatMapLookup(const MunitParameter params[], void *data) {
+    flat_flatMap *map = NEW_FLAT_MAP(uint32_t, uint32_t, flat, flat, FLAT_MAP_LOOKUP_KEYS);
+    for (uint32_t i = 0; i < FLAT_MAP_LOOKUP_KEYS; i++) {
+        flat_flatMapAdd(map, i * 2654435761U, i + 1);   // scattered keys, inserted out of order
+    }
+    for (uint32_t i = 0; i < FLAT_MAP_LOOKUP_KEYS * 2; i++) {   // every other lookup misses
+        uint32_t expected = i < FLAT_MAP_LOOKUP_KEYS ? i + 1 : 0;
+        assert_uint32(flat_flatMapGet(map, i * 2654435761U), ==, expected);
+    }
+    return MUNIT_OK;
+}
+
+
+static MunitTest bufferFlatMapTests[] = {
+        {.name =  "Test new flat Map - should create map with sorted initial entries", .test = testFlatMapCreation},
+        {.name =  "Test <key>_<value>MapAdd()/Get()/Remove() - should keep entries sorted", .test = testFlatMapAddGetRemove},
+        {.name =  "Test <key>_<value>MapFromArray()/RangeIter() - should build map at once and iterate key range", .test = testFlatMapFromArrayAndRange},
+        {.name =  "Test <key>_<value>MapGet() - should find scattered keys with binary search", .test = testFlatMapLookup},
+        END_OF_TESTS
+};
+
+static const MunitSuite bufferFlatMapTestSuite = {
+        .prefix = "BufferFlatMap: ",
+        .tests = bufferFlatMapTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -12,6 +12,19 @@ CREATE_HASH_MAP_TYPE(char*, char*, cStr, cStr, strComparator, strHashCode);
 CREATE_HASH_MAP_TYPE(str, str);
 CREATE_HASH_MAP_TYPE(user, int);
 
+#define SCRATCH_MAP_CAPACITY 32768
+#define SCRATCH_MAP_ROUNDS 1000
+
+#define COUNTER_MAP_KEYS 4096
+#define COUNTER_MAP_INCREMENTS 4000000
+
+static int_intMapEntry scratchMapEntries[HASH_MAP_ALIGN_CAPACITY(SCRATCH_MAP_CAPACITY)];
+static int_intMapEntry counterMapEntries[HASH_MAP_ALIGN_CAPACITY(COUNTER_MAP_KEYS * 2)];
+
+static int sumCounter(int value, int increment) {
+    return value + increment;
+}
+
 
 static void assertIntMap(int_intMap *intMap, int size, int capacity) {
     assert_uint32(intMap->size, ==, size);
@@ -163,6 +176,269 @@ static MunitResult testBuffMapIterator(const MunitParameter params[], void *data
     return MUNIT_OK;
 }
 
+static MunitResult testBuffMapGetBatch(const MunitParameter params[], void *data) {
+    int_intMap *map = NEW_HASH_MAP(int, int, 64);
+    int keys[50];
+    int values[50];
+    for (int i = 0; i < 50; i++) {  // not multiple of batch size
+        keys[i] = i * 7;
+        if (i % 2 == 0) {
+            int_intMapAdd(map, keys[i], i + 1);
+        }
+    }
+
+    int_intMapGetBatch(map, keys, 50, values);
+    for (int i = 0; i < 50; i++) {
+        assert_int(values[i], ==, i % 2 == 0 ? i + 1 : 0);
+    }
+
+    int_intMapClear(map);
+    int_intMapGetBatch(map, keys, 50, values);
+    for (int i = 0; i < 50; i++) {
+        assert_int(values[i], ==, 0);
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffMapCollisionFloodLoad(const MunitParameter params[], void *data) {
+    int_intMap *map = NEW_HASH_MAP(int, int, 4096);
+    for (int i = 0; i < 4096; i++) {    // crafted keys, identity hash puts all of them to slot 0 without seed
+        assert_true(int_intMapAdd(map, i << 13, i));
+    }
+    for (int round = 0; round < 8; round++) {
+        for (int i = 0; i < 4096; i++) {
+            assert_int(int_intMapGet(map, i << 13), ==, i);
+        }
+    }
+
+    uint32_t maxProbeLength = 0;
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        if (!map->entries[i].isEmptySlot) {
+            uint32_t home = HASH_MAP_SEEDED_HASH_CODE(intHashCode(map->entries[i].key), map->seed) & (map->capacity - 1);
+            uint32_t probeLength = (i - home) & (map->capacity - 1);
+            maxProbeLength = probeLength > maxProbeLength ? probeLength : maxProbeLength;
+        }
+    }
+#if defined(HASH_MAP_SEEDED_HASH) || INT_HASH_ALGORITHM != INT_HASH_IDENTITY
+    assert_uint32(maxProbeLength, <, 64);
+#else
+    assert_uint32(maxProbeLength, ==, 4095);   // single chain
+#endif
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffMapSeededStringHash(const MunitParameter params[], void *data) {
+    str_intMap *map = NEW_HASH_MAP(char*, int, str, int, 64);
+    const char *key = "session:42";
+#ifdef HASH_MAP_SEEDED_HASH
+    uint32_t hash = strHashCodeSeeded(key, strlen(key), map->seed);   // seed is taken by string hash, not mixed after full hash collision
+#else
+    uint32_t hash = strHashCode(key);
+#endif
+    assert_uint32(str_intMapHomeIndex(map, (char *) key), ==, hash & (map->capacity - 1));
+    assert_true(str_intMapAdd(map, (char *) key, 42));
+    assert_int(str_intMapGet(map, (char *) key), ==, 42);
+    return MUNIT_OK;
+}
+
+static uint32_t totalIntMapProbeLength(int_intMap *map) {
+    uint32_t totalProbeLength = 0;
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        if (!map->entries[i].isEmptySlot) {
+            totalProbeLength += (i - int_intMapHomeIndex(map, map->entries[i].key)) & (map->capacity - 1);
+        }
+    }
+    return totalProbeLength;
+}
+
+static MunitResult testBuffMapCompact(const MunitParameter params[], void *data) {
+    int_intMap *map = NEW_HASH_MAP(int, int, 64);
+    for (int i = 0; i < 63; i++) {  // without seed all keys have home slot 0
+        assert_true(int_intMapAdd(map, i * 128, i));
+    }
+    for (int i = 0; i < 63; i += 2) {
+        assert_int(int_intMapRemove(map, i * 128), ==, i);
+    }
+    assert_uint32(map->deletedItemsCount, ==, 32);
+    uint32_t probeLength = totalIntMapProbeLength(map);
+
+    int_intMapCompact(map);
+    assert_uint32(map->deletedItemsCount, ==, 0);
+    assert_uint32(map->size, ==, 31);
+    assert_uint32(totalIntMapProbeLength(map), <=, probeLength);
+#if !defined(HASH_MAP_SEEDED_HASH) && INT_HASH_ALGORITHM == INT_HASH_IDENTITY
+    assert_uint32(probeLength, ==, 961);
+    assert_uint32(totalIntMapProbeLength(map), ==, 465);   // remaining keys moved to the head of the cluster
+#endif
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        assert_false(map->entries[i].isDeleted);
+    }
+    for (int i = 0; i < 63; i++) {
+        assert_int(int_intMapGet(map, i * 128), ==, i % 2 == 1 ? i : 0);
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffMapStats(const MunitParameter params[], void *data) {
+#ifdef HASH_MAP_STATS
+    int_intMap *map = NEW_HASH_MAP(int, int, 64);
+    for (int i = 0; i < 63; i++) {
+        assert_true(int_intMapAdd(map, i * 128, i));
+    }
+    HashTableStats stats;
+    int_intMapGetStats(map, &stats);
+    assert_uint32(stats.size, ==, 63);
+    assert_uint32(stats.capacity, ==, 128);
+    assert_uint32(stats.resizeCount, ==, 0);
+    assert_size(stats.allocatedBytes, ==, sizeof(int_intMap) + 128 * sizeof(int_intMapEntry));
+    assert_uint64(stats.totalProbeLength, ==, totalIntMapProbeLength(map));
+#if !defined(HASH_MAP_SEEDED_HASH) && INT_HASH_ALGORITHM == INT_HASH_IDENTITY
+    assert_uint32(stats.maxProbeLength, ==, 62);   // single cluster from slot 0
+    assert_float(stats.averageProbeLength, ==, 31.0f);
+    assert_uint32(stats.probeLengthHistogram[0], ==, 1);
+    assert_uint32(stats.probeLengthHistogram[HASH_STATS_HISTOGRAM_SIZE - 1], ==, 63 - (HASH_STATS_HISTOGRAM_SIZE - 1));
+#endif
+
+    for (int i = 0; i < 63; i += 2) {
+        int_intMapRemove(map, i * 128);
+    }
+    int_intMapGetStats(map, &stats);
+    assert_uint32(stats.size, ==, 31);
+    assert_float(stats.tombstoneRatio, ==, 0.25f);
+    int_intMapCompact(map);
+    int_intMapGetStats(map, &stats);
+    assert_uint32(stats.resizeCount, ==, 1);
+    assert_float(stats.tombstoneRatio, ==, 0.0f);
+    assert_float(stats.loadFactor, ==, 31.0f / 128.0f);
+    return MUNIT_OK;
+#else
+    return MUNIT_SKIP;
+#endif
+}
+
+static MunitResult testBuffMapTombstoneChurnLoad(const MunitParameter params[], void *data) {
+    int_intMap *map = NEW_HASH_MAP(int, int, 64);
+    for (int i = 0; i < 1000000; i++) {    // without purge all slots end up used or deleted and missing key lookup never stops
+        assert_true(int_intMapAdd(map, i, i));
+        if (i >= 60) {
+            assert_int(int_intMapRemove(map, i - 60), ==, i - 60);
+        }
+        assert_false(int_intMapContains(map, -1));
+        assert_uint32(map->deletedItemsCount, <=, HASH_MAP_TOMBSTONE_PURGE_THRESHOLD(map->capacity) + 1);
+    }
+    assert_uint32(map->size, ==, 60);
+    return MUNIT_OK;
+}
+
+
+static MunitResult testBuffMapReuseAfterClear(const MunitParameter params[], void *data) {
+    int_intMap *map = NEW_HASH_MAP(int, int, 16);
+    for (int i = 0; i < 16; i++) {
+        assert_true(int_intMapAdd(map, i * 32, i));
+    }
+    int_intMapRemove(map, 0);   // tombstone before clear
+    int_intMapClear(map);
+    assert_true(is_int_intMapEmpty(map));
+    assert_uint32(map->deletedItemsCount, ==, 0);
+    for (int i = 0; i < 16; i++) {
+        assert_false(int_intMapContains(map, i * 32));
+    }
+
+    for (int i = 0; i < 8; i++) {   // same home slots as cleared keys
+        assert_true(int_intMapAdd(map, i * 64, i + 100));
+    }
+    assert_uint32(int_intMapSize(map), ==, 8);
+    assert_int(int_intMapGet(map, 64), ==, 101);
+    assert_false(int_intMapContains(map, 32));
+
+    uint32_t count = 0;
+    int_intMapIterator iterator = int_intMapIter(map);
+    while (int_intMapHasNext(&iterator)) {
+        assert_int(iterator.key % 64, ==, 0);
+        count++;
+    }
+    assert_uint32(count, ==, 8);
+
+    for (uint32_t round = 0; round < 70000; round++) {  // generation counter wraps around
+        int_intMapClear(map);
+        assert_true(int_intMapAdd(map, (int) round, 1));
+        assert_false(int_intMapContains(map, (int) round - 1));
+    }
+    assert_uint32(int_intMapSize(map), ==, 1);
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffMapScratchClearLoad(const MunitParameter params[], void *data) {
+    int_intMap map;
+    new_int_intBufferMap(&map, scratchMapEntries, ARRAY_SIZE(scratchMapEntries));
+    for (int round = 0; round < SCRATCH_MAP_ROUNDS; round++) {  // big map reused per request with few keys
+        for (int i = 0; i < 40; i++) {
+            int_intMapAdd(&map, round * 40 + i, i);
+        }
+        assert_int(int_intMapGet(&map, round * 40 + 39), ==, 39);
+        assert_false(int_intMapContains(&map, round * 40 - 1));
+        int_intMapClear(&map);
+    }
+    assert_true(is_int_intMapEmpty(&map));
+    return MUNIT_OK;
+}
+
+
+static MunitResult testBuffMapUpsertAndSlot(const MunitParameter params[], void *data) {
+    int_intMap *map = NEW_HASH_MAP(int, int, 4);
+    assert_true(int_intMapUpsert(map, 1, 5, sumCounter));   // absent key takes value as is
+    assert_true(int_intMapUpsert(map, 1, 3, sumCounter));
+    assert_int(int_intMapGet(map, 1), ==, 8);
+    assert_true(int_intMapUpsert(map, 1, 42, NULL));        // plain replace without merge
+    assert_int(int_intMapGet(map, 1), ==, 42);
+    assert_uint32(int_intMapSize(map), ==, 1);
+
+    int *slot = int_intMapGetOrAddSlot(map, 2, 100);
+    assert_not_null(slot);
+    assert_int(*slot, ==, 100);
+    (*slot)++;
+    assert_int(*int_intMapGetOrAddSlot(map, 2, 0), ==, 101);   // existing key keeps value
+    assert_int(int_intMapGet(map, 2), ==, 101);
+
+    assert_true(int_intMapAdd(map, 3, 3));
+    assert_true(int_intMapAdd(map, 4, 4));
+    assert_null(int_intMapGetOrAddSlot(map, 5, 0));            // full, new key rejected
+    assert_false(int_intMapUpsert(map, 5, 1, sumCounter));
+    assert_true(int_intMapUpsert(map, 4, 1, sumCounter));      // existing key still updated when full
+    assert_int(int_intMapGet(map, 4), ==, 5);
+    assert_uint32(int_intMapSize(map), ==, 4);
+
+    int_intMapRemove(map, 3);   // tombstone slot reused
+    assert_not_null(int_intMapGetOrAddSlot(map, 6, 6));
+    assert_uint32(int_intMapSize(map), ==, 4);
+    assert_false(int_intMapUpsert(NULL, 1, 1, sumCounter));
+    assert_null(int_intMapGetOrAddSlot(NULL, 1, 1));
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffMapGetAddCounterLoad(const MunitParameter params[], void *data) {
+    int_intMap map;
+    new_int_intBufferMap(&map, counterMapEntries, ARRAY_SIZE(counterMapEntries));
+    for (uint32_t i = 0; i < COUNTER_MAP_INCREMENTS; i++) {
+        int key = (int) ((i * 2654435761U) % COUNTER_MAP_KEYS);
+        int_intMapAdd(&map, key, int_intMapGet(&map, key) + 1);     // two probes per increment
+    }
+    assert_uint32(int_intMapSize(&map), ==, COUNTER_MAP_KEYS);
+    assert_int(int_intMapGet(&map, 7), ==, COUNTER_MAP_INCREMENTS / COUNTER_MAP_KEYS);
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffMapSlotCounterLoad(const MunitParameter params[], void *data) {
+    int_intMap map;
+    new_int_intBufferMap(&map, counterMapEntries, ARRAY_SIZE(counterMapEntries));
+    for (uint32_t i = 0; i < COUNTER_MAP_INCREMENTS; i++) {
+        int key = (int) ((i * 2654435761U) % COUNTER_MAP_KEYS);
+        (*int_intMapGetOrAddSlot(&map, key, 0))++;  // single probe per increment
+    }
+    assert_uint32(int_intMapSize(&map), ==, COUNTER_MAP_KEYS);
+    assert_int(int_intMapGet(&map, 7), ==, COUNTER_MAP_INCREMENTS / COUNTER_MAP_KEYS);
+    return MUNIT_OK;
+}
 
 
 static MunitTest bufferHashMapTests[] = {
@@ -176,6 +452,17 @@ static MunitTest bufferHashMapTests[] = {
         {.name =  "Test is<key>_<value>MapEmpty() - should correctly check map emptiness", .test = testBuffMapEmpty},
         {.name =  "Test <key>_<value>MapHasKey() - should correctly check that map contains key", .test = testBuffMapContains},
         {.name =  "Test <key>_<value>MapIterator - should correctly check iterate through key/value", .test = testBuffMapIterator},
+        {.name =  "Test <key>_<value>MapGetBatch() - should return values for all keys", .test = testBuffMapGetBatch},
+        {.name =  "Test map Collision Flood Load - should find crafted colliding keys", .test = testBuffMapCollisionFloodLoad},
+        {.name =  "Test map seeded string hash - should pass map seed into string hash", .test = testBuffMapSeededStringHash},
+        {.name =  "Test <key>_<value>MapCompact() - should purge tombstones in place", .test = testBuffMapCompact},
+        {.name =  "Test <key>_<value>MapGetStats() - should report probe lengths and occupancy", .test = testBuffMapStats},
+        {.name =  "Test map Tombstone Churn Load - should purge tombstones automatically", .test = testBuffMapTombstoneChurnLoad},
+        {.name =  "Test <key>_<value>MapClear() - should reuse map after clear", .test = testBuffMapReuseAfterClear},
+        {.name =  "Test map Scratch Clear Load - should clear big map with few keys a lot of times", .test = testBuffMapScratchClearLoad},
+        {.name =  "Test <key>_<value>MapUpsert()/GetOrAddSlot() - should add or update key in single probe", .test = testBuffMapUpsertAndSlot},
+        {.name =  "Test map Get/Add Counter Load - should count keys with lookup and add", .test = testBuffMapGetAddCounterLoad},
+        {.name =  "Test map Value Slot Counter Load - should count keys with single probe", .test = testBuffMapSlotCounterLoad},
         END_OF_TESTS
 };
 
@@ -13,6 +13,14 @@ typedef char *str;
 CREATE_HASH_SET_TYPE(str);
 CREATE_HASH_SET_TYPE(user);
 
+#define SET_ALGEBRA_LOAD_BIG_SIZE 50000
+#define SET_ALGEBRA_LOAD_SMALL_SIZE 1000
+#define SET_ALGEBRA_LOAD_ROUNDS 200
+
+static intHashSetEntry setAlgebraBigEntries[HASH_SET_ALIGN_CAPACITY(SET_ALGEBRA_LOAD_BIG_SIZE)];
+static intHashSetEntry setAlgebraSmallEntries[HASH_SET_ALIGN_CAPACITY(SET_ALGEBRA_LOAD_SMALL_SIZE)];
+static intHashSetEntry setAlgebraResultEntries[HASH_SET_ALIGN_CAPACITY(SET_ALGEBRA_LOAD_SMALL_SIZE)];
+
 
 static void assertIntSet(intHashSet *intSet, int size, int capacity) {
     assert_uint32(intSet->size, ==, size);
@@ -145,6 +153,238 @@ static MunitResult testBuffSetIterator(const MunitParameter params[], void *data
     return MUNIT_OK;
 }
 
+static MunitResult testBuffSetCompact(const MunitParameter params[], void *data) {
+    intHashSet *set = NEW_HASH_SET(int, 32);
+    for (int i = 0; i < 31; i++) {
+        assert_true(intSetAdd(set, i * 64));
+    }
+    for (int i = 0; i < 31; i += 2) {
+        assert_true(intSetRemove(set, i * 64));
+    }
+    assert_uint32(set->deletedItemsCount, ==, 16);
+
+    intSetCompact(set);
+    assert_uint32(set->deletedItemsCount, ==, 0);
+    assert_uint32(set->size, ==, 15);
+    for (uint32_t i = 0; i < set->capacity; i++) {
+        assert_false(set->entries[i].isDeleted);
+    }
+    for (int i = 0; i < 31; i++) {
+        assert_true(intSetContains(set, i * 64) == (i % 2 == 1));
+    }
+
+    for (int i = 0; i < 100000; i++) {  // add/remove churn purges tombstones on add
+        assert_true(intSetAdd(set, 10000 + i));
+        assert_true(intSetRemove(set, 10000 + i));
+        assert_false(intSetContains(set, -1));
+    }
+    assert_uint32(set->size, ==, 15);
+    assert_uint32(set->deletedItemsCount, <=, HASH_SET_TOMBSTONE_PURGE_THRESHOLD(set->capacity) + 1);
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffSetStats(const MunitParameter params[], void *data) {
+#ifdef HASH_MAP_STATS
+    intHashSet *set = NEW_HASH_SET(int, 32);
+    for (int i = 0; i < 31; i++) {
+        intSetAdd(set, i * 64);
+    }
+    for (int i = 0; i < 31; i += 2) {
+        intSetRemove(set, i * 64);
+    }
+    HashTableStats stats;
+    intSetGetStats(set, &stats);
+    assert_uint32(stats.size, ==, 15);
+    assert_uint32(stats.capacity, ==, 64);
+    assert_uint32(stats.deletedItemsCount, ==, 16);
+    assert_float(stats.tombstoneRatio, ==, 0.25f);
+    assert_size(stats.allocatedBytes, ==, sizeof(intHashSet) + 64 * sizeof(intHashSetEntry));
+#if !defined(HASH_MAP_SEEDED_HASH) && INT_HASH_ALGORITHM == INT_HASH_IDENTITY
+    assert_uint32(stats.maxProbeLength, ==, 29);   // every second key of the cluster from slot 0 removed
+#endif
+
+    intSetCompact(set);
+    intSetGetStats(set, &stats);
+    assert_uint32(stats.resizeCount, ==, 1);
+    assert_uint32(stats.deletedItemsCount, ==, 0);
+#if !defined(HASH_MAP_SEEDED_HASH) && INT_HASH_ALGORITHM == INT_HASH_IDENTITY
+    assert_uint32(stats.maxProbeLength, ==, 14);
+    assert_float(stats.averageProbeLength, ==, 7.0f);
+#endif
+    return MUNIT_OK;
+#else
+    return MUNIT_SKIP;
+#endif
+}
+
+
+static MunitResult testBuffSetUnion(const MunitParameter params[], void *data) {
+    intHashSet *first = HASH_SET_OF(int, 1, 2, 3);
+    intHashSet *second = HASH_SET_OF(int, 3, 4, 5);
+    intHashSet *result = NEW_HASH_SET_8(int);
+    assert_true(intSetUnion(result, first, second));
+    assert_uint32(result->size, ==, 5);
+    assert_true(intSetContainsAll(result, first));
+    assert_true(intSetContainsAll(result, second));
+
+    assert_false(intSetUnion(first, first, second));    // in place, set of 3 values holds 4 at most
+    assert_uint32(first->size, ==, 4);
+
+    intHashSet *bigFirst = NEW_HASH_SET_8(int);
+    intSetAdd(bigFirst, 1);
+    assert_true(intSetUnion(bigFirst, bigFirst, second));
+    assert_uint32(bigFirst->size, ==, 4);
+    assert_true(intSetContainsAll(bigFirst, second));
+    assert_false(intSetUnion(NULL, first, second));
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffSetIntersect(const MunitParameter params[], void *data) {
+    strHashSet *first = HASH_SET_OF(str, "v1", "v2", "v3", "v4");
+    strHashSet *second = HASH_SET_OF(str, "v3", "v4", "v5");
+    strHashSet *result = NEW_HASH_SET_8(str);
+    assert_true(strSetIntersect(result, first, second));
+    assert_uint32(result->size, ==, 2);
+    assert_true(strSetContains(result, "v3"));
+    assert_true(strSetContains(result, "v4"));
+
+    strHashSet *emptyResult = NEW_HASH_SET_8(str);
+    assert_true(strSetIntersect(emptyResult, first, NEW_HASH_SET_8(str)));
+    assert_true(isstrSetEmpty(emptyResult));
+    assert_false(strSetIntersect(result, NULL, second));
+
+    assert_true(strSetIntersect(first, first, second));    // in place, same as RetainAll
+    assert_uint32(first->size, ==, 2);
+    assert_false(strSetContains(first, "v1"));
+    assert_true(strSetContainsAll(first, result));
+    assert_true(strSetIntersect(second, first, second));
+    assert_uint32(second->size, ==, 2);
+    assert_false(strSetContains(second, "v5"));
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffSetSymmetricDifference(const MunitParameter params[], void *data) {
+    intHashSet *first = HASH_SET_OF(int, 1, 2, 3);
+    intHashSet *second = HASH_SET_OF(int, 3, 4);
+    intHashSet *result = NEW_HASH_SET_8(int);
+    assert_true(intSetSymmetricDifference(result, first, second));
+    assert_uint32(result->size, ==, 3);
+    assert_true(intSetContainsAll(result, HASH_SET_OF(int, 1, 2, 4)));
+    assert_false(intSetContains(result, 3));
+
+    intHashSet *inPlace = NEW_HASH_SET_8(int);
+    intSetAddAll(first, inPlace);
+    assert_true(intSetSymmetricDifference(inPlace, inPlace, second));  // common value removed, not union
+    assert_uint32(inPlace->size, ==, 3);
+    assert_true(intSetContainsAll(inPlace, result));
+    assert_false(intSetContains(inPlace, 3));
+    assert_false(intSetSymmetricDifference(second, first, second));   // set of 2 values can't hold {1, 2, 4}
+
+    intHashSet *bigSecond = NEW_HASH_SET_8(int);
+    intSetAdd(bigSecond, 3);
+    intSetAdd(bigSecond, 4);
+    assert_true(intSetSymmetricDifference(bigSecond, first, bigSecond));
+    assert_uint32(bigSecond->size, ==, 3);
+    assert_true(intSetContainsAll(bigSecond, result));
+    assert_true(intSetSymmetricDifference(result, result, result));
+    assert_true(isintSetEmpty(result));
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffSetSubtract(const MunitParameter params[], void *data) {
+    intHashSet *set = HASH_SET_OF(int, 1, 2, 3, 4, 5);
+    assert_true(intSetSubtract(set, HASH_SET_OF(int, 2, 4, 6)));   // smaller operand iterated
+    assert_uint32(set->size, ==, 3);
+    assert_true(intSetContainsAll(set, HASH_SET_OF(int, 1, 3, 5)));
+
+    intHashSet *bigSet = NEW_HASH_SET_32(int);
+    for (int i = 0; i < 30; i++) {
+        intSetAdd(bigSet, i);
+    }
+    assert_true(intSetSubtract(set, bigSet));   // bigger operand probed
+    assert_true(isintSetEmpty(set));
+    assert_false(intSetSubtract(set, bigSet));
+
+    assert_true(intSetSubtract(bigSet, bigSet));
+    assert_true(isintSetEmpty(bigSet));
+    assert_false(intSetSubtract(NULL, bigSet));
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffSetRetainAll(const MunitParameter params[], void *data) {
+    strHashSet *set = HASH_SET_OF(str, "v1", "v2", "v3", "v4");
+    assert_true(strSetRetainAll(set, HASH_SET_OF(str, "v2", "v4", "v6")));
+    assert_uint32(set->size, ==, 2);
+    assert_true(strSetContains(set, "v2"));
+    assert_true(strSetContains(set, "v4"));
+    assert_false(strSetContains(set, "v1"));
+
+    assert_false(strSetRetainAll(set, HASH_SET_OF(str, "v2", "v4")));   // nothing removed
+    assert_false(strSetRetainAll(set, set));
+    assert_true(strSetRetainAll(set, NEW_HASH_SET_8(str)));
+    assert_true(isstrSetEmpty(set));
+    assert_false(strSetRetainAll(set, NEW_HASH_SET_8(str)));   // empty set is not changed
+    assert_true(strSetAdd(set, "v1"));  // cleared set takes new values
+    assert_true(strSetContains(set, "v1"));
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffSetAlgebraLoad(const MunitParameter params[], void *data) {
+    intHashSet bigSet;
+    intHashSet smallSet;
+    intHashSet resultSet;
+    newintBufferSet(&bigSet, setAlgebraBigEntries, ARRAY_SIZE(setAlgebraBigEntries));
+    newintBufferSet(&smallSet, setAlgebraSmallEntries, ARRAY_SIZE(setAlgebraSmallEntries));
+    newintBufferSet(&resultSet, setAlgebraResultEntries, ARRAY_SIZE(setAlgebraResultEntries));
+    for (int i = 0; i < SET_ALGEBRA_LOAD_BIG_SIZE; i++) {
+        intSetAdd(&bigSet, i * 2);
+    }
+    for (int i = 0; i < SET_ALGEBRA_LOAD_SMALL_SIZE; i++) {
+        intSetAdd(&smallSet, i * 7);
+    }
+
+    for (int round = 0; round < SET_ALGEBRA_LOAD_ROUNDS; round++) {
+        intSetClear(&resultSet);
+        assert_true(intSetIntersect(&resultSet, &bigSet, &smallSet));   // probes big set only for small set values
+        assert_uint32(resultSet.size, ==, SET_ALGEBRA_LOAD_SMALL_SIZE / 2);
+        assert_true(intSetSubtract(&resultSet, &bigSet));
+        assert_true(isintSetEmpty(&resultSet));
+    }
+    return MUNIT_OK;
+}
+
+
+static MunitResult testBuffSetReuseAfterClear(const MunitParameter params[], void *data) {
+    intHashSet *set = NEW_HASH_SET(int, 16);
+    intHashSet *other = HASH_SET_OF(int, 64, 128, 999);
+    for (int i = 0; i < 16; i++) {
+        assert_true(intSetAdd(set, i * 32));
+    }
+    intSetRemove(set, 0);
+    intSetClear(set);
+    assert_true(isintSetEmpty(set));
+    assert_false(intSetContains(set, 32));
+
+    assert_true(intSetAdd(set, 64));
+    assert_true(intSetAdd(set, 128));
+    assert_true(intSetAdd(set, 256));
+    assert_false(intSetContainsAll(set, other));
+    assert_true(intSetRetainAll(set, other));   // walks slots written before clear
+    assert_uint32(set->size, ==, 2);
+    assert_false(intSetContains(set, 256));
+
+    intHashSet *result = NEW_HASH_SET(int, 16);
+    assert_true(intSetUnion(result, set, other));
+    assert_uint32(result->size, ==, 3);
+
+    uint32_t count = 0;
+    intSetIterator iterator = intSetIter(set);
+    while (intSetHasNext(&iterator)) {
+        count++;
+    }
+    assert_uint32(count, ==, 2);
+    return MUNIT_OK;
+}
 
 static MunitTest bufferHashSetTests[] = {
         {.name =  "Test new Set - should correctly create and init HashSet", .test = testBuffSetCreation},
@@ -155,7 +395,16 @@ static MunitTest bufferHashSetTests[] = {
         {.name =  "Test is<type>SetEmpty() - should correctly check set emptiness", .test = testBuffSetEmpty},
         {.name =  "Test <type>SetContains() - should correctly check that value in set", .test = testBuffSetContains},
         {.name =  "Test <type>SetContainsAll() - should correctly check that all values in set", .test = testBuffSetContainsAll},
+        {.name =  "Test <type>SetUnion() - should add values of both sets to result", .test = testBuffSetUnion},
+        {.name =  "Test <type>SetIntersect() - should add common values to result", .test = testBuffSetIntersect},
+        {.name =  "Test <type>SetSymmetricDifference() - should add values present in one set only", .test = testBuffSetSymmetricDifference},
+        {.name =  "Test <type>SetSubtract() - should remove values of other set", .test = testBuffSetSubtract},
+        {.name =  "Test <type>SetRetainAll() - should remove values missing in other set", .test = testBuffSetRetainAll},
         {.name =  "Test <type>SetIterator() - should correctly iterate set values", .test = testBuffSetIterator},
+        {.name =  "Test <type>SetCompact() - should purge tombstones in place", .test = testBuffSetCompact},
+        {.name =  "Test <type>SetGetStats() - should report probe lengths and occupancy", .test = testBuffSetStats},
+        {.name =  "Test <type>SetClear() - should reuse set after clear", .test = testBuffSetReuseAfterClear},
+        {.name =  "Test HashSet Algebra Load - should intersect small set with big one without sorting", .test = testBuffSetAlgebraLoad},
         END_OF_TESTS
 };
 
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "BufferPackedHashMap.h"
+
+
+CREATE_PACKED_HASH_MAP_TYPE(uint32_t, uint32_t, packed, packed);
+CREATE_PACKED_HASH_MAP_TYPE(char*, char*, packedStr, packedStr, strComparator, strHashCode);
+
+CREATE_PACKED_HASH_MAP_TYPE(uint32_t, uint32_t, packedClash, packedClash, uint32_tComparator, clusteredHashCode);
+
+
+static MunitResult testPackedMapCreation(const MunitParameter params[], void *data) {
+    packed_packedMap *map = NEW_PACKED_HASH_MAP(uint32_t, uint32_t, packed, packed, 4);
+    assert_uint32(map->size, ==, 0);
+    assert_uint32(map->capacity, ==, 8);
+    assert_uint8(map->states[0], ==, 0);
+    assert_uint8(map->states[1], ==, 0);
+    assert_uint32(NEW_PACKED_HASH_MAP_64(uint32_t, uint32_t, packed, packed)->capacity, ==, 128);
+
+    packedStr_packedStrMap *strMap = PACKED_HASH_MAP_OF(packedStr, packedStr, "k1", "v1", "k2", "v2", "k3", "v3");
+    assert_uint32(strMap->size, ==, 3);
+    assert_uint32(strMap->capacity, ==, 8);
+    assert_string_equal(packedStr_packedStrMapGet(strMap, "k2"), "v2");
+
+    packed_packedMap *ofMap = NEW_PACKED_HASH_MAP_OF(20, packed, packed, {1, 10}, {2, 20});
+    assert_uint32(ofMap->size, ==, 2);
+    assert_uint32(ofMap->capacity, ==, 64);
+    assert_uint32(packed_packedMapGet(ofMap, 2), ==, 20);
+    assert_uint32(packed_packedMapGetOrDefault(ofMap, 3, 30), ==, 30);
+    return MUNIT_OK;
+}
+
+static MunitResult testPackedMapAddGetRemove(const MunitParameter params[], void *data) {
+    packedClash_packedClashMap *map = NEW_PACKED_HASH_MAP(uint32_t, uint32_t, packedClash, packedClash, 32);
+    for (uint32_t i = 0; i < 32; i++) {
+        assert_true(packedClash_packedClashMapAdd(map, i, i == 1 ? 100 : i + 1));
+    }
+    assert_uint32(packedClash_packedClashMapGet(map, 1), ==, 100);
+    assert_false(packedClash_packedClashMapAdd(map, 100, 100));  // full
+    assert_false(packedClash_packedClashMapContains(map, 100));
+    packedClash_packedClashMapRemove(map, 1);
+    assert_false(packedClash_packedClashMapAdd(map, 3, 4));      // existing key, value replaced
+    assert_true(packedClash_packedClashMapAdd(map, 1, 2));
+
+    for (uint32_t i = 0; i < 32; i += 2) {
+        assert_uint32(packedClash_packedClashMapRemove(map, i), ==, i == 0 ? 1 : i + 1);
+        assert_uint32(packedClash_packedClashMapRemove(map, i), ==, 0);
+    }
+    assert_uint32(packedClash_packedClashMapSize(map), ==, 16);
+    assert_uint32(map->deletedItemsCount, ==, 16);
+    for (uint32_t i = 2; i < 32; i++) {
+        assert_uint32(packedClash_packedClashMapGet(map, i), ==, i % 2 == 1 ? i + 1 : 0);
+    }
+
+    packedClash_packedClashMapCompact(map);
+    assert_uint32(map->deletedItemsCount, ==, 0);
+    uint32_t usedSlots = 0;
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        uint8_t state = hashSlotState(map->states, i);
+        assert_true(state == HASH_SLOT_EMPTY || state == HASH_SLOT_USED);
+        usedSlots += state == HASH_SLOT_USED;
+    }
+    assert_uint32(usedSlots, ==, 16);
+    for (uint32_t i = 2; i < 32; i++) {
+        assert_uint32(packedClash_packedClashMapGet(map, i), ==, i % 2 == 1 ? i + 1 : 0);
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult testPackedMapIterAndClear(const MunitParameter params[], void *data) {
+    packed_packedMap *map = NEW_PACKED_HASH_MAP(uint32_t, uint32_t, packed, packed, 64);
+    for (uint32_t i = 0; i < 64; i++) {
+        packed_packedMapAdd(map, i, i + 1);
+    }
+
+    uint32_t count = 0;
+    packed_packedMapIterator iterator = packed_packedMapIter(map);
+    while (packed_packedMapHasNext(&iterator)) {
+        assert_uint32(iterator.value, ==, iterator.key + 1);
+        count++;
+    }
+    assert_uint32(count, ==, 64);
+
+    packed_packedMap *copy = NEW_PACKED_HASH_MAP(uint32_t, uint32_t, packed, packed, 64);
+    packed_packedMapAddAll(map, copy);
+    assert_uint32(packed_packedMapSize(copy), ==, 64);
+    assert_uint32(packed_packedMapGet(copy, 63), ==, 64);
+
+    packed_packedMapClear(map);
+    assert_true(is_packed_packedMapEmpty(map));
+    assert_false(packed_packedMapContains(map, 1));
+    iterator = packed_packedMapIter(map);
+    assert_false(packed_packedMapHasNext(&iterator));
+    return MUNIT_OK;
+}
+
+static MunitResult testPackedMapSlotStates(const MunitParameter params[], void *data) {
+    uint8_t states[HASH_SLOT_STATES_SIZE(6)] = {0};
+    assert_uint32(sizeof(states), ==, 2);   // four slots per byte
+    hashSlotSetState(states, 1, HASH_SLOT_USED);
+    hashSlotSetState(states, 2, HASH_SLOT_DELETED);
+    hashSlotSetState(states, 3, HASH_SLOT_MOVING);
+    hashSlotSetState(states, 4, HASH_SLOT_USED);
+    assert_uint8(states[0], ==, 0xE4);      // 0b11100100, slot 0 in the lowest bits
+    assert_uint8(states[1], ==, 0x01);
+    hashSlotSetState(states, 2, HASH_SLOT_EMPTY);   // neighbour slots keep their states
+    assert_uint8(states[0], ==, 0xC4);
+    assert_uint8(hashSlotState(states, 3), ==, HASH_SLOT_MOVING);
+    assert_uint8(hashSlotState(states, 5), ==, HASH_SLOT_EMPTY);
+
+    packed_packedMap *map = NEW_PACKED_HASH_MAP(uint32_t, uint32_t, packed, packed, 4);
+    for (uint32_t i = 0; i < 4; i++) {
+        packed_packedMapAdd(map, i, i + 1);
+    }
+    packed_packedMapRemove(map, 1);
+    packed_packedMapRemove(map, 2);
+    uint32_t stateCounts[4] = {0};
+    for (uint32_t i = 0; i < HASH_SLOT_STATES_SIZE(map->capacity); i++) {  // decode packed bytes directly
+        for (uint32_t shift = 0; shift < 8; shift += 2) {
+            stateCounts[(map->states[i] >> shift) & 0x03]++;
+        }
+    }
+    assert_uint32(stateCounts[HASH_SLOT_USED], ==, 2);
+    assert_uint32(stateCounts[HASH_SLOT_DELETED], ==, 2);
+    assert_uint32(stateCounts[HASH_SLOT_EMPTY], ==, map->capacity - 4);
+    assert_uint32(stateCounts[HASH_SLOT_MOVING], ==, 0);
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        if (hashSlotState(map->states, i) == HASH_SLOT_USED) {
+            assert_true(map->keys[i] == 0 || map->keys[i] == 3);
+            assert_uint32(map->values[i], ==, map->keys[i] + 1);   // value array is indexed by the same slot
+        }
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult testPackedMapChurn(const MunitParameter params[], void *data) {
+    packed_packedMap *map = NEW_PACKED_HASH_MAP(uint32_t, uint32_t, packed, packed, 1024);
+    for (uint32_t i = 0; i < 20000; i++) {   // tombstones are purged in place, so probes of missing keys still stop
+        assert_true(packed_packedMapAdd(map, i, i));
+        if (i >= 1000) {
+            assert_uint32(packed_packedMapRemove(map, i - 1000), ==, i - 1000);
+        }
+    }
+    assert_uint32(map->size, ==, 1000);
+    assert_uint32(map->deletedItemsCount, <=, HASH_MAP_TOMBSTONE_PURGE_THRESHOLD(map->capacity) + 1);
+    for (uint32_t i = 18000; i < 20000; i++) {
+        assert_uint32(packed_packedMapGet(map, i), ==, i >= 19000 ? i : 0);
+    }
+    return MUNIT_OK;
+}
+
+
+static MunitTest bufferPackedHashMapTests[] = {
+        {.name =  "Test new packed Map - should correctly create and init map", .test = testPackedMapCreation},
+        {.name =  "Test <key>_<value>MapAdd()/Get()/Remove() - should keep slot states in packed bits", .test = testPackedMapAddGetRemove},
+        {.name =  "Test <key>_<value>MapIter()/Clear() - should iterate and clear all keys", .test = testPackedMapIterAndClear},
+        {.name =  "Test packed slot states - should keep four 2-bit slot states per byte", .test = testPackedMapSlotStates},
+        {.name =  "Test <key>_<value>MapAdd()/Remove() churn - should purge tombstones in place", .test = testPackedMapChurn},
+        END_OF_TESTS
+};
+
+static const MunitSuite bufferPackedHashMapTestSuite = {
+        .prefix = "BufferPackedHashMap: ",
+        .tests = bufferPackedHashMapTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "BufferPackedHashSet.h"
+
+
+CREATE_PACKED_HASH_SET_TYPE(uint32_t, packedU32);
+CREATE_PACKED_HASH_SET_TYPE(char*, packedStr, strComparator, strHashCode);
+
+
+static MunitResult testPackedSetCreation(const MunitParameter params[], void *data) {
+    packedU32HashSet *set = NEW_PACKED_HASH_SET(packedU32, 4);
+    assert_uint32(set->size, ==, 0);
+    assert_uint32(set->capacity, ==, 8);
+    assert_uint32(NEW_PACKED_HASH_SET_64(packedU32)->capacity, ==, 128);
+
+    packedStrHashSet *strSet = PACKED_HASH_SET_OF(packedStr, "a", "b", "c", "a");
+    assert_uint32(strSet->size, ==, 3);
+    assert_true(packedStrSetContains(strSet, "b"));
+    assert_false(packedStrSetContains(strSet, "d"));
+
+    set = NEW_PACKED_HASH_SET_OF(20, packedU32, 1, 2, 3);
+    assert_uint32(set->size, ==, 3);
+    assert_uint32(set->capacity, ==, 64);
+    return MUNIT_OK;
+}
+
+static MunitResult testPackedSetAddRemove(const MunitParameter params[], void *data) {
+    packedU32HashSet *set = NEW_PACKED_HASH_SET(packedU32, 32);
+    for (uint32_t i = 0; i < 31; i++) {
+        assert_true(packedU32SetAdd(set, i * 64));
+    }
+    assert_false(packedU32SetAdd(set, 0));
+    for (uint32_t i = 0; i < 31; i += 2) {
+        assert_true(packedU32SetRemove(set, i * 64));
+        assert_false(packedU32SetRemove(set, i * 64));
+    }
+    assert_uint32(set->deletedItemsCount, ==, 16);
+
+    packedU32SetCompact(set);
+    assert_uint32(set->deletedItemsCount, ==, 0);
+    assert_uint32(set->size, ==, 15);
+    for (uint32_t i = 0; i < 31; i++) {
+        assert_true(packedU32SetContains(set, i * 64) == (i % 2 == 1));
+    }
+
+    for (uint32_t i = 0; i < 100000; i++) {  // add/remove churn purges tombstones on add
+        assert_true(packedU32SetAdd(set, 10000 + i));
+        assert_true(packedU32SetRemove(set, 10000 + i));
+        assert_false(packedU32SetContains(set, 5));
+    }
+    assert_uint32(set->size, ==, 15);
+    return MUNIT_OK;
+}
+
+static MunitResult testPackedSetIterAndContainsAll(const MunitParameter params[], void *data) {
+    packedU32HashSet *set = NEW_PACKED_HASH_SET(packedU32, 16);
+    for (uint32_t i = 0; i < 16; i++) {
+        packedU32SetAdd(set, i);
+    }
+    uint32_t sum = 0;
+    packedU32SetIterator iterator = packedU32SetIter(set);
+    while (packedU32SetHasNext(&iterator)) {
+        sum += iterator.value;
+    }
+    assert_uint32(sum, ==, 120);
+
+    packedU32HashSet *copy = NEW_PACKED_HASH_SET(packedU32, 16);
+    packedU32SetAddAll(set, copy);
+    assert_true(packedU32SetContainsAll(copy, set));
+    packedU32SetRemove(copy, 7);
+    assert_false(packedU32SetContainsAll(copy, set));
+    assert_true(packedU32SetContainsAll(set, copy));
+
+    packedU32SetClear(set);
+    assert_true(ispackedU32SetEmpty(set));
+    iterator = packedU32SetIter(set);
+    assert_false(packedU32SetHasNext(&iterator));
+    return MUNIT_OK;
+}
+
+
+static MunitTest bufferPackedHashSetTests[] = {
+        {.name =  "Test new packed Set - should correctly create and init set", .test = testPackedSetCreation},
+        {.name =  "Test <type>SetAdd()/Remove()/Compact() - should keep slot states in packed bits", .test = testPackedSetAddRemove},
+        {.name =  "Test <type>SetIter()/ContainsAll() - should iterate all values", .test = testPackedSetIterAndContainsAll},
+        END_OF_TESTS
+};
+
+static const MunitSuite bufferPackedHashSetTestSuite = {
+        .prefix = "BufferPackedHashSet: ",
+        .tests = bufferPackedHashSetTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
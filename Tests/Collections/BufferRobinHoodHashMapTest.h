@@ -0,0 +1,162 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "BufferRobinHoodHashMap.h"
+
+
+CREATE_ROBIN_HOOD_HASH_MAP_TYPE(uint32_t, uint32_t, rhU32, rhU32);
+CREATE_ROBIN_HOOD_HASH_MAP_TYPE(char*, char*, rhStr, rhStr, strComparator, strHashCode);
+
+CREATE_ROBIN_HOOD_HASH_MAP_TYPE(uint32_t, uint32_t, rhClash, rhClash, uint32_tComparator, clusteredHashCode);
+
+
+static MunitResult testRobinHoodMapCreation(const MunitParameter params[], void *data) {
+    rhU32_rhU32Map *map = NEW_HASH_MAP(uint32_t, uint32_t, rhU32, rhU32, 4);
+    assert_uint32(map->size, ==, 0);
+    assert_uint32(map->capacity, ==, 8);
+    assert_uint32(map->entries[0].probeLength, ==, 0);
+
+    rhStr_rhStrMap *strMap = HASH_MAP_OF(rhStr, rhStr, "k1", "v1", "k2", "v2", "k3", "v3");
+    assert_uint32(strMap->size, ==, 3);
+    assert_uint32(strMap->capacity, ==, 8);
+    assert_string_equal(rhStr_rhStrMapGet(strMap, "k2"), "v2");
+
+    rhU32_rhU32Map *ofMap = NEW_HASH_MAP_OF(20, rhU32, rhU32, {1, 10}, {2, 20});
+    assert_uint32(ofMap->size, ==, 2);
+    assert_uint32(ofMap->capacity, ==, 64);
+    assert_uint32(rhU32_rhU32MapGet(ofMap, 2), ==, 20);
+    return MUNIT_OK;
+}
+
+static MunitResult testRobinHoodMapAddGetRemove(const MunitParameter params[], void *data) {
+    rhU32_rhU32Map *map = NEW_HASH_MAP(uint32_t, uint32_t, rhU32, rhU32, 8);
+    for (uint32_t i = 0; i < 8; i++) {
+        assert_true(rhU32_rhU32MapAdd(map, i * 16, i));
+    }
+    assert_false(rhU32_rhU32MapAdd(map, 1000, 1000));    // full
+    assert_false(rhU32_rhU32MapAdd(map, 0, 100));        // full, existing key not replaced as in default layout
+    assert_uint32(rhU32_rhU32MapSize(map), ==, 8);
+
+    for (uint32_t i = 0; i < 8; i++) {
+        assert_true(rhU32_rhU32MapContains(map, i * 16));
+        assert_uint32(rhU32_rhU32MapGet(map, i * 16), ==, i);
+    }
+    assert_false(rhU32_rhU32MapContains(map, 1000));
+    assert_uint32(rhU32_rhU32MapGetOrDefault(map, 1000, 7), ==, 7);
+
+    assert_uint32(rhU32_rhU32MapRemove(map, 48), ==, 3);
+    assert_uint32(rhU32_rhU32MapRemove(map, 48), ==, 0);
+    assert_false(rhU32_rhU32MapContains(map, 48));
+    assert_uint32(rhU32_rhU32MapSize(map), ==, 7);
+
+    assert_true(rhU32_rhU32MapAdd(map, 1000, 1000));
+    assert_uint32(rhU32_rhU32MapGet(map, 1000), ==, 1000);
+    assert_uint32(map->deletedItemsCount, ==, 0);
+    return MUNIT_OK;
+}
+
+static MunitResult testRobinHoodMapBackwardShift(const MunitParameter params[], void *data) {
+    rhClash_rhClashMap *map = NEW_HASH_MAP(uint32_t, uint32_t, rhClash, rhClash, 32);
+    for (uint32_t i = 0; i < 32; i++) {
+        assert_true(rhClash_rhClashMapAdd(map, i, i + 1));
+    }
+
+    uint32_t totalProbeLength = 0;
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        totalProbeLength += map->entries[i].probeLength;
+    }
+
+    for (uint32_t i = 0; i < 32; i += 2) {  // removal shifts cluster back, rest keys must stay reachable
+        assert_uint32(rhClash_rhClashMapRemove(map, i), ==, i + 1);
+    }
+    for (uint32_t i = 1; i < 32; i += 2) {
+        assert_uint32(rhClash_rhClashMapGet(map, i), ==, i + 1);
+    }
+
+    uint32_t usedSlots = 0;
+    uint32_t shiftedProbeLength = 0;
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        if (map->entries[i].probeLength != 0) {
+            shiftedProbeLength += map->entries[i].probeLength;
+            usedSlots++;
+        }
+    }
+    assert_uint32(usedSlots, ==, 16);
+    assert_uint32(shiftedProbeLength, <, totalProbeLength);   // clusters are shorter now
+
+    for (uint32_t i = 0; i < 32; i += 2) {
+        assert_false(rhClash_rhClashMapContains(map, i));
+        assert_true(rhClash_rhClashMapAdd(map, i, i + 1));
+    }
+    assert_uint32(rhClash_rhClashMapSize(map), ==, 32);
+    return MUNIT_OK;
+}
+
+static MunitResult testRobinHoodMapIterAndRemove(const MunitParameter params[], void *data) {
+    rhClash_rhClashMap *map = NEW_HASH_MAP(uint32_t, uint32_t, rhClash, rhClash, 64);
+    for (uint32_t i = 0; i < 64; i++) {
+        rhClash_rhClashMapAdd(map, i, i + 1);
+    }
+
+    rhClash_rhClashMap *copy = NEW_HASH_MAP(uint32_t, uint32_t, rhClash, rhClash, 64);
+    rhClash_rhClashMapAddAll(map, copy);
+    assert_uint32(rhClash_rhClashMapSize(copy), ==, 64);
+
+    uint32_t count = 0;
+    rhClash_rhClashMapIterator iterator = rhClash_rhClashMapIter(map);
+    while (rhClash_rhClashMapHasNext(&iterator)) {  // removal of current key shifts next entries back, none of them should be missed
+        assert_uint32(iterator.value, ==, iterator.key + 1);
+        assert_uint32(rhClash_rhClashMapRemove(map, iterator.key), ==, iterator.key + 1);
+        count++;
+    }
+    assert_uint32(count, ==, 64);
+    assert_true(is_rhClash_rhClashMapEmpty(map));
+
+    rhClash_rhClashMapClear(copy);
+    assert_true(is_rhClash_rhClashMapEmpty(copy));
+    assert_false(rhClash_rhClashMapContains(copy, 1));
+    iterator = rhClash_rhClashMapIter(copy);
+    assert_false(rhClash_rhClashMapHasNext(&iterator));
+    return MUNIT_OK;
+}
+
+static MunitResult testRobinHoodMapLoad(const MunitParameter params[], void *data) {
+    rhU32_rhU32Map *map = NEW_HASH_MAP(uint32_t, uint32_t, rhU32, rhU32, 8192);
+    for (uint32_t i = 0; i < 8192; i++) {
+        assert_true(rhU32_rhU32MapAdd(map, i * 16, i));
+    }
+
+    for (uint32_t round = 0; round < 100; round++) {     // long-lived table with constant insert/remove traffic
+        for (uint32_t i = round; i < 8192; i += 25) {
+            assert_uint32(rhU32_rhU32MapRemove(map, i * 16), ==, i);
+            assert_true(rhU32_rhU32MapAdd(map, (i + 8192 * (round + 1)) * 16, i));
+        }
+        for (uint32_t i = round; i < 8192; i += 25) {
+            assert_uint32(rhU32_rhU32MapRemove(map, (i + 8192 * (round + 1)) * 16), ==, i);
+            assert_true(rhU32_rhU32MapAdd(map, i * 16, i));
+        }
+        for (uint32_t i = 0; i < 8192; i++) {
+            assert_uint32(rhU32_rhU32MapGet(map, i * 16), ==, i);
+        }
+    }
+    assert_uint32(rhU32_rhU32MapSize(map), ==, 8192);
+    return MUNIT_OK;
+}
+
+
+static MunitTest bufferRobinHoodHashMapTests[] = {
+        {.name =  "Test new Robin Hood Map - should correctly create and init map", .test = testRobinHoodMapCreation},
+        {.name =  "Test <key>_<value>MapAdd()/Get()/Remove() - should correctly handle elements", .test = testRobinHoodMapAddGetRemove},
+        {.name =  "Test <key>_<value>MapRemove() - should shift cluster back without tombstones", .test = testRobinHoodMapBackwardShift},
+        {.name =  "Test <key>_<value>MapIter() - should remove all keys while iterating", .test = testRobinHoodMapIterAndRemove},
+        {.name =  "Test Robin Hood map Load - should keep working under insert/remove churn", .test = testRobinHoodMapLoad},
+        END_OF_TESTS
+};
+
+static const MunitSuite bufferRobinHoodHashMapTestSuite = {
+        .prefix = "BufferRobinHoodHashMap: ",
+        .tests = bufferRobinHoodHashMapTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "BufferRobinHoodHashSet.h"
+
+
+CREATE_ROBIN_HOOD_HASH_SET_TYPE(uint32_t, rhU32);
+CREATE_ROBIN_HOOD_HASH_SET_TYPE(char*, rhStr, strComparator, strHashCode);
+
+CREATE_ROBIN_HOOD_HASH_SET_TYPE(uint32_t, rhClash, uint32_tComparator, clusteredHashCode);
+
+
+static MunitResult testRobinHoodSetCreation(const MunitParameter params[], void *data) {
+    rhU32HashSet *set = NEW_HASH_SET(rhU32, 4);
+    assert_uint32(set->size, ==, 0);
+    assert_uint32(set->capacity, ==, 8);
+
+    rhStrHashSet *strSet = HASH_SET_OF(rhStr, "v1", "v2", "v3");
+    assert_uint32(strSet->size, ==, 3);
+    assert_uint32(strSet->capacity, ==, 8);
+    assert_true(rhStrSetContains(strSet, "v2"));
+
+    rhU32HashSet *ofSet = NEW_HASH_SET_OF(6, rhU32, { 1 }, { 2 }, { 3 });
+    assert_uint32(ofSet->size, ==, 3);
+    assert_uint32(ofSet->capacity, ==, 16);
+    return MUNIT_OK;
+}
+
+static MunitResult testRobinHoodSetAddRemove(const MunitParameter params[], void *data) {
+    rhClashHashSet *set = NEW_HASH_SET(rhClash, 32);
+    for (uint32_t i = 0; i < 32; i++) {
+        assert_true(rhClashSetAdd(set, i));
+    }
+    assert_false(rhClashSetAdd(set, 100));  // full
+    assert_false(rhClashSetAdd(set, 5));
+
+    for (uint32_t i = 0; i < 32; i += 2) {  // removal shifts cluster back, rest values must stay reachable
+        assert_true(rhClashSetRemove(set, i));
+        assert_false(rhClashSetRemove(set, i));
+    }
+    for (uint32_t i = 0; i < 32; i++) {
+        assert_true(rhClashSetContains(set, i) == (i % 2 == 1));
+    }
+    assert_uint32(rhClashSetSize(set), ==, 16);
+    assert_uint32(set->deletedItemsCount, ==, 0);
+
+    rhClashHashSet *copy = NEW_HASH_SET(rhClash, 32);
+    rhClashSetAddAll(set, copy);
+    assert_true(rhClashSetContainsAll(copy, set));
+    assert_true(rhClashSetContainsAll(set, copy));
+
+    rhClashSetClear(copy);
+    assert_true(isrhClashSetEmpty(copy));
+    assert_false(rhClashSetContains(copy, 1));
+    return MUNIT_OK;
+}
+
+static MunitResult testRobinHoodSetIterAndRemove(const MunitParameter params[], void *data) {
+    rhClashHashSet *set = NEW_HASH_SET(rhClash, 64);
+    for (uint32_t i = 0; i < 64; i++) {
+        rhClashSetAdd(set, i);
+    }
+
+    uint32_t count = 0;
+    rhClashSetIterator iterator = rhClashSetIter(set);
+    while (rhClashSetHasNext(&iterator)) {  // removal of current value shifts next entries back, none of them should be missed
+        assert_true(rhClashSetRemove(set, iterator.value));
+        count++;
+    }
+    assert_uint32(count, ==, 64);
+    assert_true(isrhClashSetEmpty(set));
+
+    iterator = rhClashSetIter(set);
+    assert_false(rhClashSetHasNext(&iterator));
+    return MUNIT_OK;
+}
+
+static MunitResult testRobinHoodSetLoad(const MunitParameter params[], void *data) {
+    rhU32HashSet *set = NEW_HASH_SET(rhU32, 8192);
+    for (uint32_t i = 0; i < 8192; i++) {
+        assert_true(rhU32SetAdd(set, i * 16));
+    }
+
+    for (uint32_t round = 0; round < 100; round++) {     // constant insert/remove traffic
+        for (uint32_t i = round; i < 8192; i += 25) {
+            assert_true(rhU32SetRemove(set, i * 16));
+            assert_true(rhU32SetAdd(set, (i + 8192 * (round + 1)) * 16));
+        }
+        for (uint32_t i = round; i < 8192; i += 25) {
+            assert_true(rhU32SetRemove(set, (i + 8192 * (round + 1)) * 16));
+            assert_true(rhU32SetAdd(set, i * 16));
+        }
+        for (uint32_t i = 0; i < 8192; i++) {
+            assert_true(rhU32SetContains(set, i * 16));
+        }
+    }
+    assert_uint32(rhU32SetSize(set), ==, 8192);
+    return MUNIT_OK;
+}
+
+
+static MunitTest bufferRobinHoodHashSetTests[] = {
+        {.name =  "Test new Robin Hood Set - should correctly create and init set", .test = testRobinHoodSetCreation},
+        {.name =  "Test <name>SetAdd()/Remove() - should shift cluster back without tombstones", .test = testRobinHoodSetAddRemove},
+        {.name =  "Test <name>SetIter() - should remove all values while iterating", .test = testRobinHoodSetIterAndRemove},
+        {.name =  "Test Robin Hood set Load - should keep working under insert/remove churn", .test = testRobinHoodSetLoad},
+        END_OF_TESTS
+};
+
+static const MunitSuite bufferRobinHoodHashSetTestSuite = {
+        .prefix = "BufferRobinHoodHashSet: ",
+        .tests = bufferRobinHoodHashSetTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
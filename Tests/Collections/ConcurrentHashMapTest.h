@@ -0,0 +1,182 @@
+#pragma once
+
+#include <stdio.h>
+#include "BaseTestTemplate.h"
+#include "ConcurrentHashMap.h"
+
+#define CONCURRENT_MAP_THREAD_COUNT 4
+#define CONCURRENT_MAP_KEY_COUNT 4096
+#define CONCURRENT_MAP_COUNTER_INCREMENTS 20000
+
+typedef struct ConcurrentMapWorker {
+    ConcurrentHashMap map;
+    uint32_t id;
+    uint32_t foundCount;
+} ConcurrentMapWorker;
+
+static char concurrentMapKeys[CONCURRENT_MAP_KEY_COUNT][16];
+
+
+static void fillConcurrentMapKeys() {
+    for (uint32_t i = 0; i < CONCURRENT_MAP_KEY_COUNT; i++) {
+        sprintf(concurrentMapKeys[i], "session:%u", i);
+    }
+}
+
+static MapValueType incrementCounter(const char *key, MapValueType value, void *context) {
+    return (MapValueType) ((uintptr_t) value + (uintptr_t) context);
+}
+
+static MapValueType removeCounter(const char *key, MapValueType value, void *context) {
+    return NULL;
+}
+
+static void *runCounterWorker(void *data) {
+    ConcurrentMapWorker *worker = data;
+    for (uint32_t i = 0; i < CONCURRENT_MAP_COUNTER_INCREMENTS; i++) {
+        concurrentHashMapCompute(worker->map, concurrentMapKeys[i % 64], incrementCounter, (void *) 1);   // shared keys
+        if (i % 8 == 0) {   // own keys, put and remove by this worker only
+            const char *ownKey = concurrentMapKeys[64 + worker->id * 1000 + (i / 8) % 1000];
+            concurrentHashMapPut(worker->map, ownKey, (MapValueType) (uintptr_t) (worker->id + 1));
+            worker->foundCount += concurrentHashMapGet(worker->map, ownKey) == (MapValueType) (uintptr_t) (worker->id + 1);
+        }
+    }
+    return NULL;
+}
+
+static uint32_t runConcurrentMapWorkers(ConcurrentMapWorker *workers, void *(*function)(void *)) {
+    pthread_t threads[CONCURRENT_MAP_THREAD_COUNT];
+    for (uint32_t i = 0; i < CONCURRENT_MAP_THREAD_COUNT; i++) {
+        assert_int(pthread_create(&threads[i], NULL, function, &workers[i]), ==, 0);
+    }
+    uint32_t foundCount = 0;
+    for (uint32_t i = 0; i < CONCURRENT_MAP_THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+        foundCount += workers[i].foundCount;
+    }
+    return foundCount;
+}
+
+static MunitResult testConcurrentMapCreation(const MunitParameter params[], void *data) {
+    ConcurrentHashMap map = getConcurrentHashMapInstance(64, 0);
+    assert_not_null(map);
+    assert_uint32(map->shardCount, ==, CONCURRENT_HASH_MAP_SHARD_COUNT);
+    assert_true(isConcurrentHashMapEmpty(map));
+    concurrentHashMapDelete(map);
+
+    map = getConcurrentHashMapInstance(0, 5);   // rounded up to power of two
+    assert_uint32(map->shardCount, ==, 8);
+    assert_true(concurrentHashMapPut(map, "key", (MapValueType) 1));
+    assert_uint32(getConcurrentHashMapSize(map), ==, 1);
+    concurrentHashMapDelete(map);
+
+    map = getConcurrentHashMapInstance(8, 1);
+    assert_uint32(map->shardCount, ==, 1);
+    assert_true(concurrentHashMapPut(map, "key", (MapValueType) 1));
+    assert_int((int) (uintptr_t) concurrentHashMapGet(map, "key"), ==, 1);
+    concurrentHashMapDelete(map);
+
+    assert_false(concurrentHashMapPut(NULL, "key", (MapValueType) 1));
+    assert_null(concurrentHashMapGet(NULL, "key"));
+    assert_uint32(getConcurrentHashMapSize(NULL), ==, 0);
+    concurrentHashMapDelete(NULL);
+    return MUNIT_OK;
+}
+
+static MunitResult testConcurrentMapPutGetRemove(const MunitParameter params[], void *data) {
+    fillConcurrentMapKeys();
+    ConcurrentHashMap map = getConcurrentHashMapInstance(16, 4);
+    for (uint32_t i = 0; i < 1000; i++) {
+        assert_true(concurrentHashMapPut(map, concurrentMapKeys[i], (MapValueType) (uintptr_t) (i + 1)));
+    }
+    assert_uint32(getConcurrentHashMapSize(map), ==, 1000);
+    for (uint32_t i = 0; i < map->shardCount; i++) {    // keys are spread over all shards
+        assert_uint32(getHashMapSize(map->shards[i].hashMap), >, 150);
+    }
+    for (uint32_t i = 0; i < 1000; i++) {
+        assert_int((int) (uintptr_t) concurrentHashMapGet(map, concurrentMapKeys[i]), ==, i + 1);
+    }
+    assert_null(concurrentHashMapGet(map, concurrentMapKeys[1000]));
+    assert_true(isConcurrentHashMapContainsKey(map, "session:5"));
+    assert_false(isConcurrentHashMapContainsKey(map, "session:1000"));
+    assert_int((int) (uintptr_t) concurrentHashMapGetN(map, "session:77xyz", 10), ==, 78);
+
+    assert_int((int) (uintptr_t) concurrentHashMapRemove(map, "session:5"), ==, 6);
+    assert_null(concurrentHashMapRemove(map, "session:5"));
+    assert_false(isConcurrentHashMapContainsKey(map, "session:5"));
+    assert_uint32(getConcurrentHashMapSize(map), ==, 999);
+    assert_true(concurrentHashMapPut(map, "session:5", NULL));
+    assert_true(isConcurrentHashMapContainsKey(map, "session:5"));     // key with NULL value is found by entry
+    concurrentHashMapRemove(map, "session:5");
+
+    concurrentHashMapClear(map);
+    assert_true(isConcurrentHashMapEmpty(map));
+    assert_null(concurrentHashMapGet(map, "session:6"));
+    concurrentHashMapDelete(map);
+    return MUNIT_OK;
+}
+
+static MunitResult testConcurrentMapOwnedKeys(const MunitParameter params[], void *data) {
+    ConcurrentHashMap map = getKeyOwningConcurrentHashMapInstance(16, 2);
+    char key[16];
+    for (uint32_t i = 0; i < 100; i++) {
+        sprintf(key, "user:%u", i); // buffer reused right after put
+        assert_true(concurrentHashMapPut(map, key, (MapValueType) (uintptr_t) (i + 1)));
+    }
+    assert_int((int) (uintptr_t) concurrentHashMapGet(map, "user:42"), ==, 43);
+    assert_uint32(getConcurrentHashMapSize(map), ==, 100);
+    concurrentHashMapDelete(map);
+    return MUNIT_OK;
+}
+
+static MunitResult testConcurrentMapCompute(const MunitParameter params[], void *data) {
+    ConcurrentHashMap map = getKeyOwningConcurrentHashMapInstance(16, 4);
+    assert_int((int) (uintptr_t) concurrentHashMapCompute(map, "hits", incrementCounter, (void *) 5), ==, 5);
+    assert_int((int) (uintptr_t) concurrentHashMapCompute(map, "hits", incrementCounter, (void *) 2), ==, 7);
+    assert_uint32(getConcurrentHashMapSize(map), ==, 1);
+    assert_null(concurrentHashMapCompute(map, "hits", removeCounter, NULL));
+    assert_false(isConcurrentHashMapContainsKey(map, "hits"));
+    assert_null(concurrentHashMapCompute(map, "absent", removeCounter, NULL));
+    assert_true(isConcurrentHashMapEmpty(map));
+    assert_null(concurrentHashMapCompute(map, "hits", NULL, NULL));
+    concurrentHashMapDelete(map);
+    return MUNIT_OK;
+}
+
+static MunitResult testConcurrentMapThreads(const MunitParameter params[], void *data) {
+    fillConcurrentMapKeys();
+    ConcurrentHashMap map = getConcurrentHashMapInstance(64, 8);
+    ConcurrentMapWorker workers[CONCURRENT_MAP_THREAD_COUNT] = {0};
+    for (uint32_t i = 0; i < CONCURRENT_MAP_THREAD_COUNT; i++) {
+        workers[i] = (ConcurrentMapWorker) {.map = map, .id = i};
+    }
+    uint32_t foundCount = runConcurrentMapWorkers(workers, runCounterWorker);
+    assert_uint32(foundCount, ==, CONCURRENT_MAP_THREAD_COUNT * CONCURRENT_MAP_COUNTER_INCREMENTS / 8);
+
+    uintptr_t total = 0;
+    for (uint32_t i = 0; i < 64; i++) {
+        total += (uintptr_t) concurrentHashMapGet(map, concurrentMapKeys[i]);
+    }
+    assert_uint64(total, ==, CONCURRENT_MAP_THREAD_COUNT * CONCURRENT_MAP_COUNTER_INCREMENTS);   // no lost increments
+    assert_uint32(getConcurrentHashMapSize(map), ==, 64 + CONCURRENT_MAP_THREAD_COUNT * 1000);
+    concurrentHashMapDelete(map);
+    return MUNIT_OK;
+}
+
+
+static MunitTest concurrentHashMapTests[] = {
+        {.name =  "Test new ConcurrentHashMap - should create power of two shards", .test = testConcurrentMapCreation},
+        {.name =  "Test concurrentHashMapPut()/Get()/Remove() - should spread keys over shards", .test = testConcurrentMapPutGetRemove},
+        {.name =  "Test key owning ConcurrentHashMap - should copy keys", .test = testConcurrentMapOwnedKeys},
+        {.name =  "Test concurrentHashMapCompute() - should remap, add and remove values", .test = testConcurrentMapCompute},
+        {.name =  "Test ConcurrentHashMap threads - should not lose updates of shared keys", .test = testConcurrentMapThreads},
+        END_OF_TESTS
+};
+
+static const MunitSuite concurrentHashMapTestSuite = {
+        .prefix = "ConcurrentHashMap: ",
+        .tests = concurrentHashMapTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "Comparator.h"
+#include "BufferHashMap.h"
+
+#define HASH_CODE_BENCH_KEYS 256
+#define HASH_CODE_BENCH_ROUNDS 4000
+#define STRIDED_KEYS_COUNT 2048
+#define STRIDED_KEYS_ROUNDS 20
+
+static uint32_t identityHashCode(uint32_t value) {
+    return value;
+}
+
+CREATE_HASH_MAP_TYPE(uint32_t, uint32_t, strideId, strideId, uint32_tComparator, identityHashCode);
+CREATE_HASH_MAP_TYPE(uint32_t, uint32_t, strideMix, strideMix, uint32_tComparator, hashMix32);
+
+
+static void fillHashCodeKey(char *buffer, uint32_t length, uint32_t seed) {
+    for (uint32_t i = 0; i < length; i++) {
+        buffer[i] = (char) ('a' + (seed * 31 + i * 7) % 26);
+    }
+    buffer[length] = '\0';
+}
+
+static uint32_t benchHashCode(uint32_t (*hashCode)(const char *, uint32_t), uint32_t length) {
+    static char keys[HASH_CODE_BENCH_KEYS][256];
+    for (uint32_t i = 0; i < HASH_CODE_BENCH_KEYS; i++) {
+        fillHashCodeKey(keys[i], length, i);
+    }
+
+    uint32_t result = 0;
+    for (uint32_t round = 0; round < HASH_CODE_BENCH_ROUNDS; round++) {
+        for (uint32_t i = 0; i < HASH_CODE_BENCH_KEYS; i++) {
+            result += hashCode(keys[i], length);
+        }
+    }
+    return result;
+}
+
+static uint32_t countHashBuckets(const uint32_t *hashes, uint32_t count) {
+    static uint8_t buckets[4096];
+    memset(buckets, 0, sizeof(buckets));
+    uint32_t usedBuckets = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (buckets[hashes[i] & 4095]++ == 0) {
+            usedBuckets++;
+        }
+    }
+    return usedBuckets;
+}
+
+static MunitResult testStrHashCodeN(const MunitParameter params[], void *data) {
+    char buffer[64] = "some key";
+    assert_uint32(strHashCode(buffer), ==, strHashCodeN(buffer, strlen(buffer)));
+    assert_uint32(strHashCode(""), ==, strHashCodeN("", 0));
+    assert_uint32(strHashCodeN("key:value", 3), ==, strHashCode("key"));  // no NUL terminator required
+
+    for (uint32_t length = 0; length < 64; length++) {    // every tail branch: 0, 1..3, 4..16, 17..48, 48+
+        fillHashCodeKey(buffer, length, length);
+        assert_uint32(wyHashCode(buffer, length), ==, wyHashCode(buffer, length));
+        if (length > 0) {
+            buffer[length - 1]++;   // last byte should affect hash
+            uint32_t changedHash = wyHashCode(buffer, length);
+            buffer[length - 1]--;
+            assert_uint32(changedHash, !=, wyHashCode(buffer, length));
+        }
+    }
+    assert_uint32(fnv1aHashCode("a", 1), ==, 0xE40C292C);
+    return MUNIT_OK;
+}
+
+static MunitResult testWyHashCodeDistribution(const MunitParameter params[], void *data) {
+    static uint8_t buckets[4096];
+    memset(buckets, 0, sizeof(buckets));
+    char buffer[32];
+
+    uint32_t usedBuckets = 0;
+    for (uint32_t i = 0; i < 4096; i++) {   // sequential numeric keys differ in a few bytes only
+        sprintf(buffer, "key_%05u", (unsigned) i);
+        uint32_t index = wyHashCode(buffer, strlen(buffer)) & 4095;
+        if (buckets[index]++ == 0) {
+            usedBuckets++;
+        }
+    }
+    assert_uint32(usedBuckets, >, 2400);    // random hash fills ~63% of buckets
+    return MUNIT_OK;
+}
+
+static MunitResult testNumberHashCode(const MunitParameter params[], void *data) {
+    static uint32_t hashes[1000];
+    for (uint32_t i = 0; i < 1000; i++) {    // truncated to integer all of them were 0
+        hashes[i] = floatHashCode((float) i / 1000.0f);
+    }
+    assert_uint32(countHashBuckets(hashes, 1000), >, 800);  // random hash fills ~88% of buckets
+    for (uint32_t i = 0; i < 1000; i++) {
+        hashes[i] = doubleHashCode((double) i / 1000.0);
+    }
+    assert_uint32(countHashBuckets(hashes, 1000), >, 800);
+    for (uint32_t i = 0; i < 1000; i++) {    // round values have zero low mantissa bits
+        hashes[i] = doubleHashCode((double) i);
+    }
+    assert_uint32(countHashBuckets(hashes, 1000), >, 800);
+
+    assert_uint32(floatHashCode(-0.0f), ==, floatHashCode(0.0f));
+    assert_uint32(doubleHashCode(-0.0), ==, doubleHashCode(0.0));
+    assert_uint32(floatHashCode(0.5f), !=, floatHashCode(-0.5f));
+    assert_uint32(doubleHashCode(1.5), !=, doubleHashCode(1.0));
+
+    for (uint32_t i = 0; i < 1000; i++) {    // page addresses
+        hashes[i] = hashMix32(i * 4096);
+    }
+    assert_uint32(countHashBuckets(hashes, 1000), >, 800);
+#if INT_HASH_ALGORITHM == INT_HASH_MURMUR3
+    assert_uint32(uint32_tHashCode(4096), ==, hashMix32(4096));
+    assert_uint32(int64_tHashCode(1ll << 40), !=, int64_tHashCode(1ll << 41));
+#else
+    assert_uint32(uint32_tHashCode(4096), ==, 4096);
+#endif
+    return MUNIT_OK;
+}
+
+static uint32_t stridedKeysLookup(uint32_t stride, bool isMixed) {
+    strideId_strideIdMap *identityMap = NEW_HASH_MAP(uint32_t, uint32_t, strideId, strideId, STRIDED_KEYS_COUNT);
+    strideMix_strideMixMap *mixedMap = NEW_HASH_MAP(uint32_t, uint32_t, strideMix, strideMix, STRIDED_KEYS_COUNT);
+    uint32_t maxProbeLength = 0;
+    for (uint32_t i = 0; i < STRIDED_KEYS_COUNT - 1; i++) {
+        if (isMixed) {
+            assert_true(strideMix_strideMixMapAdd(mixedMap, i * stride, i));
+        } else {
+            assert_true(strideId_strideIdMapAdd(identityMap, i * stride, i));
+        }
+    }
+    for (uint32_t i = 0; isMixed && i < mixedMap->capacity; i++) {
+        if (!mixedMap->entries[i].isEmptySlot) {
+            uint32_t probeLength = (i - strideMix_strideMixMapHomeIndex(mixedMap, mixedMap->entries[i].key)) & (mixedMap->capacity - 1);
+            maxProbeLength = probeLength > maxProbeLength ? probeLength : maxProbeLength;
+        }
+    }
+
+    for (uint32_t round = 0; round < STRIDED_KEYS_ROUNDS; round++) {
+        for (uint32_t i = 0; i < STRIDED_KEYS_COUNT - 1; i++) {
+            uint32_t value = isMixed ? strideMix_strideMixMapGet(mixedMap, i * stride) : strideId_strideIdMapGet(identityMap, i * stride);
+            assert_uint32(value, ==, i);
+        }
+    }
+    return maxProbeLength;
+}
+
+static MunitResult testIdentityStridedKeysLoad(const MunitParameter params[], void *data) {
+    stridedKeysLookup(4096, false);    // without seed every key has home slot 0
+    stridedKeysLookup(16, false);
+    return MUNIT_OK;
+}
+
+static MunitResult testMixedStridedKeysLoad(const MunitParameter params[], void *data) {
+    assert_uint32(stridedKeysLookup(4096, true), <, 64);
+    assert_uint32(stridedKeysLookup(16, true), <, 64);
+    return MUNIT_OK;
+}
+
+static MunitResult testFnv1aHashCodeLoad(const MunitParameter params[], void *data) {
+    uint32_t lengths[] = {8, 16, 40, 100, 200};
+    for (uint32_t i = 0; i < ARRAY_SIZE(lengths); i++) {
+        assert_uint32(benchHashCode(fnv1aHashCode, lengths[i]), !=, 0);
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult testWyHashCodeLoad(const MunitParameter params[], void *data) {
+    uint32_t lengths[] = {8, 16, 40, 100, 200};
+    for (uint32_t i = 0; i < ARRAY_SIZE(lengths); i++) {
+        assert_uint32(benchHashCode(wyHashCode, lengths[i]), !=, 0);
+    }
+    return MUNIT_OK;
+}
+
+
+static MunitTest hashCodeTests[] = {
+        {.name =  "Test strHashCodeN() - should match strHashCode() and depend on every byte", .test = testStrHashCodeN},
+        {.name =  "Test wyHashCode() - should spread similar keys", .test = testWyHashCodeDistribution},
+        {.name =  "Test floatHashCode()/doubleHashCode()/hashMix32() - should spread strided and fractional keys", .test = testNumberHashCode},
+        {.name =  "Test identity hash strided keys Load - 4096 and 16 stride keys in BufferHashMap", .test = testIdentityStridedKeysLoad},
+        {.name =  "Test hashMix32() strided keys Load - 4096 and 16 stride keys in BufferHashMap", .test = testMixedStridedKeysLoad},
+        {.name =  "Test fnv1aHashCode() Load - 8..200 byte keys", .test = testFnv1aHashCodeLoad},
+        {.name =  "Test wyHashCode() Load - 8..200 byte keys", .test = testWyHashCodeLoad},
+        END_OF_TESTS
+};
+
+static const MunitSuite hashCodeTestSuite = {
+        .prefix = "HashCode: ",
+        .tests = hashCodeTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
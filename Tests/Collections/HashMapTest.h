@@ -4,6 +4,10 @@
 #include "HashMap.h"
 
 #define MAP_INITIAL_CAPACITY 4
+#define COUNTER_KEY_COUNT 4096
+#define COUNTER_INCREMENTS 2000000
+
+static char counterKeys[COUNTER_KEY_COUNT][16];
 
 static void *mapSetup(const MunitParameter params[], void *userData) {
     HashMap map = getHashMapInstance(MAP_INITIAL_CAPACITY);
@@ -159,6 +163,132 @@ static MunitResult testMapClear(const MunitParameter params[], void *map) {
     return MUNIT_OK;
 }
 
+static MunitResult testMapLengthAwareKeys(const MunitParameter params[], void *map) {
+    (HashMap) map;
+    const char *packet = "user=alice;role=admin;userId=42";   // keys are slices of buffer without NUL terminator
+    assert_true(hashMapPutN(map, packet, 4, "key1"));
+    assert_true(hashMapPutN(map, &packet[11], 4, "key2"));
+    assert_true(hashMapPutN(map, &packet[22], 6, "key3"));
+    assert_int(getHashMapSize(map), ==, 3);
+
+    const char *otherPacket = "role|user|userIdx";
+    assert_string_equal(hashMapGetN(map, &otherPacket[5], 4), "key1");
+    assert_string_equal(hashMapGetN(map, otherPacket, 4), "key2");
+    assert_string_equal(hashMapGetN(map, &otherPacket[10], 6), "key3");
+    assert_null(hashMapGetN(map, &otherPacket[10], 7));
+    assert_null(hashMapGetN(map, &otherPacket[10], 3));
+    assert_string_equal(hashMapGet(map, "user"), "key1");    // same key as NUL-terminated string
+
+    uint32_t hash = hashMapKeyHashCode(map, "role", 4);
+    assert_int(hash, ==, hashMapKeyHashCode(map, otherPacket, 4));
+    assert_string_equal(hashMapGetWithHash(map, otherPacket, 4, hash), "key2");
+    assert_true(hashMapPutWithHash(map, otherPacket, 4, hash, "key4"));    // existing key, value replaced
+    assert_int(getHashMapSize(map), ==, 3);
+    assert_string_equal(hashMapGet(map, "role"), "key4");
+
+    HashMapIterator iterator = getHashMapIterator(map);
+    while (hashMapHasNext(&iterator)) {
+        assert_string_equal(hashMapGetN(map, iterator.key, iterator.keyLength), iterator.value);
+    }
+
+    assert_string_equal(hashMapRemoveWithHash(map, "role", 4, hash), "key4");
+    assert_string_equal(hashMapRemoveN(map, &otherPacket[10], 6), "key3");
+    assert_null(hashMapRemoveN(map, &otherPacket[10], 6));
+    assert_int(getHashMapSize(map), ==, 1);
+    return MUNIT_OK;
+}
+
+static MunitResult testMapOwnedKeys(const MunitParameter params[], void *data) {
+    HashMap map = getKeyOwningHashMapInstance(4);
+    assert_not_null(map);
+    char key[32];
+    for (uint32_t i = 0; i < 1000; i++) {   // same buffer for every key, map keeps own copies
+        snprintf(key, sizeof(key), "owned.key.%u", i);
+        assert_true(hashMapPut(map, key, (MapValueType) (uintptr_t) (i + 1)));
+    }
+    const char *packet = "user=alice";
+    assert_true(hashMapPutN(map, packet, 4, (MapValueType) 7));
+    assert_string_equal(hashMapGetEntry(map, "user")->key, "user");   // slice is copied with NUL terminator
+
+    for (uint32_t i = 0; i < 1000; i += 2) {
+        snprintf(key, sizeof(key), "owned.key.%u", i);
+        assert_int((uintptr_t) hashMapRemove(map, key), ==, i + 1);
+    }
+    for (uint32_t i = 1000; i < 3000; i++) {   // resize and arena overflow compact removed keys
+        snprintf(key, sizeof(key), "owned.key.%u", i);
+        assert_true(hashMapPut(map, key, (MapValueType) (uintptr_t) (i + 1)));
+    }
+    assert_uint32(map->keyArenaSize, <=, map->keyArenaCapacity);
+    for (uint32_t i = 1; i < 3000; i += (i < 1000) ? 2 : 1) {
+        snprintf(key, sizeof(key), "owned.key.%u", i);
+        MapEntry *entry = hashMapGetEntry(map, key);
+        assert_not_null(entry);
+        assert_ptr_not_equal(entry->key, key);
+        assert_string_equal(entry->key, key);
+        assert_int((uintptr_t) entry->value, ==, i + 1);
+    }
+    assert_int(getHashMapSize(map), ==, 2501);
+
+    hashMapClear(map);
+    assert_uint32(map->keyArenaSize, ==, 0);
+    assert_true(hashMapPut(map, "after.clear", (MapValueType) 1));
+    assert_int((uintptr_t) hashMapGet(map, "after.clear"), ==, 1);
+    hashMapDelete(map);
+    return MUNIT_OK;
+}
+
+static MunitResult testMapSeededHash(const MunitParameter params[], void *data) {
+    HashMap one = getHashMapInstance(16);
+    HashMap two = getHashMapInstance(16);
+    assert_not_null(one);
+    assert_not_null(two);
+#ifdef HASH_MAP_SEEDED_HASH
+    assert_uint32(one->seed, !=, two->seed);
+    assert_uint32(hashMapKeyHashCode(one, "key", 3), !=, hashMapKeyHashCode(two, "key", 3));
+#else
+    assert_uint32(one->seed, ==, 0);
+    assert_uint32(hashMapKeyHashCode(one, "key", 3), ==, strHashCode("key"));
+#endif
+
+    char key[16];
+    for (uint32_t i = 0; i < 1000; i++) {
+        snprintf(key, sizeof(key), "key.%u", i);
+        assert_true(hashMapPut(one, strdup(key), (MapValueType) (uintptr_t) (i + 1)));
+    }
+    hashMapAddAll(one, two);    // cached hashes of other map can't be reused
+    for (uint32_t i = 0; i < 1000; i++) {
+        snprintf(key, sizeof(key), "key.%u", i);
+        assert_int((uintptr_t) hashMapGet(two, key), ==, i + 1);
+    }
+
+    HashMapIterator iterator = getHashMapIterator(one);
+    while (hashMapHasNext(&iterator)) {
+        free((char *) iterator.key);
+    }
+    hashMapDelete(one);
+    hashMapDelete(two);
+    return MUNIT_OK;
+}
+
+static MunitResult testMapOwnedKeysLoad(const MunitParameter params[], void *data) {
+    HashMap map = getKeyOwningHashMapInstance(16);
+    assert_not_null(map);
+    char key[48];
+    for (uint32_t round = 0; round < 2; round++) {
+        for (uint32_t i = 0; i < 200000; i++) {     // no strdup() per key and no free() per key on teardown
+            snprintf(key, sizeof(key), "config.registry.entry.%08u", i);
+            assert_true(hashMapPut(map, key, (MapValueType) (uintptr_t) (i + 1)));
+        }
+        for (uint32_t i = 0; i < 200000; i++) {
+            snprintf(key, sizeof(key), "config.registry.entry.%08u", i);
+            assert_int((uintptr_t) hashMapGet(map, key), ==, i + 1);
+        }
+        hashMapClear(map);
+    }
+    hashMapDelete(map);
+    return MUNIT_OK;
+}
+
 static MunitResult testMapLoad(const MunitParameter params[], void *map) {
     (HashMap) map;
     for (int i = 0; i < 100000; i++) {
@@ -176,6 +306,105 @@ static MunitResult testMapLoad(const MunitParameter params[], void *map) {
     return MUNIT_OK;
 }
 
+static MunitResult testMapLookupLoad(const MunitParameter params[], void *map) {
+    (HashMap) map;
+    const uint32_t keyCount = 200000;
+    const uint32_t keyLength = 32;
+    char *keys = malloc(keyCount * keyLength);
+    assert_not_null(keys);
+
+    for (uint32_t i = 0; i < keyCount; i++) {   // long common prefix makes every key compare expensive
+        snprintf(&keys[i * keyLength], keyLength, "config.registry.entry.%08u", i);
+        assert_true(hashMapPut(map, &keys[i * keyLength], (MapValueType) (uintptr_t) i));
+    }
+    assert_int(getHashMapSize(map), ==, keyCount);
+
+    for (uint32_t round = 0; round < 5; round++) {
+        for (uint32_t i = 0; i < keyCount; i++) {
+            assert_int((uintptr_t) hashMapGet(map, &keys[i * keyLength]), ==, i);
+        }
+    }
+    assert_null(hashMapGet(map, "config.registry.entry.missing"));
+
+    hashMapClear(map);
+    free(keys);
+    return MUNIT_OK;
+}
+
+static MunitResult testMapGetBatch(const MunitParameter params[], void *map) {
+    (HashMap) map;
+    const char *keys[] = {"key1", "missing", NULL, "key2", "key3"};
+    MapValueType values[ARRAY_SIZE(keys)];
+
+    hashMapGetBatch(map, keys, ARRAY_SIZE(keys), values);   // empty map
+    for (uint32_t i = 0; i < ARRAY_SIZE(keys); i++) {
+        assert_null(values[i]);
+    }
+
+    hashMapPut(map, "key1", "value1");
+    hashMapPut(map, "key2", "value2");
+    hashMapPut(map, "key3", "value3");
+    hashMapGetBatch(map, keys, ARRAY_SIZE(keys), values);
+    assert_string_equal(values[0], "value1");
+    assert_null(values[1]);
+    assert_null(values[2]);
+    assert_string_equal(values[3], "value2");
+    assert_string_equal(values[4], "value3");
+
+    char names[100][16];
+    const char *manyKeys[100];  // not multiple of batch size
+    MapValueType manyValues[100];
+    for (uint32_t i = 0; i < 100; i++) {
+        snprintf(names[i], sizeof(names[i]), "batch.%u", i);
+        manyKeys[i] = names[i];
+        if (i % 3 != 0) {
+            hashMapPut(map, names[i], (MapValueType) (uintptr_t) (i + 1));
+        }
+    }
+    hashMapGetBatch(map, manyKeys, 100, manyValues);
+    for (uint32_t i = 0; i < 100; i++) {
+        assert_int((uintptr_t) manyValues[i], ==, i % 3 != 0 ? i + 1 : 0);
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult testMapBatchLookupLoad(const MunitParameter params[], void *map) {
+    (HashMap) map;
+    const uint32_t keyCount = 200000;
+    const uint32_t batchSize = 256;
+    const uint32_t keyLength = 32;
+    char *keys = malloc(keyCount * keyLength);
+    const char **lookupKeys = malloc(keyCount * sizeof(char *));
+    MapValueType *values = malloc(keyCount * sizeof(MapValueType));
+    assert_not_null(keys);
+    assert_not_null(lookupKeys);
+    assert_not_null(values);
+
+    for (uint32_t i = 0; i < keyCount; i++) {
+        snprintf(&keys[i * keyLength], keyLength, "config.registry.entry.%08u", i);
+        assert_true(hashMapPut(map, &keys[i * keyLength], (MapValueType) (uintptr_t) i));
+    }
+    for (uint32_t i = 0; i < keyCount; i++) {   // random access order, each lookup is a cache miss
+        lookupKeys[i] = &keys[((i * 2654435761u) % keyCount) * keyLength];
+    }
+
+    for (uint32_t round = 0; round < 5; round++) {
+        for (uint32_t i = 0; i < keyCount; i += batchSize) {
+            uint32_t count = keyCount - i < batchSize ? keyCount - i : batchSize;
+            hashMapGetBatch(map, &lookupKeys[i], count, &values[i]);
+        }
+    }
+    for (uint32_t i = 0; i < keyCount; i++) {
+        assert_int((uintptr_t) values[i], ==, (lookupKeys[i] - keys) / keyLength);
+    }
+
+    hashMapClear(map);
+    free(keys);
+    free(lookupKeys);
+    free(values);
+    return MUNIT_OK;
+}
+
 static void mapTearDown(void *map) {
     hashMapDelete(map);
     map = NULL;
@@ -183,6 +412,348 @@ static void mapTearDown(void *map) {
 }
 
 
+static MunitResult testMapChurnLoad(const MunitParameter params[], void *map) {
+    (HashMap) map;
+    const uint32_t keyCount = 20000;
+    const uint32_t keyLength = 24;
+    char *keys = malloc(2 * keyCount * keyLength);
+    assert_not_null(keys);
+
+    for (uint32_t i = 0; i < 2 * keyCount; i++) {
+        snprintf(&keys[i * keyLength], keyLength, "session.%08u", i);
+    }
+    for (uint32_t i = 0; i < keyCount; i++) {
+        assert_true(hashMapPut(map, &keys[i * keyLength], (MapValueType) (uintptr_t) i));
+    }
+    uint32_t capacity = ((HashMap) map)->capacity;
+
+    for (uint32_t round = 0; round < 50; round++) {    // long-lived session table, each round expires part of keys and opens new ones
+        for (uint32_t i = round % 10; i < keyCount; i += 10) {
+            uint32_t oldKey = (round / 10 % 2 == 0) ? i : i + keyCount;
+            uint32_t newKey = (round / 10 % 2 == 0) ? i + keyCount : i;
+            assert_int((uintptr_t) hashMapRemove(map, &keys[oldKey * keyLength]), ==, i);
+            assert_true(hashMapPut(map, &keys[newKey * keyLength], (MapValueType) (uintptr_t) i));
+        }
+        for (uint32_t i = round % 10; i < keyCount; i += 10) {
+            uint32_t newKey = (round / 10 % 2 == 0) ? i + keyCount : i;
+            assert_int((uintptr_t) hashMapGet(map, &keys[newKey * keyLength]), ==, i);
+        }
+    }
+    assert_int(getHashMapSize(map), ==, keyCount);
+#ifdef HASH_MAP_ROBIN_HOOD
+    assert_uint32(((HashMap) map)->capacity, ==, capacity);  // no tombstones, so churn never forces a rebuild
+#else
+    assert_uint32(((HashMap) map)->capacity, >=, capacity);
+#endif
+
+    hashMapClear(map);
+    free(keys);
+    return MUNIT_OK;
+}
+
+static MunitResult testMapResizeLoad(const MunitParameter params[], void *map) {
+    (HashMap) map;
+    const uint32_t keyCount = 100000;
+    const uint32_t keyLength = 16;
+    char *keys = malloc(keyCount * keyLength);
+    assert_not_null(keys);
+
+    for (uint32_t i = 0; i < keyCount; i++) {   // every operation must see keys from both tables while resize is in progress
+        snprintf(&keys[i * keyLength], keyLength, "key.%08u", i);
+        assert_true(hashMapPut(map, &keys[i * keyLength], (MapValueType) (uintptr_t) (i + 1)));
+        assert_int((uintptr_t) hashMapGet(map, &keys[(i / 2) * keyLength]), ==, i / 2 + 1);
+        if (i % 3 == 0) {
+            assert_int((uintptr_t) hashMapRemove(map, &keys[(i / 3) * keyLength]), ==, i / 3 + 1);
+            assert_true(hashMapPut(map, &keys[(i / 3) * keyLength], (MapValueType) (uintptr_t) (i / 3 + 1)));
+        }
+    }
+    assert_int(getHashMapSize(map), ==, keyCount);
+
+    uint32_t count = 0;
+    HashMapIterator iterator = getHashMapIterator(map);
+    while (hashMapHasNext(&iterator)) {
+        count++;
+    }
+    assert_int(count, ==, keyCount);
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+    assert_null(((HashMap) map)->oldEntries);   // iteration finishes migration
+#endif
+
+    hashMapClear(map);
+    free(keys);
+    return MUNIT_OK;
+}
+
+static MunitResult testMapStats(const MunitParameter params[], void *map) {
+#ifdef HASH_MAP_STATS
+    (HashMap) map;
+    char keys[100][16];
+    for (uint32_t i = 0; i < 100; i++) {
+        snprintf(keys[i], sizeof(keys[i]), "key.%u", i);
+        assert_true(hashMapPut(map, keys[i], (MapValueType) (uintptr_t) (i + 1)));
+    }
+    for (uint32_t i = 0; i < 10; i++) {
+        hashMapRemove(map, keys[i]);
+    }
+
+    HashTableStats stats;
+    hashMapGetStats(map, &stats);
+    HashMap hashMap = map;
+    assert_uint32(stats.size, ==, 90);
+    assert_uint32(stats.capacity, ==, hashMap->capacity);
+    assert_uint32(stats.resizeCount, ==, 6);    // 4 -> 256
+    assert_uint32(stats.deletedItemsCount, ==, hashMap->deletedItemsCount);
+    assert_float(stats.loadFactor, ==, 90.0f / (float) hashMap->capacity);
+    assert_float(stats.tombstoneRatio, ==, (float) hashMap->deletedItemsCount / (float) hashMap->capacity);
+    assert_size(stats.allocatedBytes, >=, sizeof(struct HashMap) + hashMap->capacity * sizeof(MapEntry));
+
+    uint32_t keyCount = 0;
+    for (uint32_t i = 0; i < HASH_STATS_HISTOGRAM_SIZE; i++) {
+        keyCount += stats.probeLengthHistogram[i];
+    }
+    assert_uint32(keyCount, ==, 90);
+    assert_float(stats.averageProbeLength, ==, (float) stats.totalProbeLength / 90.0f);
+    assert_float(stats.averageProbeLength, <=, (float) stats.maxProbeLength);
+
+    hashMapGetStats(NULL, &stats);   // no-op
+    return MUNIT_OK;
+#else
+    return MUNIT_SKIP;
+#endif
+}
+
+static MunitResult testMapReuseAfterClear(const MunitParameter params[], void *data) {
+    HashMap map = getKeyOwningHashMapInstance(64);
+    assert_not_null(map);
+    char key[32];
+    for (uint32_t i = 0; i < 40; i++) {
+        snprintf(key, sizeof(key), "old.%u", i);
+        assert_true(hashMapPut(map, key, (MapValueType) (uintptr_t) (i + 1)));
+    }
+    hashMapRemove(map, "old.0");    // tombstone before clear
+    hashMapClear(map);
+    assert_true(isHashMapEmpty(map));
+    assert_false(isHashMapContainsKey(map, "old.1"));
+
+    for (uint32_t i = 0; i < 1000; i++) {   // grows past old capacity, stale slots must not be rehashed
+        snprintf(key, sizeof(key), "new.%u", i);
+        assert_true(hashMapPut(map, key, (MapValueType) (uintptr_t) (i + 1)));
+    }
+    assert_int(getHashMapSize(map), ==, 1000);
+    for (uint32_t i = 0; i < 40; i++) {
+        snprintf(key, sizeof(key), "old.%u", i);
+        assert_null(hashMapGet(map, key));
+    }
+    assert_int((uintptr_t) hashMapGet(map, "new.999"), ==, 1000);
+
+    hashMapClear(map);
+    assert_true(hashMapPut(map, "last", (MapValueType) 1));
+    uint32_t count = 0;
+    HashMapIterator iterator = getHashMapIterator(map);
+    while (hashMapHasNext(&iterator)) {
+        assert_string_equal(iterator.key, "last");
+        count++;
+    }
+    assert_uint32(count, ==, 1);
+
+    for (uint32_t round = 0; round < 70000; round++) {  // generation counter wraps around
+        hashMapClear(map);
+        assert_true(hashMapPutN(map, (const char *) &round, sizeof(round), (MapValueType) 1));
+        assert_false(isHashMapContainsKey(map, "last"));
+    }
+    assert_int(getHashMapSize(map), ==, 1);
+    hashMapDelete(map);
+    return MUNIT_OK;
+}
+
+static MapValueType addToCounter(const char *key, MapValueType value, void *context) {
+    uintptr_t counter = (uintptr_t) value + (uintptr_t) context;
+    return counter < 100 ? (MapValueType) counter : NULL;    // counter over limit is dropped
+}
+
+static MunitResult testMapComputeAndGetOrInsert(const MunitParameter params[], void *map) {
+    (HashMap) map;
+    assert_int((uintptr_t) hashMapCompute(map, "hits", addToCounter, (void *) 5), ==, 5);
+    assert_int((uintptr_t) hashMapCompute(map, "hits", addToCounter, (void *) 10), ==, 15);
+    assert_int((uintptr_t) hashMapGet(map, "hits"), ==, 15);
+    assert_null(hashMapCompute(map, "hits", addToCounter, (void *) 100));     // NULL result removes key
+    assert_false(isHashMapContainsKey(map, "hits"));
+    assert_null(hashMapCompute(map, "drop", addToCounter, (void *) 200));     // absent key is not added
+    assert_false(isHashMapContainsKey(map, "drop"));
+    assert_int(getHashMapSize(map), ==, 0);
+    assert_null(hashMapCompute(map, "hits", NULL, NULL));
+
+    MapValueType *slot = hashMapGetOrInsert(map, "errors", (MapValueType) 1);
+    assert_not_null(slot);
+    assert_int((uintptr_t) *slot, ==, 1);
+    *slot = (MapValueType) 2;
+    assert_int((uintptr_t) *hashMapGetOrInsert(map, "errors", (MapValueType) 0), ==, 2);   // existing key keeps value
+    assert_int(getHashMapSize(map), ==, 1);
+
+    char names[100][16];
+    for (uint32_t i = 0; i < 100; i++) {    // slots taken while map grows
+        snprintf(names[i], sizeof(names[i]), "slot.%u", i);
+        slot = hashMapGetOrInsert(map, names[i], NULL);
+        *slot = (MapValueType) (uintptr_t) (i + 1);
+    }
+    for (uint32_t i = 0; i < 100; i++) {
+        assert_int((uintptr_t) hashMapGet(map, names[i]), ==, i + 1);
+    }
+    assert_int((uintptr_t) hashMapGet(map, "errors"), ==, 2);
+    assert_int(getHashMapSize(map), ==, 101);
+    assert_null(hashMapGetOrInsert(map, NULL, NULL));
+
+    HashMap ownedMap = getKeyOwningHashMapInstance(4);
+    char key[16] = "reused";
+    hashMapCompute(ownedMap, key, addToCounter, (void *) 1);
+    strcpy(key, "other");
+    assert_int((uintptr_t) hashMapCompute(ownedMap, "reused", addToCounter, (void *) 1), ==, 2);
+
+    uint32_t arenaSize = ownedMap->keyArenaSize;
+    uint32_t capacity = ownedMap->capacity;
+    for (uint32_t i = 0; i < 100; i++) {    // dropped absent keys leave no tombstone, key copy or resize behind
+        assert_null(hashMapCompute(ownedMap, names[i], addToCounter, (void *) 200));
+    }
+    assert_uint32(ownedMap->keyArenaSize, ==, arenaSize);
+    assert_uint32(ownedMap->capacity, ==, capacity);
+    assert_uint32(ownedMap->deletedItemsCount, ==, 0);
+    assert_int(getHashMapSize(ownedMap), ==, 1);
+    hashMapDelete(ownedMap);
+    return MUNIT_OK;
+}
+
+static MunitResult testMapGetPutCounterLoad(const MunitParameter params[], void *data) {
+    HashMap map = getHashMapInstance(MAP_INITIAL_CAPACITY);
+    for (uint32_t i = 0; i < COUNTER_KEY_COUNT; i++) {
+        snprintf(counterKeys[i], sizeof(counterKeys[i]), "metric.%u", i);
+    }
+    for (uint32_t i = 0; i < COUNTER_INCREMENTS; i++) {
+        const char *key = counterKeys[(i * 2654435761U) % COUNTER_KEY_COUNT];
+        hashMapPut(map, key, (MapValueType) ((uintptr_t) hashMapGet(map, key) + 1));  // two hashes and two probes
+    }
+    assert_int(getHashMapSize(map), ==, COUNTER_KEY_COUNT);
+    assert_int((uintptr_t) hashMapGet(map, counterKeys[7]), ==, COUNTER_INCREMENTS / COUNTER_KEY_COUNT);
+    hashMapDelete(map);
+    return MUNIT_OK;
+}
+
+static MunitResult testMapGetOrInsertCounterLoad(const MunitParameter params[], void *data) {
+    HashMap map = getHashMapInstance(MAP_INITIAL_CAPACITY);
+    for (uint32_t i = 0; i < COUNTER_KEY_COUNT; i++) {
+        snprintf(counterKeys[i], sizeof(counterKeys[i]), "metric.%u", i);
+    }
+    for (uint32_t i = 0; i < COUNTER_INCREMENTS; i++) {
+        MapValueType *counter = hashMapGetOrInsert(map, counterKeys[(i * 2654435761U) % COUNTER_KEY_COUNT], NULL);
+        *counter = (MapValueType) ((uintptr_t) *counter + 1);   // single hash and probe
+    }
+    assert_int(getHashMapSize(map), ==, COUNTER_KEY_COUNT);
+    assert_int((uintptr_t) hashMapGet(map, counterKeys[7]), ==, COUNTER_INCREMENTS / COUNTER_KEY_COUNT);
+    hashMapDelete(map);
+    return MUNIT_OK;
+}
+
+static MunitResult testMapReserveAndShrinkToFit(const MunitParameter params[], void *map) {
+    HashMap hashMap = map;
+    static char keys[1000][16];
+    assert_true(hashMapReserve(map, 1000));
+    uint32_t capacity = hashMap->capacity;
+    assert_uint32(capacity, ==, 2048);  // 1000 / 0.75 rounded up to power of two
+    for (uint32_t i = 0; i < 1000; i++) {
+        snprintf(keys[i], sizeof(keys[i]), "key.%u", i);
+        assert_true(hashMapPut(map, keys[i], (MapValueType) (uintptr_t) (i + 1)));
+    }
+    assert_uint32(hashMap->capacity, ==, capacity);    // no resize while adding reserved keys
+    assert_true(hashMapReserve(map, 100));  // smaller reserve is no-op
+    assert_uint32(hashMap->capacity, ==, capacity);
+
+    for (uint32_t i = 10; i < 1000; i++) {
+        hashMapRemove(map, keys[i]);
+    }
+    assert_true(hashMapShrinkToFit(map));
+    assert_uint32(hashMap->capacity, ==, 16);
+    assert_uint32(hashMap->deletedItemsCount, ==, 0);
+    assert_int(getHashMapSize(map), ==, 10);
+    for (uint32_t i = 0; i < 10; i++) {
+        assert_int((uintptr_t) hashMapGet(map, keys[i]), ==, i + 1);
+    }
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+    assert_null(hashMap->oldEntries);
+#endif
+
+    HashMap toMap = getHashMapInstance(MAP_INITIAL_CAPACITY);
+    assert_not_null(toMap);
+    for (uint32_t i = 0; i < 1000; i++) {
+        hashMapPut(map, keys[i], (MapValueType) (uintptr_t) (i + 1));
+    }
+    hashMapAddAll(map, toMap);   // single rehash for all keys
+    assert_uint32(toMap->capacity, ==, 2048);
+#ifdef HASH_MAP_STATS
+    assert_uint32(toMap->resizeCount, ==, 1);
+#endif
+    assert_int(getHashMapSize(toMap), ==, 1000);
+    assert_int((uintptr_t) hashMapGet(toMap, keys[999]), ==, 1000);
+
+    HashMap ownedMap = getKeyOwningHashMapInstance(MAP_INITIAL_CAPACITY);
+    assert_not_null(ownedMap);
+    hashMapAddAll(map, ownedMap);
+    for (uint32_t i = 1; i < 1000; i++) {
+        hashMapRemove(ownedMap, keys[i]);
+    }
+    assert_true(hashMapShrinkToFit(ownedMap));
+    assert_uint32(ownedMap->keyArenaRemovedSize, ==, 0);    // removed key bytes are dropped too
+    assert_uint32(ownedMap->keyArenaCapacity, ==, HASH_MAP_KEY_ARENA_MIN_SIZE);
+    assert_int((uintptr_t) hashMapGet(ownedMap, keys[0]), ==, 1);
+
+    assert_false(hashMapReserve(NULL, 10));
+    assert_false(hashMapShrinkToFit(NULL));
+    hashMapDelete(toMap);
+    hashMapDelete(ownedMap);
+    return MUNIT_OK;
+}
+
+static MunitResult testMapAddAllLoad(const MunitParameter params[], void *data) {
+    const uint32_t keyCount = 200000;
+    const uint32_t keyLength = 16;
+    char *keys = malloc(keyCount * keyLength);
+    HashMap fromMap = getHashMapInstance(keyCount * 2);
+    assert_not_null(keys);
+    assert_not_null(fromMap);
+    for (uint32_t i = 0; i < keyCount; i++) {
+        snprintf(&keys[i * keyLength], keyLength, "key.%08u", i);
+        hashMapPut(fromMap, &keys[i * keyLength], (MapValueType) (uintptr_t) (i + 1));
+    }
+
+    for (uint32_t round = 0; round < 10; round++) {  // merge into small map, table is sized once instead of doubling 16 times
+        HashMap toMap = getHashMapInstance(MAP_INITIAL_CAPACITY);
+        assert_not_null(toMap);
+        hashMapAddAll(fromMap, toMap);
+        assert_int(getHashMapSize(toMap), ==, keyCount);
+        hashMapDelete(toMap);
+    }
+    hashMapDelete(fromMap);
+    free(keys);
+    return MUNIT_OK;
+}
+
+static MunitResult testMapScratchClearLoad(const MunitParameter params[], void *data) {
+    HashMap map = getHashMapInstance(65536);
+    assert_not_null(map);
+    static char keys[40][16];
+    for (uint32_t i = 0; i < 40; i++) {
+        snprintf(keys[i], sizeof(keys[i]), "header.%u", i);
+    }
+    for (uint32_t round = 0; round < 1000; round++) {  // big map reused per request with few keys
+        for (uint32_t i = 0; i < 40; i++) {
+            hashMapPut(map, keys[i], (MapValueType) (uintptr_t) (round + 1));
+        }
+        assert_int((uintptr_t) hashMapGet(map, keys[39]), ==, round + 1);
+        hashMapClear(map);
+    }
+    assert_true(isHashMapEmpty(map));
+    hashMapDelete(map);
+    return MUNIT_OK;
+}
+
 static MunitTest hashMapTests[] = {
         {.name =  "Test hashMapPut() - should correctly hold elements", .test = testMapPutElements, .setup = mapSetup, .tear_down = mapTearDown},
         {.name =  "Test hashMapGet() - should correctly return elements", .test = testMapGetElements, .setup = mapSetup, .tear_down = mapTearDown},
@@ -192,7 +763,24 @@ static MunitTest hashMapTests[] = {
         {.name =  "Test getHashMapSize() - should return correct map size", .test = testMapSize, .setup = mapSetup, .tear_down = mapTearDown},
         {.name =  "Test hashMapAddAll() - should correctly copy elements from map to map", .test = testMapAddAll, .setup = mapSetup, .tear_down = mapTearDown},
         {.name =  "Test testHashMapClear() - should clear map", .test = testMapClear, .setup = mapSetup, .tear_down = mapTearDown},
+        {.name =  "Test hashMapPutN()/GetN()/RemoveN() - should handle keys with known length and hash", .test = testMapLengthAwareKeys, .setup = mapSetup, .tear_down = mapTearDown},
+        {.name =  "Test getKeyOwningHashMapInstance() - should keep own copies of keys", .test = testMapOwnedKeys},
+        {.name =  "Test hashMapGetBatch() - should return values for all keys", .test = testMapGetBatch, .setup = mapSetup, .tear_down = mapTearDown},
+        {.name =  "Test hashMapKeyHashCode() - should hash keys with map seed", .test = testMapSeededHash},
+        {.name =  "Test hashMapGetStats() - should report probe lengths and occupancy", .test = testMapStats, .setup = mapSetup, .tear_down = mapTearDown},
         {.name =  "Test hashMap Load - should collect and remove a lot of elements", .test = testMapLoad, .setup = mapSetup, .tear_down = mapTearDown},
+        {.name =  "Test hashMap Lookup Load - should resize and find a lot of long prefixed keys", .test = testMapLookupLoad, .setup = mapSetup, .tear_down = mapTearDown},
+        {.name =  "Test hashMap Batch Lookup Load - should find a lot of keys with prefetch", .test = testMapBatchLookupLoad, .setup = mapSetup, .tear_down = mapTearDown},
+        {.name =  "Test hashMap Churn Load - should keep working under constant remove/put traffic", .test = testMapChurnLoad, .setup = mapSetup, .tear_down = mapTearDown},
+        {.name =  "Test hashMap Resize Load - should find all keys while map grows", .test = testMapResizeLoad, .setup = mapSetup, .tear_down = mapTearDown},
+        {.name =  "Test hashMap Owned Keys Load - should copy a lot of keys to arena", .test = testMapOwnedKeysLoad},
+        {.name =  "Test hashMapClear() - should reuse map after clear", .test = testMapReuseAfterClear},
+        {.name =  "Test hashMap Scratch Clear Load - should clear big map with few keys a lot of times", .test = testMapScratchClearLoad},
+        {.name =  "Test hashMapCompute()/GetOrInsert() - should update key value in single probe", .test = testMapComputeAndGetOrInsert, .setup = mapSetup, .tear_down = mapTearDown},
+        {.name =  "Test hashMap Get/Put Counter Load - should count keys with lookup and put", .test = testMapGetPutCounterLoad},
+        {.name =  "Test hashMap GetOrInsert Counter Load - should count keys with single probe", .test = testMapGetOrInsertCounterLoad},
+        {.name =  "Test hashMapReserve()/ShrinkToFit() - should resize table only when asked", .test = testMapReserveAndShrinkToFit, .setup = mapSetup, .tear_down = mapTearDown},
+        {.name =  "Test hashMap AddAll Load - should merge big map into small one with single rehash", .test = testMapAddAllLoad},
         END_OF_TESTS
 };
 
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "HeapFlatMap.h"
+
+CREATE_HEAP_FLAT_MAP_TYPE(uint32_t, uint32_t, heapFlat, heapFlat);
+CREATE_HEAP_FLAT_MAP_TYPE(char*, int, heapFlatStr, heapFlatInt, strComparator);
+
+
+static MunitResult testHeapFlatMapCreation(const MunitParameter params[], void *data) {
+    heapFlat_heapFlatMap *map = NEW_HEAP_FLAT_MAP(uint32_t, uint32_t, heapFlat, heapFlat, 0);
+    assert_not_null(map);
+    assert_uint32(map->entries->capacity, ==, HEAP_FLAT_MAP_MIN_CAPACITY);
+    assert_true(is_heapFlat_heapFlatMapEmpty(map));
+    heapFlat_heapFlatMapDelete(map);
+
+    map = NEW_HEAP_FLAT_MAP_OF(2, heapFlat, heapFlat, {5, 50}, {1, 10}, {3, 30}, {2, 20}, {4, 40}, {3, 33});
+    assert_uint32(heapFlat_heapFlatMapSize(map), ==, 5);
+    assert_uint32(map->entries->items[0].key, ==, 1);
+    assert_uint32(map->entries->items[4].key, ==, 5);
+    assert_uint32(heapFlat_heapFlatMapGet(map, 2), ==, 20);
+    assert_uint32(heapFlat_heapFlatMapGet(map, 3), ==, 33);     // last of duplicated keys is kept
+    heapFlat_heapFlatMapDelete(map);
+
+    heapFlatStr_heapFlatIntMap *strMap = HEAP_FLAT_MAP_OF(heapFlatStr, heapFlatInt, "b", 2, "a", 1);
+    assert_uint32(heapFlatStr_heapFlatIntMapSize(strMap), ==, 2);
+    assert_int(heapFlatStr_heapFlatIntMapGet(strMap, "b"), ==, 2);
+    assert_string_equal(strMap->entries->items[0].key, "a");
+    heapFlatStr_heapFlatIntMapDelete(strMap);
+    heapFlat_heapFlatMapDelete(NULL);
+    return MUNIT_OK;
+}
+
+static MunitResult testHeapFlatMapGrowAndShrink(const MunitParameter params[], void *data) {
+    heapFlat_heapFlatMap *map = NEW_HEAP_FLAT_MAP(uint32_t, uint32_t, heapFlat, heapFlat, 4);
+    for (uint32_t i = 0; i < 1000; i++) {
+        uint32_t key = (i * 617) % 1000;    // shuffled keys, buffer map would reject adds after 4 keys
+        assert_true(heapFlat_heapFlatMapAdd(map, key, key * 2));
+    }
+    assert_uint32(heapFlat_heapFlatMapSize(map), ==, 1000);
+    assert_uint32(map->entries->capacity, ==, 1024);
+    assert_false(heapFlat_heapFlatMapAdd(map, 1, 100));    // existing key, value replaced
+    assert_uint32(heapFlat_heapFlatMapGet(map, 1), ==, 100);
+    assert_uint32(heapFlat_heapFlatMapAdd(map, 1, 2), ==, false);
+
+    uint32_t expectedKey = 0;
+    heapFlat_heapFlatMapIterator iterator = heapFlat_heapFlatMapIter(map);
+    while (heapFlat_heapFlatMapHasNext(&iterator)) {
+        assert_uint32(iterator.key, ==, expectedKey++);
+    }
+    assert_uint32(expectedKey, ==, 1000);
+
+    expectedKey = 990;
+    iterator = heapFlat_heapFlatMapRangeIter(map, 990, 5000);
+    while (heapFlat_heapFlatMapHasNext(&iterator)) {
+        assert_uint32(iterator.key, ==, expectedKey++);
+    }
+    assert_uint32(expectedKey, ==, 1000);
+    assert_uint32(heapFlat_heapFlatMapRangeSize(map, 100, 200), ==, 100);
+
+    for (uint32_t i = 0; i < 990; i++) {
+        assert_uint32(heapFlat_heapFlatMapRemove(map, i), ==, i == 1 ? 2 : i * 2);
+    }
+    assert_uint32(heapFlat_heapFlatMapSize(map), ==, 10);
+    assert_uint32(map->entries->capacity, <, 64);  // array halves when less than quarter is used
+    assert_uint32(heapFlat_heapFlatMapGet(map, 995), ==, 1990);
+
+    heapFlat_heapFlatMapClear(map);
+    assert_true(is_heapFlat_heapFlatMapEmpty(map));
+    assert_uint32(map->entries->capacity, ==, 4);
+    heapFlat_heapFlatMapDelete(map);
+    return MUNIT_OK;
+}
+
+static MunitResult testHeapFlatMapFromArray(const MunitParameter params[], void *data) {
+    heapFlat_heapFlatMap *map = NEW_HEAP_FLAT_MAP(uint32_t, uint32_t, heapFlat, heapFlat, 4);
+    heapFlat_heapFlatMapEntry entries[300];
+    for (uint32_t i = 0; i < 300; i++) {
+        entries[i] = (heapFlat_heapFlatMapEntry) {.key = 299 - i, .value = i};
+    }
+    assert_true(heapFlat_heapFlatMapFromArray(map, entries, 300));     // grows as needed, sorted once
+    assert_uint32(heapFlat_heapFlatMapSize(map), ==, 300);
+    for (uint32_t i = 0; i < 300; i++) {
+        assert_uint32(map->entries->items[i].key, ==, i);
+        assert_uint32(heapFlat_heapFlatMapGet(map, i), ==, 299 - i);
+    }
+
+    heapFlat_heapFlatMap *copy = NEW_HEAP_FLAT_MAP(uint32_t, uint32_t, heapFlat, heapFlat, 4);
+    heapFlat_heapFlatMapAddAll(map, copy);
+    assert_uint32(heapFlat_heapFlatMapSize(copy), ==, 300);
+    assert_uint32(heapFlat_heapFlatMapLowerBound(copy, 150), ==, 150);
+
+    assert_true(heapFlat_heapFlatMapFromArray(map, NULL, 0));
+    assert_true(is_heapFlat_heapFlatMapEmpty(map));
+    assert_false(heapFlat_heapFlatMapFromArray(NULL, entries, 1));
+    heapFlat_heapFlatMapDelete(map);
+    heapFlat_heapFlatMapDelete(copy);
+    return MUNIT_OK;
+}
+
+
+static MunitTest heapFlatMapTests[] = {
+        {.name =  "Test new heap flat Map - should create map with sorted initial entries", .test = testHeapFlatMapCreation},
+        {.name =  "Test <key>_<value>MapAdd()/Remove() - should grow and shrink sorted entries", .test = testHeapFlatMapGrowAndShrink},
+        {.name =  "Test <key>_<value>MapFromArray()/AddAll() - should build map at once", .test = testHeapFlatMapFromArray},
+        END_OF_TESTS
+};
+
+static const MunitSuite heapFlatMapTestSuite = {
+        .prefix = "HeapFlatMap: ",
+        .tests = heapFlatMapTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "HeapHashMap.h"
+
+
+typedef struct HeapPoint {
+    int32_t x;
+    int32_t y;
+    int32_t z;
+} HeapPoint;
+
+CREATE_HEAP_HASH_MAP_TYPE(uint32_t, uint32_t, heap, heap);
+CREATE_HEAP_HASH_MAP_TYPE(char*, HeapPoint, heapStr, heapPoint, strComparator, strHashCode);
+
+
+static MunitResult testHeapMapCreation(const MunitParameter params[], void *data) {
+    heap_heapMap *map = NEW_HEAP_HASH_MAP(uint32_t, uint32_t, heap, heap, 4);
+    assert_not_null(map);
+    assert_uint32(map->size, ==, 0);
+    assert_uint32(map->capacity, ==, 8);
+    assert_true(is_heap_heapMapEmpty(map));
+    heap_heapMapDelete(map);
+
+    map = NEW_HEAP_HASH_MAP(uint32_t, uint32_t, heap, heap, 0);
+    assert_uint32(map->capacity, ==, HEAP_HASH_MAP_MIN_CAPACITY);
+    heap_heapMapDelete(map);
+
+    map = NEW_HEAP_HASH_MAP_OF(20, heap, heap, {1, 10}, {2, 20});
+    assert_uint32(map->size, ==, 2);
+    assert_uint32(map->capacity, ==, 64);
+    assert_uint32(heap_heapMapGet(map, 2), ==, 20);
+    heap_heapMapDelete(map);
+
+    heapStr_heapPointMap *strMap = HEAP_HASH_MAP_OF(heapStr, heapPoint, "a", ((HeapPoint) {1, 2, 3}), "b", ((HeapPoint) {4, 5, 6}));
+    assert_uint32(strMap->size, ==, 2);
+    assert_int32(heapStr_heapPointMapGet(strMap, "b").z, ==, 6);
+    heapStr_heapPointMapDelete(strMap);
+    return MUNIT_OK;
+}
+
+static MunitResult testHeapMapGrow(const MunitParameter params[], void *data) {
+    heap_heapMap *map = NEW_HEAP_HASH_MAP(uint32_t, uint32_t, heap, heap, 4);
+    for (uint32_t i = 0; i < 1000; i++) {
+        assert_true(heap_heapMapAdd(map, i, i * 2));   // buffer map would reject adds after 4 keys
+        assert_uint32(map->size, ==, i + 1);
+        assert_uint32(map->size, <=, map->capacity / HASH_MAP_EXPAND_FACTOR);
+    }
+    assert_uint32(map->capacity, ==, 2048);
+    for (uint32_t i = 0; i < 1000; i++) {
+        assert_uint32(heap_heapMapGet(map, i), ==, i * 2);
+    }
+    assert_false(heap_heapMapContains(map, 1000));
+    assert_false(heap_heapMapAdd(map, 1, 100));    // existing key, value replaced
+    assert_uint32(heap_heapMapGet(map, 1), ==, 100);
+    assert_uint32(heap_heapMapGetOrDefault(map, 5000, 7), ==, 7);
+
+    uint32_t count = 0;
+    heap_heapMapIterator iterator = heap_heapMapIter(map);
+    while (heap_heapMapHasNext(&iterator)) {
+        assert_true(iterator.key < 1000);
+        count++;
+    }
+    assert_uint32(count, ==, 1000);
+    heap_heapMapDelete(map);
+    return MUNIT_OK;
+}
+
+static MunitResult testHeapMapValuesByValue(const MunitParameter params[], void *data) {
+    heapStr_heapPointMap *map = NEW_HEAP_HASH_MAP(char*, HeapPoint, heapStr, heapPoint, 2);
+    char keys[100][8];
+    for (int32_t i = 0; i < 100; i++) {
+        sprintf(keys[i], "p%d", i);
+        assert_true(heapStr_heapPointMapAdd(map, keys[i], (HeapPoint) {i, i + 1, i + 2}));   // no per value allocation
+    }
+    for (int32_t i = 0; i < 100; i++) {
+        HeapPoint point = heapStr_heapPointMapGet(map, keys[i]);
+        assert_int32(point.x, ==, i);
+        assert_int32(point.z, ==, i + 2);
+    }
+    assert_int32(heapStr_heapPointMapRemove(map, "p42").y, ==, 43);
+    assert_false(heapStr_heapPointMapContains(map, "p42"));
+    assert_int32(heapStr_heapPointMapGet(map, "p42").x, ==, 0);
+
+    heapStr_heapPointMap *copy = NEW_HEAP_HASH_MAP(char*, HeapPoint, heapStr, heapPoint, 2);
+    heapStr_heapPointMapAddAll(map, copy);
+    assert_uint32(heapStr_heapPointMapSize(copy), ==, 99);
+    heapStr_heapPointMapClear(map);
+    assert_true(is_heapStr_heapPointMapEmpty(map));
+    assert_int32(heapStr_heapPointMapGet(copy, "p99").y, ==, 100);
+
+    heapStr_heapPointMapDelete(map);
+    heapStr_heapPointMapDelete(copy);
+    return MUNIT_OK;
+}
+
+static MunitResult testHeapMapReserveAndShrink(const MunitParameter params[], void *data) {
+    heap_heapMap *map = NEW_HEAP_HASH_MAP(uint32_t, uint32_t, heap, heap, 4);
+    assert_true(heap_heapMapReserve(map, 1000));
+    assert_uint32(map->capacity, ==, 2048);
+    HASH_MAP_ENTRY_TYPEDEF(heap, heap) *entries = map->entries;
+    for (uint32_t i = 0; i < 1000; i++) {
+        heap_heapMapAdd(map, i, i);
+    }
+    assert_ptr_equal(map->entries, entries);    // no rehash after reserve
+    assert_true(heap_heapMapReserve(map, 10));  // never shrinks
+    assert_uint32(map->capacity, ==, 2048);
+
+    for (uint32_t i = 10; i < 1000; i++) {
+        assert_uint32(heap_heapMapRemove(map, i), ==, i);
+    }
+    assert_uint32(map->deletedItemsCount, ==, 990);
+    assert_true(heap_heapMapShrinkToFit(map));
+    assert_uint32(map->capacity, ==, 32);
+    assert_uint32(map->deletedItemsCount, ==, 0);
+    for (uint32_t i = 0; i < 1000; i++) {
+        assert_uint32(heap_heapMapGet(map, i), ==, i < 10 ? i : 0);
+    }
+    heap_heapMapDelete(map);
+    return MUNIT_OK;
+}
+
+static MunitResult testHeapMapUpsertAndSlot(const MunitParameter params[], void *data) {
+    heap_heapMap *map = NEW_HEAP_HASH_MAP(uint32_t, uint32_t, heap, heap, 4);
+    HASH_MAP_ENTRY_TYPEDEF(heap, heap) *entries = map->entries;
+    for (uint32_t i = 0; i < 10000; i++) {
+        (*heap_heapMapGetOrAddSlot(map, i % 1000, 0))++;    // slot taken after growth points to the new table
+    }
+    assert_ptr_not_equal(map->entries, entries);
+    assert_uint32(map->size, ==, 1000);
+    assert_uint32(heap_heapMapGet(map, 999), ==, 10);
+
+    heapStr_heapPointMap *points = NEW_HEAP_HASH_MAP(char*, HeapPoint, heapStr, heapPoint, 2);
+    HeapPoint *point = heapStr_heapPointMapGetOrAddSlot(points, "origin", (HeapPoint) {0});
+    point->z = 7;   // struct value changed in place without copy
+    assert_int32(heapStr_heapPointMapGet(points, "origin").z, ==, 7);
+    assert_true(heapStr_heapPointMapUpsert(points, "origin", (HeapPoint) {1, 2, 3}, NULL));
+    assert_int32(heapStr_heapPointMapGet(points, "origin").x, ==, 1);
+
+    assert_true(heap_heapMapUpsert(map, 5000, 1, NULL));
+    assert_uint32(heap_heapMapGet(map, 5000), ==, 1);
+    assert_null(heap_heapMapGetOrAddSlot(NULL, 1, 1));
+    heapStr_heapPointMapDelete(points);
+    heap_heapMapDelete(map);
+    return MUNIT_OK;
+}
+
+static MunitResult testHeapMapChurnLoad(const MunitParameter params[], void *data) {
+    heap_heapMap *map = NEW_HEAP_HASH_MAP(uint32_t, uint32_t, heap, heap, 16);
+    for (uint32_t i = 0; i < 1000000; i++) {    // sliding window of live keys, tombstones are purged without growing
+        assert_true(heap_heapMapAdd(map, i, i));
+        if (i >= 1000) {
+            assert_uint32(heap_heapMapRemove(map, i - 1000), ==, i - 1000);
+        }
+    }
+    assert_uint32(map->size, ==, 1000);
+    assert_uint32(map->capacity, <=, 4096);
+    for (uint32_t i = 1000000 - 1000; i < 1000000; i++) {
+        assert_true(heap_heapMapContains(map, i));
+    }
+    heap_heapMapDelete(map);
+    return MUNIT_OK;
+}
+
+
+static MunitTest heapHashMapTests[] = {
+        {.name =  "Test new heap Map - should correctly create and init map", .test = testHeapMapCreation},
+        {.name =  "Test <key>_<value>MapAdd() - should grow table instead of rejecting keys", .test = testHeapMapGrow},
+        {.name =  "Test <key>_<value>MapGet() - should keep struct values by value", .test = testHeapMapValuesByValue},
+        {.name =  "Test <key>_<value>MapReserve()/ShrinkToFit() - should resize table", .test = testHeapMapReserveAndShrink},
+        {.name =  "Test <key>_<value>MapUpsert()/GetOrAddSlot() - should add or update key in single probe", .test = testHeapMapUpsertAndSlot},
+        {.name =  "Test heap map Churn Load - should keep capacity bounded under add/remove traffic", .test = testHeapMapChurnLoad},
+        END_OF_TESTS
+};
+
+static const MunitSuite heapHashMapTestSuite = {
+        .prefix = "HeapHashMap: ",
+        .tests = heapHashMapTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "BufferHashMap.h"
+#include "CommandPerfectHashMap.h"  // generated from PerfectHashKeys.txt at build time
+
+
+CREATE_HASH_MAP_TYPE(char*, uint32_t, command, command, strComparator, strHashCode);
+
+static const char *const PERFECT_HASH_COMMANDS[] = {
+        "AT", "ATE0", "ATE1", "ATI", "ATZ", "AT+CGMI", "AT+CGMM", "AT+CGMR", "AT+CGSN", "AT+CIMI", "AT+CSQ",
+        "AT+CREG", "AT+CGREG", "AT+COPS", "AT+CPIN", "AT+CFUN", "AT+CMGF", "AT+CMGS", "AT+CMGR", "AT+CMGD",
+        "AT+CMGL", "AT+CNMI", "AT+CSCA", "AT+CLIP", "AT+CLCC", "AT+CHUP", "AT+CIPSTART", "AT+CIPSEND",
+        "AT+CIPCLOSE", "AT+CIPSHUT", "AT+CIPSTATUS", "AT+CIFSR", "AT+CSTT", "AT+CIICR", "AT+CGATT",
+        "AT+HTTPINIT", "AT+HTTPPARA", "AT+HTTPACTION", "AT+HTTPREAD", "AT+HTTPTERM", "ATA", "ATD", "ATH"
+};
+
+
+static MunitResult testPerfectHashMapGet(const MunitParameter params[], void *data) {
+    assert_uint32(CommandMapSize, ==, ARRAY_SIZE(PERFECT_HASH_COMMANDS));
+    for (uint32_t i = 0; i < CommandMapSize; i++) {
+        assert_true(CommandMapContains(PERFECT_HASH_COMMANDS[i]));
+        assert_uint32(CommandMapGet(PERFECT_HASH_COMMANDS[i]), ==, i + 1);
+    }
+
+    bool isSlotUsed[CommandMapSize] = {false};  // minimal table, each key owns exactly one entry
+    for (uint32_t i = 0; i < CommandMapSize; i++) {
+        const CommandMapEntry *entry = CommandMapGetEntry(PERFECT_HASH_COMMANDS[i], strlen(PERFECT_HASH_COMMANDS[i]));
+        assert_not_null(entry);
+        assert_string_equal(entry->key, PERFECT_HASH_COMMANDS[i]);
+        assert_false(isSlotUsed[entry - CommandMapEntries]);
+        isSlotUsed[entry - CommandMapEntries] = true;
+    }
+
+    assert_uint32(CommandMapGetN("AT+CSQ?", 6), ==, 11);    // length limited key
+    return MUNIT_OK;
+}
+
+static MunitResult testPerfectHashMapMissingKeys(const MunitParameter params[], void *data) {
+    assert_false(CommandMapContains(""));
+    assert_false(CommandMapContains("A"));
+    assert_false(CommandMapContains("AT+"));        // prefix of existing keys
+    assert_false(CommandMapContains("AT+CSQ?"));
+    assert_false(CommandMapContains("at+csq"));
+    assert_false(CommandMapContains("AT+HTTPACTIONS"));
+    assert_uint32(CommandMapGet("AT+UNKNOWN"), ==, 0);
+    assert_null(CommandMapGetEntry("ATX", 3));
+    return MUNIT_OK;
+}
+
+static MunitResult testPerfectHashMapLookupLoad(const MunitParameter params[], void *data) {
+    command_commandMap *map = NEW_HASH_MAP(char*, uint32_t, command, command, ARRAY_SIZE(PERFECT_HASH_COMMANDS));
+    for (uint32_t i = 0; i < ARRAY_SIZE(PERFECT_HASH_COMMANDS); i++) {
+        assert_true(command_commandMapAdd(map, (char *) PERFECT_HASH_COMMANDS[i], i + 1));
+    }
+
+    uint64_t perfectSum = 0;
+    uint64_t bufferSum = 0;
+    for (uint32_t round = 0; round < 200000; round++) {
+        for (uint32_t i = 0; i < ARRAY_SIZE(PERFECT_HASH_COMMANDS); i++) {
+            perfectSum += CommandMapGet(PERFECT_HASH_COMMANDS[i]);
+        }
+    }
+    for (uint32_t round = 0; round < 200000; round++) {
+        for (uint32_t i = 0; i < ARRAY_SIZE(PERFECT_HASH_COMMANDS); i++) {
+            bufferSum += command_commandMapGet(map, (char *) PERFECT_HASH_COMMANDS[i]);
+        }
+    }
+    assert_uint64(perfectSum, ==, bufferSum);
+    assert_uint64(perfectSum, ==, 200000ULL * (CommandMapSize * (CommandMapSize + 1) / 2));
+    return MUNIT_OK;
+}
+
+
+static MunitTest perfectHashMapTests[] = {
+        {.name =  "Test <name>MapGet() - should find every generated key with one probe", .test = testPerfectHashMapGet},
+        {.name =  "Test <name>MapContains() - should not find missing and prefix keys", .test = testPerfectHashMapMissingKeys},
+        {.name =  "Test perfect hash map Lookup Load - should find all keys same as buffer map", .test = testPerfectHashMapLookupLoad},
+        END_OF_TESTS
+};
+
+static const MunitSuite perfectHashMapTestSuite = {
+        .prefix = "PerfectHashMap: ",
+        .tests = perfectHashMapTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
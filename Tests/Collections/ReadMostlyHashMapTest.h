@@ -0,0 +1,182 @@
+#pragma once
+
+#include <stdio.h>
+#include <sched.h>
+#include "BaseTestTemplate.h"
+#include "ReadMostlyHashMap.h"
+
+#define READ_MOSTLY_THREAD_COUNT 4
+#define READ_MOSTLY_KEY_COUNT 1024
+#define READ_MOSTLY_VERSION_COUNT 300
+
+typedef struct ReadMostlyWorker {
+    ReadMostlyHashMap map;
+    uint32_t id;
+    uint32_t foundCount;
+    bool isOrdered;
+} ReadMostlyWorker;
+
+static char readMostlyKeys[READ_MOSTLY_KEY_COUNT][16];
+static volatile bool isReadMostlyWriterDone;
+
+
+static void fillReadMostlyKeys() {
+    for (uint32_t i = 0; i < READ_MOSTLY_KEY_COUNT; i++) {
+        sprintf(readMostlyKeys[i], "route:%u", i);
+    }
+}
+
+static void *runVersionReader(void *data) {    // Readers never see version going back or table without routes
+    ReadMostlyWorker *worker = data;
+    ReadMostlyReader *reader = readMostlyHashMapRegisterReader(worker->map);
+    uintptr_t lastVersion = 0;
+    worker->isOrdered = reader != NULL;
+    while (reader != NULL && !__atomic_load_n(&isReadMostlyWriterDone, __ATOMIC_ACQUIRE)) {
+        uintptr_t version = (uintptr_t) readMostlyHashMapGet(worker->map, reader, "version");
+        worker->isOrdered &= version >= lastVersion;
+        lastVersion = version;
+
+        HashMap snapshot = readMostlyHashMapReadBegin(worker->map, reader);
+        const char *key = readMostlyKeys[worker->foundCount % READ_MOSTLY_KEY_COUNT];
+        worker->isOrdered &= hashMapGet(snapshot, key) != NULL;
+        worker->isOrdered &= (uintptr_t) hashMapGet(snapshot, "version") >= version;
+        readMostlyHashMapReadEnd(reader);
+        worker->foundCount++;
+    }
+    readMostlyHashMapUnregisterReader(reader);
+    return NULL;
+}
+
+static MunitResult testReadMostlyMapCreation(const MunitParameter params[], void *data) {
+    ReadMostlyHashMap map = getReadMostlyHashMapInstance(16, 2);
+    assert_not_null(map);
+    assert_uint32(getReadMostlyHashMapSize(map), ==, 0);
+
+    ReadMostlyReader *first = readMostlyHashMapRegisterReader(map);
+    ReadMostlyReader *second = readMostlyHashMapRegisterReader(map);
+    assert_not_null(first);
+    assert_not_null(second);
+    assert_ptr_not_equal(first, second);
+    assert_null(readMostlyHashMapRegisterReader(map));  // all reader slots taken
+    readMostlyHashMapUnregisterReader(first);
+    assert_ptr_equal(readMostlyHashMapRegisterReader(map), first);
+    readMostlyHashMapDelete(map);
+
+    map = getReadMostlyHashMapInstance(16, 0);
+    assert_uint32(map->readerCount, ==, READ_MOSTLY_HASH_MAP_MAX_READERS);
+    assert_null(readMostlyHashMapGet(map, NULL, "key"));
+    readMostlyHashMapDelete(map);
+
+    assert_false(readMostlyHashMapPut(NULL, "key", (MapValueType) 1));
+    assert_null(readMostlyHashMapRegisterReader(NULL));
+    assert_uint32(getReadMostlyHashMapSize(NULL), ==, 0);
+    readMostlyHashMapDelete(NULL);
+    return MUNIT_OK;
+}
+
+static MunitResult testReadMostlyMapPutGetRemove(const MunitParameter params[], void *data) {
+    ReadMostlyHashMap map = getReadMostlyHashMapInstance(4, 4);
+    ReadMostlyReader *reader = readMostlyHashMapRegisterReader(map);
+    char key[16];
+    for (uint32_t i = 0; i < 100; i++) {
+        sprintf(key, "route:%u", i);    // keys are copied, buffer is reused
+        assert_true(readMostlyHashMapPut(map, key, (MapValueType) (uintptr_t) (i + 1)));
+    }
+    assert_uint32(getReadMostlyHashMapSize(map), ==, 100);
+    assert_int((int) (uintptr_t) readMostlyHashMapGet(map, reader, "route:42"), ==, 43);
+    assert_int((int) (uintptr_t) readMostlyHashMapGetN(map, reader, "route:7/x", 7), ==, 8);
+    assert_null(readMostlyHashMapGet(map, reader, "route:100"));
+
+    assert_true(readMostlyHashMapPut(map, "route:42", (MapValueType) 420));
+    assert_int((int) (uintptr_t) readMostlyHashMapGet(map, reader, "route:42"), ==, 420);
+    assert_uint32(getReadMostlyHashMapSize(map), ==, 100);
+
+    assert_int((int) (uintptr_t) readMostlyHashMapRemove(map, "route:42"), ==, 420);
+    assert_null(readMostlyHashMapRemove(map, "route:42"));
+    assert_null(readMostlyHashMapGet(map, reader, "route:42"));
+    assert_uint32(getReadMostlyHashMapSize(map), ==, 99);
+
+    HashMap updates = getHashMapInstance(8);
+    hashMapPut(updates, "route:1", (MapValueType) 10);
+    hashMapPut(updates, "route:200", (MapValueType) 200);
+    hashMapPutN(updates, "route:2/x", 7, (MapValueType) 20);   // existing key slice, not counted as new one
+    assert_true(readMostlyHashMapPutAll(map, updates));
+    assert_int((int) (uintptr_t) readMostlyHashMapGet(map, reader, "route:1"), ==, 10);
+    assert_int((int) (uintptr_t) readMostlyHashMapGet(map, reader, "route:2"), ==, 20);
+    assert_int((int) (uintptr_t) readMostlyHashMapGet(map, reader, "route:200"), ==, 200);
+    assert_uint32(getReadMostlyHashMapSize(map), ==, 100);
+    hashMapDelete(updates);
+
+    assert_true(readMostlyHashMapClear(map));
+    assert_uint32(getReadMostlyHashMapSize(map), ==, 0);
+    assert_null(readMostlyHashMapGet(map, reader, "route:1"));
+    readMostlyHashMapDelete(map);
+    return MUNIT_OK;
+}
+
+static MunitResult testReadMostlyMapSnapshotReclaim(const MunitParameter params[], void *data) {
+    ReadMostlyHashMap map = getReadMostlyHashMapInstance(16, 4);
+    ReadMostlyReader *reader = readMostlyHashMapRegisterReader(map);
+    readMostlyHashMapPut(map, "gateway", (MapValueType) 1);
+    assert_null(map->retired);  // no readers inside read section, replaced table freed at once
+
+    HashMap snapshot = readMostlyHashMapReadBegin(map, reader);
+    readMostlyHashMapPut(map, "gateway", (MapValueType) 2);
+    readMostlyHashMapPut(map, "gateway", (MapValueType) 3);
+    assert_int((int) (uintptr_t) hashMapGet(snapshot, "gateway"), ==, 1);    // reader keeps consistent old version
+    assert_not_null(map->retired);
+    readMostlyHashMapReadEnd(reader);
+
+    assert_int((int) (uintptr_t) readMostlyHashMapGet(map, reader, "gateway"), ==, 3);
+    readMostlyHashMapPut(map, "gateway", (MapValueType) 4);
+    assert_null(map->retired);  // reclaimed by the next write
+    readMostlyHashMapDelete(map);
+    return MUNIT_OK;
+}
+
+static MunitResult testReadMostlyMapThreads(const MunitParameter params[], void *data) {
+    fillReadMostlyKeys();
+    ReadMostlyHashMap map = getReadMostlyHashMapInstance(READ_MOSTLY_KEY_COUNT * 2, 0);
+    for (uint32_t i = 0; i < READ_MOSTLY_KEY_COUNT; i++) {
+        readMostlyHashMapPut(map, readMostlyKeys[i], (MapValueType) (uintptr_t) (i + 1));
+    }
+    isReadMostlyWriterDone = false;
+
+    pthread_t threads[READ_MOSTLY_THREAD_COUNT];
+    ReadMostlyWorker workers[READ_MOSTLY_THREAD_COUNT];
+    for (uint32_t i = 0; i < READ_MOSTLY_THREAD_COUNT; i++) {
+        workers[i] = (ReadMostlyWorker) {.map = map, .id = i};
+        assert_int(pthread_create(&threads[i], NULL, runVersionReader, &workers[i]), ==, 0);
+    }
+    for (uintptr_t version = 1; version <= READ_MOSTLY_VERSION_COUNT; version++) {
+        assert_true(readMostlyHashMapPut(map, "version", (MapValueType) version));
+        if (version % 16 == 0) {
+            sched_yield();  // let readers hold old snapshots while writer goes on
+        }
+    }
+    __atomic_store_n(&isReadMostlyWriterDone, true, __ATOMIC_RELEASE);
+    for (uint32_t i = 0; i < READ_MOSTLY_THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+        assert_true(workers[i].isOrdered);
+    }
+    assert_uint32(getReadMostlyHashMapSize(map), ==, READ_MOSTLY_KEY_COUNT + 1);
+    readMostlyHashMapDelete(map);
+    return MUNIT_OK;
+}
+
+
+static MunitTest readMostlyHashMapTests[] = {
+        {.name =  "Test new ReadMostlyHashMap - should create map and register readers", .test = testReadMostlyMapCreation},
+        {.name =  "Test readMostlyHashMapPut()/Get()/Remove() - should publish new table versions", .test = testReadMostlyMapPutGetRemove},
+        {.name =  "Test readMostlyHashMapReadBegin() - should keep old snapshot until read section ends", .test = testReadMostlyMapSnapshotReclaim},
+        {.name =  "Test ReadMostlyHashMap threads - should read consistent versions while writer publishes", .test = testReadMostlyMapThreads},
+        END_OF_TESTS
+};
+
+static const MunitSuite readMostlyHashMapTestSuite = {
+        .prefix = "ReadMostlyHashMap: ",
+        .tests = readMostlyHashMapTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
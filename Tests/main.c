@@ -2,8 +2,25 @@
 #include "Collections/BufferVectorTest.h"
 #include "Collections/HashMapTest.h"
 #include "Collections/BufferHashMapTest.h"
+#include "Collections/BufferCtrlHashMapTest.h"
+#include "Collections/BufferRobinHoodHashMapTest.h"
+#include "Collections/BufferDenseHashMapTest.h"
+#include "Collections/BufferPackedHashMapTest.h"
+#include "Collections/PerfectHashMapTest.h"
+#include "Collections/HeapHashMapTest.h"
+#include "Collections/BufferFlatMapTest.h"
+#include "Collections/HeapFlatMapTest.h"
+#ifdef CONCURRENT_HASH_MAP
+#include "Collections/ConcurrentHashMapTest.h"
+#include "Collections/ReadMostlyHashMapTest.h"
+#endif
 #include "Collections/BufferHashSetTest.h"
+#include "Collections/BufferRobinHoodHashSetTest.h"
+#include "Collections/BufferPackedHashSetTest.h"
+#include "Collections/BufferBloomFilterTest.h"
+#include "Collections/BufferBitSetTest.h"
 #include "Collections/BufferVectorDequeTest.h"
+#include "Collections/HashCodeTest.h"
 
 
 int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
@@ -12,8 +29,25 @@ int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
             bufferVectorTestSuite,
             hashMapTestSuite,
             bufferHashMapTestSuite,
+            bufferCtrlHashMapTestSuite,
+            bufferRobinHoodHashMapTestSuite,
+            bufferDenseHashMapTestSuite,
+            bufferPackedHashMapTestSuite,
+            perfectHashMapTestSuite,
+            heapHashMapTestSuite,
+            bufferFlatMapTestSuite,
+            heapFlatMapTestSuite,
+#ifdef CONCURRENT_HASH_MAP
+            concurrentHashMapTestSuite,
+            readMostlyHashMapTestSuite,
+#endif
             bufferHashSetTestSuite,
-            bufferVectorDeqTestSuite
+            bufferRobinHoodHashSetTestSuite,
+            bufferPackedHashSetTestSuite,
+            bufferBloomFilterTestSuite,
+            bufferBitSetTestSuite,
+            bufferVectorDeqTestSuite,
+            hashCodeTestSuite
     };
 
     for (int i = 0; i < ARRAY_SIZE(testSuitArray); i++) {
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Comparator.h"
+
+// Set of small integers (flags, `uint8_t`/`uint16_t` ids) as bit array over caller provided buffer, one bit per possible value.
+// Set algebra runs over whole 64-bit words in plain loops without dependencies between words,
+// so compilers vectorize them to 128/256-bit instructions where available. Iteration skips zero words and jumps to set bits.
+
+#define BIT_SET_WORD_BITS 64
+#define BIT_SET_WORD_COUNT(CAPACITY) (((CAPACITY) + BIT_SET_WORD_BITS - 1) / BIT_SET_WORD_BITS)
+#define BIT_SET_NOT_FOUND UINT32_MAX
+
+#define BIT_SET_VALUE_TYPEDEF(NAME) NAME ##BitSetValue
+#define BIT_SET_TYPEDEF(NAME) NAME ##BitSet
+#define BIT_SET_ITERATOR_TYPEDEF(NAME) NAME ##BitSetIterator
+
+#define BIT_SET_METHOD_NAME_2(PREFIX, NAME, POSTFIX) PREFIX ## NAME ## POSTFIX
+#define BIT_SET_METHOD_NAME_1(NAME, POSTFIX) NAME ## POSTFIX
+#define BIT_SET_METHOD_MACRO(_1, _2, _3, FUN, ...) FUN
+#define BIT_SET_METHOD(...)                                      \
+    BIT_SET_METHOD_MACRO(__VA_ARGS__,                            \
+                        BIT_SET_METHOD_NAME_2,                   \
+                        BIT_SET_METHOD_NAME_1,                   \
+                        ERROR)(__VA_ARGS__)                      \
+
+
+static inline uint32_t bitSetPopCount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t) __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (uint32_t) ((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+static inline uint32_t bitSetTrailingZeros(uint64_t word) {    // word must not be 0
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t) __builtin_ctzll(word);
+#else
+    uint32_t count = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+
+#define CREATE_BIT_SET_TYPE_NAME(TYPE, NAME) \
+typedef TYPE BIT_SET_VALUE_TYPEDEF(NAME);   /* lets `..._OF()` macros declare value arrays by type name */ \
+\
+typedef struct BIT_SET_TYPEDEF(NAME) {  \
+    uint64_t *words;                    \
+    uint32_t wordCount;                 \
+    uint32_t capacity;                  \
+} BIT_SET_TYPEDEF(NAME);                \
+\
+typedef struct BIT_SET_ITERATOR_TYPEDEF(NAME) { \
+    TYPE value;                                 \
+    BIT_SET_TYPEDEF(NAME) *set;                 \
+    uint32_t wordIndex;                         \
+    uint64_t word;      /* not iterated bits of current word */ \
+} BIT_SET_ITERATOR_TYPEDEF(NAME);               \
+\
+static inline BIT_SET_TYPEDEF(NAME) * BIT_SET_METHOD(new, NAME, BitSet)(BIT_SET_TYPEDEF(NAME) *set, uint64_t *words, uint32_t capacity) { \
+    if (set == NULL || words == NULL) return NULL;  \
+    set->words = words;                             \
+    set->wordCount = BIT_SET_WORD_COUNT(capacity);  \
+    set->capacity = capacity;                       \
+    memset(words, 0, set->wordCount * sizeof(uint64_t)); \
+    return set;                                     \
+}                                                   \
+\
+static inline bool BIT_SET_METHOD(NAME, BitSetAdd)(BIT_SET_TYPEDEF(NAME) *set, TYPE value) { \
+    if (set == NULL || (uint32_t) value >= set->capacity) return false;    \
+    uint64_t mask = 1ull << ((uint32_t) value % BIT_SET_WORD_BITS);         \
+    uint64_t *word = &set->words[(uint32_t) value / BIT_SET_WORD_BITS];     \
+    bool isAdded = (*word & mask) == 0;     \
+    *word |= mask;                          \
+    return isAdded;                         \
+}                                           \
+\
+static inline BIT_SET_TYPEDEF(NAME) * BIT_SET_METHOD(new, NAME, BitSetOf)(BIT_SET_TYPEDEF(NAME) *set, uint64_t *words, uint32_t capacity, TYPE *values, uint32_t size) { \
+    set = BIT_SET_METHOD(new, NAME, BitSet)(set, words, capacity);  \
+    for (uint32_t i = 0; set != NULL && i < size; i++) {            \
+        BIT_SET_METHOD(NAME, BitSetAdd)(set, values[i]);            \
+    }                                                               \
+    return set;                                                     \
+}                                                                   \
+\
+static inline bool BIT_SET_METHOD(NAME, BitSetRemove)(BIT_SET_TYPEDEF(NAME) *set, TYPE value) { \
+    if (set == NULL || (uint32_t) value >= set->capacity) return false;    \
+    uint64_t mask = 1ull << ((uint32_t) value % BIT_SET_WORD_BITS);         \
+    uint64_t *word = &set->words[(uint32_t) value / BIT_SET_WORD_BITS];     \
+    bool isRemoved = (*word & mask) != 0;   \
+    *word &= ~mask;                         \
+    return isRemoved;                       \
+}                                           \
+\
+static inline bool BIT_SET_METHOD(NAME, BitSetContains)(BIT_SET_TYPEDEF(NAME) *set, TYPE value) { \
+    if (set == NULL || (uint32_t) value >= set->capacity) return false;    \
+    return (set->words[(uint32_t) value / BIT_SET_WORD_BITS] >> ((uint32_t) value % BIT_SET_WORD_BITS)) & 1; \
+}                                           \
+\
+static inline uint32_t BIT_SET_METHOD(NAME, BitSetSize)(BIT_SET_TYPEDEF(NAME) *set) { \
+    if (set == NULL) return 0;                          \
+    uint32_t size = 0;                                  \
+    for (uint32_t i = 0; i < set->wordCount; i++) {     \
+        size += bitSetPopCount(set->words[i]);          \
+    }                                                   \
+    return size;                                        \
+}                                                       \
+\
+static inline bool BIT_SET_METHOD(is, NAME, BitSetEmpty)(BIT_SET_TYPEDEF(NAME) *set) { \
+    if (set == NULL) return true;                       \
+    uint64_t bits = 0;                                  \
+    for (uint32_t i = 0; i < set->wordCount; i++) {     \
+        bits |= set->words[i];                          \
+    }                                                   \
+    return bits == 0;                                   \
+}                                                       \
+\
+static inline bool BIT_SET_METHOD(is, NAME, BitSetNotEmpty)(BIT_SET_TYPEDEF(NAME) *set) { \
+    return !BIT_SET_METHOD(is, NAME, BitSetEmpty)(set); \
+}                                                       \
+\
+static inline void BIT_SET_METHOD(NAME, BitSetClear)(BIT_SET_TYPEDEF(NAME) *set) { \
+    if (set != NULL) {                                          \
+        memset(set->words, 0, set->wordCount * sizeof(uint64_t)); \
+    }                                                           \
+}                                                               \
+\
+static inline void BIT_SET_METHOD(NAME, BitSetUnion)(BIT_SET_TYPEDEF(NAME) *toSet, BIT_SET_TYPEDEF(NAME) *fromSet) { \
+    if (toSet == NULL || fromSet == NULL) return;   /* values out of toSet capacity are dropped */ \
+    uint32_t wordCount = toSet->wordCount < fromSet->wordCount ? toSet->wordCount : fromSet->wordCount; \
+    for (uint32_t i = 0; i < wordCount; i++) {              \
+        toSet->words[i] |= fromSet->words[i];               \
+    }                                                       \
+    if (toSet->capacity % BIT_SET_WORD_BITS != 0 && wordCount == toSet->wordCount) {    /* keep bits after capacity zero */ \
+        toSet->words[wordCount - 1] &= (1ull << (toSet->capacity % BIT_SET_WORD_BITS)) - 1; \
+    }                                                       \
+}                                                           \
+\
+static inline void BIT_SET_METHOD(NAME, BitSetIntersect)(BIT_SET_TYPEDEF(NAME) *toSet, BIT_SET_TYPEDEF(NAME) *fromSet) { \
+    if (toSet == NULL || fromSet == NULL) return;           \
+    uint32_t wordCount = toSet->wordCount < fromSet->wordCount ? toSet->wordCount : fromSet->wordCount; \
+    for (uint32_t i = 0; i < wordCount; i++) {              \
+        toSet->words[i] &= fromSet->words[i];               \
+    }                                                       \
+    for (uint32_t i = wordCount; i < toSet->wordCount; i++) {   \
+        toSet->words[i] = 0;                                \
+    }                                                       \
+}                                                           \
+\
+static inline void BIT_SET_METHOD(NAME, BitSetSubtract)(BIT_SET_TYPEDEF(NAME) *toSet, BIT_SET_TYPEDEF(NAME) *fromSet) { \
+    if (toSet == NULL || fromSet == NULL) return;           \
+    uint32_t wordCount = toSet->wordCount < fromSet->wordCount ? toSet->wordCount : fromSet->wordCount; \
+    for (uint32_t i = 0; i < wordCount; i++) {              \
+        toSet->words[i] &= ~fromSet->words[i];              \
+    }                                                       \
+}                                                           \
+\
+static inline bool BIT_SET_METHOD(NAME, BitSetContainsAll)(BIT_SET_TYPEDEF(NAME) *set, BIT_SET_TYPEDEF(NAME) *compareSet) { \
+    if (set == NULL || compareSet == NULL) return false;    \
+    uint64_t missingBits = 0;                               \
+    for (uint32_t i = 0; i < compareSet->wordCount; i++) {  \
+        missingBits |= compareSet->words[i] & ~(i < set->wordCount ? set->words[i] : 0); \
+    }                                                       \
+    return missingBits == 0;                                \
+}                                                           \
+\
+static inline uint32_t BIT_SET_METHOD(NAME, BitSetNextSet)(BIT_SET_TYPEDEF(NAME) *set, uint32_t fromIndex) { \
+    if (set == NULL || fromIndex >= set->capacity) return BIT_SET_NOT_FOUND;                \
+    uint32_t wordIndex = fromIndex / BIT_SET_WORD_BITS;                                     \
+    uint64_t word = set->words[wordIndex] & (~0ull << (fromIndex % BIT_SET_WORD_BITS));     \
+    while (word == 0) {                                                                     \
+        if (++wordIndex >= set->wordCount) return BIT_SET_NOT_FOUND;                        \
+        word = set->words[wordIndex];                                                       \
+    }                                                                                       \
+    return wordIndex * BIT_SET_WORD_BITS + bitSetTrailingZeros(word);                       \
+}                                                                                           \
+\
+static inline uint32_t BIT_SET_METHOD(NAME, BitSetFirst)(BIT_SET_TYPEDEF(NAME) *set) { \
+    return BIT_SET_METHOD(NAME, BitSetNextSet)(set, 0); \
+}                                                       \
+\
+static inline BIT_SET_ITERATOR_TYPEDEF(NAME) BIT_SET_METHOD(NAME, BitSetIter)(BIT_SET_TYPEDEF(NAME) *set) { \
+    BIT_SET_ITERATOR_TYPEDEF(NAME) iterator = {.set = set, .wordIndex = 0};     \
+    iterator.word = (set != NULL && set->wordCount > 0) ? set->words[0] : 0;    \
+    return iterator;                                                            \
+}                                                                               \
+\
+static inline bool BIT_SET_METHOD(NAME, BitSetHasNext)(BIT_SET_ITERATOR_TYPEDEF(NAME) *iterator) { \
+    while (iterator->word == 0) {                                                       \
+        if (iterator->set == NULL || ++iterator->wordIndex >= iterator->set->wordCount) return false; \
+        iterator->word = iterator->set->words[iterator->wordIndex];                     \
+    }                                                                                   \
+    iterator->value = (TYPE) (iterator->wordIndex * BIT_SET_WORD_BITS + bitSetTrailingZeros(iterator->word)); \
+    iterator->word &= iterator->word - 1;   /* drop lowest set bit */                   \
+    return true;                                                                        \
+}
+
+
+#define CREATE_BIT_SET_TYPE_1(TYPE) CREATE_BIT_SET_TYPE_NAME(TYPE, TYPE)
+#define CREATE_BIT_SET_TYPE_2(TYPE, NAME) CREATE_BIT_SET_TYPE_NAME(TYPE, NAME)
+#define CREATE_BIT_SET_TYPE_MACRO(_1, _2, FUN, ...) FUN
+
+#define CREATE_BIT_SET_TYPE(...)                                 \
+    CREATE_BIT_SET_TYPE_MACRO(__VA_ARGS__,                       \
+                        CREATE_BIT_SET_TYPE_2,                   \
+                        CREATE_BIT_SET_TYPE_1,                   \
+                        ERROR)(__VA_ARGS__)
+
+
+#define NEW_BIT_SET(NAME, CAPACITY) \
+BIT_SET_METHOD(new, NAME, BitSet)(&(BIT_SET_TYPEDEF(NAME)){0}, (uint64_t [BIT_SET_WORD_COUNT(CAPACITY)]){0}, CAPACITY)
+
+#define NEW_BIT_SET_64(NAME)    NEW_BIT_SET(NAME, 64)
+#define NEW_BIT_SET_128(NAME)   NEW_BIT_SET(NAME, 128)
+#define NEW_BIT_SET_256(NAME)   NEW_BIT_SET(NAME, 256)
+#define NEW_BIT_SET_512(NAME)   NEW_BIT_SET(NAME, 512)
+#define NEW_BIT_SET_1024(NAME)  NEW_BIT_SET(NAME, 1024)
+
+#define NEW_BIT_SET_OF(NAME, CAPACITY, ...) \
+BIT_SET_METHOD(new, NAME, BitSetOf)(&(BIT_SET_TYPEDEF(NAME)){0}, (uint64_t [BIT_SET_WORD_COUNT(CAPACITY)]){0}, CAPACITY, \
+                                    (BIT_SET_VALUE_TYPEDEF(NAME) []){__VA_ARGS__}, \
+                                    sizeof((BIT_SET_VALUE_TYPEDEF(NAME) []){__VA_ARGS__}) / sizeof(BIT_SET_VALUE_TYPEDEF(NAME)))
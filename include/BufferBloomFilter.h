@@ -0,0 +1,192 @@
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "HashTableCommon.h"
+
+// Blocked Bloom filter over caller provided buffer. Each value sets one bit in every word of a single 32 byte block,
+// so add and query touch one cache line, and word bit tests don't depend on each other (compilers vectorize the loops).
+// Answers "definitely absent" or "maybe present", values can't be removed.
+
+#define BLOOM_FILTER_BLOCK_WORDS 8
+#define BLOOM_FILTER_BLOCK_BITS (BLOOM_FILTER_BLOCK_WORDS * 32)
+
+#ifndef BLOOM_FILTER_BITS_PER_VALUE
+#define BLOOM_FILTER_BITS_PER_VALUE 16   // filter size for NEW_BLOOM_FILTER() macros, ~0.15% false positives at 16 bits, ~3% at 8 bits
+#endif
+
+#define BLOOM_FILTER_BLOCK_COUNT(CAPACITY) ((((CAPACITY) * BLOOM_FILTER_BITS_PER_VALUE) + BLOOM_FILTER_BLOCK_BITS - 1) / BLOOM_FILTER_BLOCK_BITS)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BLOOM_FILTER_BLOCK_ALIGN __attribute__((aligned(32)))   // block never crosses cache line
+#else
+#define BLOOM_FILTER_BLOCK_ALIGN
+#endif
+
+static const uint32_t BLOOM_FILTER_SALTS[BLOOM_FILTER_BLOCK_WORDS] = {   // odd multipliers, one per block word
+        0x47B6137B, 0x44974D91, 0x8824AD5B, 0xA2B7289D, 0x705495C7, 0x2DF1424B, 0x9EFC4947, 0x5C6BFB31
+};
+
+typedef struct BloomFilterBlock {
+    uint32_t words[BLOOM_FILTER_BLOCK_WORDS];
+} BLOOM_FILTER_BLOCK_ALIGN BloomFilterBlock;
+
+#define BLOOM_FILTER_TYPEDEF(NAME) NAME ##BloomFilter
+
+#define BLOOM_FILTER_METHOD_NAME_2(PREFIX, NAME, POSTFIX) PREFIX ## NAME ## POSTFIX
+#define BLOOM_FILTER_METHOD_NAME_1(NAME, POSTFIX) NAME ## POSTFIX
+#define BLOOM_FILTER_METHOD_MACRO(_1, _2, _3, FUN, ...) FUN
+#define BLOOM_FILTER_METHOD(...)                                 \
+    BLOOM_FILTER_METHOD_MACRO(__VA_ARGS__,                       \
+                        BLOOM_FILTER_METHOD_NAME_2,              \
+                        BLOOM_FILTER_METHOD_NAME_1,              \
+                        ERROR)(__VA_ARGS__)                      \
+
+
+#define CREATE_BLOOM_FILTER_TYPE_NAME(TYPE, NAME, HASH_FUN) \
+typedef struct BLOOM_FILTER_TYPEDEF(NAME) { \
+    BloomFilterBlock *blocks;       \
+    uint32_t blockCount;            \
+    uint32_t size;                  \
+    uint32_t seed;                  \
+} BLOOM_FILTER_TYPEDEF(NAME);       \
+\
+static inline BLOOM_FILTER_TYPEDEF(NAME) * BLOOM_FILTER_METHOD(new, NAME, BloomFilter)(BLOOM_FILTER_TYPEDEF(NAME) *filter, BloomFilterBlock *blocks, uint32_t blockCount) { \
+    if (filter == NULL || blocks == NULL || blockCount == 0) return NULL; \
+    filter->blocks = blocks;            \
+    filter->blockCount = blockCount;    \
+    filter->size = 0;                   \
+    filter->seed = HASH_MAP_NEW_SEED(); \
+    memset(blocks, 0, blockCount * sizeof(BloomFilterBlock)); \
+    return filter;                      \
+}                                       \
+\
+static inline uint32_t BLOOM_FILTER_METHOD(NAME, BloomHash)(BLOOM_FILTER_TYPEDEF(NAME) *filter, TYPE value) { \
+    return hashMix32(HASH_FUN(value) ^ filter->seed);   /* identity integer hash codes must be mixed before use */ \
+}                                                       \
+\
+static inline BloomFilterBlock * BLOOM_FILTER_METHOD(NAME, BloomBlock)(BLOOM_FILTER_TYPEDEF(NAME) *filter, uint32_t hash) { \
+    return &filter->blocks[(uint32_t) (((uint64_t) hash * filter->blockCount) >> 32)];  /* high hash bits, any block count */ \
+}                                                       \
+\
+static inline void BLOOM_FILTER_METHOD(NAME, BloomMask)(uint32_t hash, uint32_t mask[BLOOM_FILTER_BLOCK_WORDS]) { \
+    uint32_t secondHash = hashMix32(hash);  /* block is selected by the first hash, bits by the second one */ \
+    for (uint32_t i = 0; i < BLOOM_FILTER_BLOCK_WORDS; i++) {   \
+        mask[i] = 1u << ((secondHash * BLOOM_FILTER_SALTS[i]) >> 27);   \
+    }                                                           \
+}                                                               \
+\
+static inline bool BLOOM_FILTER_METHOD(NAME, BloomAddHash)(BLOOM_FILTER_TYPEDEF(NAME) *filter, uint32_t hash) { \
+    uint32_t mask[BLOOM_FILTER_BLOCK_WORDS];                    \
+    BLOOM_FILTER_METHOD(NAME, BloomMask)(hash, mask);           \
+    BloomFilterBlock *block = BLOOM_FILTER_METHOD(NAME, BloomBlock)(filter, hash); \
+    uint32_t newBits = 0;                                       \
+    for (uint32_t i = 0; i < BLOOM_FILTER_BLOCK_WORDS; i++) {   \
+        newBits |= mask[i] & ~block->words[i];                  \
+        block->words[i] |= mask[i];                             \
+    }                                                           \
+    if (newBits != 0) {                                         \
+        filter->size++;                                         \
+    }                                                           \
+    return newBits != 0;                                        \
+}                                                               \
+\
+static inline bool BLOOM_FILTER_METHOD(NAME, BloomContainsHash)(BLOOM_FILTER_TYPEDEF(NAME) *filter, uint32_t hash) { \
+    uint32_t mask[BLOOM_FILTER_BLOCK_WORDS];                    \
+    BLOOM_FILTER_METHOD(NAME, BloomMask)(hash, mask);           \
+    BloomFilterBlock *block = BLOOM_FILTER_METHOD(NAME, BloomBlock)(filter, hash); \
+    uint32_t missingBits = 0;                                   \
+    for (uint32_t i = 0; i < BLOOM_FILTER_BLOCK_WORDS; i++) {   /* no early exit, all words are tested at once */ \
+        missingBits |= mask[i] & ~block->words[i];              \
+    }                                                           \
+    return missingBits == 0;                                    \
+}                                                               \
+\
+static inline bool BLOOM_FILTER_METHOD(NAME, BloomAdd)(BLOOM_FILTER_TYPEDEF(NAME) *filter, TYPE value) { \
+    if (filter == NULL) return false;   \
+    return BLOOM_FILTER_METHOD(NAME, BloomAddHash)(filter, BLOOM_FILTER_METHOD(NAME, BloomHash)(filter, value)); \
+}                                       \
+\
+static inline bool BLOOM_FILTER_METHOD(NAME, BloomContains)(BLOOM_FILTER_TYPEDEF(NAME) *filter, TYPE value) { \
+    if (filter == NULL) return false;   \
+    return BLOOM_FILTER_METHOD(NAME, BloomContainsHash)(filter, BLOOM_FILTER_METHOD(NAME, BloomHash)(filter, value)); \
+}                                       \
+\
+static inline void BLOOM_FILTER_METHOD(NAME, BloomAddAll)(BLOOM_FILTER_TYPEDEF(NAME) *filter, TYPE values[], uint32_t count) { \
+    if (filter == NULL) return;                                                         \
+    uint32_t hashes[HASH_MAP_BATCH_SIZE];                                               \
+    for (uint32_t offset = 0; offset < count; offset += HASH_MAP_BATCH_SIZE) {          \
+        uint32_t batchSize = count - offset < HASH_MAP_BATCH_SIZE ? count - offset : HASH_MAP_BATCH_SIZE; \
+        for (uint32_t i = 0; i < batchSize; i++) {  /* Hash all values first, so blocks are loaded in parallel */ \
+            hashes[i] = BLOOM_FILTER_METHOD(NAME, BloomHash)(filter, values[offset + i]);   \
+            HASH_MAP_PREFETCH(BLOOM_FILTER_METHOD(NAME, BloomBlock)(filter, hashes[i]));    \
+        }                                                                               \
+        for (uint32_t i = 0; i < batchSize; i++) {                                      \
+            BLOOM_FILTER_METHOD(NAME, BloomAddHash)(filter, hashes[i]);                 \
+        }                                                                               \
+    }                                                                                   \
+}                                                                                       \
+\
+static inline uint32_t BLOOM_FILTER_METHOD(NAME, BloomContainsBatch)(BLOOM_FILTER_TYPEDEF(NAME) *filter, TYPE values[], uint32_t count, bool results[]) { \
+    uint32_t hashes[HASH_MAP_BATCH_SIZE];                                               \
+    uint32_t containedCount = 0;                                                        \
+    for (uint32_t offset = 0; offset < count; offset += HASH_MAP_BATCH_SIZE) {          \
+        uint32_t batchSize = count - offset < HASH_MAP_BATCH_SIZE ? count - offset : HASH_MAP_BATCH_SIZE; \
+        for (uint32_t i = 0; i < batchSize; i++) {                                      \
+            if (filter == NULL) {                                                       \
+                results[offset + i] = false;                                            \
+                continue;                                                               \
+            }                                                                           \
+            hashes[i] = BLOOM_FILTER_METHOD(NAME, BloomHash)(filter, values[offset + i]);   \
+            HASH_MAP_PREFETCH(BLOOM_FILTER_METHOD(NAME, BloomBlock)(filter, hashes[i]));    \
+        }                                                                               \
+        for (uint32_t i = 0; filter != NULL && i < batchSize; i++) {                    \
+            results[offset + i] = BLOOM_FILTER_METHOD(NAME, BloomContainsHash)(filter, hashes[i]); \
+            containedCount += results[offset + i];                                      \
+        }                                                                               \
+    }                                                                                   \
+    return containedCount;                                                              \
+}                                                                                       \
+\
+static inline uint32_t BLOOM_FILTER_METHOD(NAME, BloomSize)(BLOOM_FILTER_TYPEDEF(NAME) *filter) { \
+    return filter != NULL ? filter->size : 0;   \
+}                                               \
+\
+static inline bool BLOOM_FILTER_METHOD(is, NAME, BloomEmpty)(BLOOM_FILTER_TYPEDEF(NAME) *filter) { \
+    return filter != NULL ? filter->size == 0 : true; \
+}                                                     \
+\
+static inline void BLOOM_FILTER_METHOD(NAME, BloomClear)(BLOOM_FILTER_TYPEDEF(NAME) *filter) { \
+    if (filter != NULL) {                                                       \
+        memset(filter->blocks, 0, filter->blockCount * sizeof(BloomFilterBlock)); \
+        filter->size = 0;                                                       \
+    }                                                                           \
+}                                                                               \
+
+
+
+#define CREATE_BLOOM_FILTER_TYPE_1(TYPE) CREATE_BLOOM_FILTER_TYPE_NAME(TYPE, TYPE, HASH_CODE_FOR_TYPE(TYPE))
+#define CREATE_BLOOM_FILTER_TYPE_2(TYPE, NAME) CREATE_BLOOM_FILTER_TYPE_NAME(TYPE, NAME, HASH_CODE_FOR_TYPE(TYPE))
+#define CREATE_BLOOM_FILTER_TYPE_3(TYPE, NAME, HASH_FUN) CREATE_BLOOM_FILTER_TYPE_NAME(TYPE, NAME, HASH_FUN)
+#define CREATE_BLOOM_FILTER_TYPE_MACRO(_1, _2, _3, FUN, ...) FUN
+
+#define CREATE_BLOOM_FILTER_TYPE(...)                                 \
+    CREATE_BLOOM_FILTER_TYPE_MACRO(__VA_ARGS__,                       \
+                        CREATE_BLOOM_FILTER_TYPE_3,                   \
+                        CREATE_BLOOM_FILTER_TYPE_2,                   \
+                        CREATE_BLOOM_FILTER_TYPE_1,                   \
+                        ERROR)(__VA_ARGS__)
+
+
+#define NEW_BLOOM_FILTER(NAME, CAPACITY) \
+BLOOM_FILTER_METHOD(new, NAME, BloomFilter)(&(BLOOM_FILTER_TYPEDEF(NAME)){0}, \
+                                             (BloomFilterBlock [BLOOM_FILTER_BLOCK_COUNT(CAPACITY)]){0}, \
+                                              BLOOM_FILTER_BLOCK_COUNT(CAPACITY))
+
+#define NEW_BLOOM_FILTER_16(NAME)   NEW_BLOOM_FILTER(NAME, 16)
+#define NEW_BLOOM_FILTER_32(NAME)   NEW_BLOOM_FILTER(NAME, 32)
+#define NEW_BLOOM_FILTER_64(NAME)   NEW_BLOOM_FILTER(NAME, 64)
+#define NEW_BLOOM_FILTER_128(NAME)  NEW_BLOOM_FILTER(NAME, 128)
+#define NEW_BLOOM_FILTER_256(NAME)  NEW_BLOOM_FILTER(NAME, 256)
+#define NEW_BLOOM_FILTER_512(NAME)  NEW_BLOOM_FILTER(NAME, 512)
+#define NEW_BLOOM_FILTER_1024(NAME) NEW_BLOOM_FILTER(NAME, 1024)
@@ -0,0 +1,360 @@
+#pragma once
+
+#include "BufferHashMap.h"
+
+// Alternative BufferHashMap layout: separate control byte per slot with 7 bits of key hash.
+// Lookup matches whole group of 16 control bytes at once and touches key/value memory only on tag hit.
+// Key hash is mixed with `hashMix32()`, so group index and tag bits get entropy from small number keys too.
+#if !defined(HASH_MAP_CTRL_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define HASH_MAP_CTRL_SSE2
+#elif !defined(HASH_MAP_CTRL_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define HASH_MAP_CTRL_NEON
+#endif
+
+#define HASH_MAP_GROUP_WIDTH 16
+#define HASH_MAP_CTRL_EMPTY ((uint8_t) 0x80)    // 0b10000000
+#define HASH_MAP_CTRL_DELETED ((uint8_t) 0xFE)  // 0b11111110, full slot keeps hash tag: 0b0xxxxxxx
+#define HASH_MAP_CTRL_TAG(HASH) ((uint8_t) ((HASH) & 0x7F))
+#define HASH_MAP_CTRL_MAX_LOAD(CAPACITY) ((CAPACITY) - ((CAPACITY) / 8))  // 7/8 of slots can be used
+// Add reuses tombstones, so their count stays low near max load, but empty slots that stop missing key probes run out.
+// Purge when tombstones take quarter of the map, or when used and deleted slots reach max load and there is a group worth of tombstones
+#define HASH_MAP_CTRL_NEEDS_PURGE(MAP) ((MAP)->deletedItemsCount > HASH_MAP_TOMBSTONE_PURGE_THRESHOLD((MAP)->capacity) || \
+                                        ((MAP)->deletedItemsCount >= (MAP)->capacity / HASH_MAP_GROUP_WIDTH &&            \
+                                         (MAP)->size + (MAP)->deletedItemsCount >= HASH_MAP_CTRL_MAX_LOAD((MAP)->capacity)))
+
+#define CTRL_HASH_MAP_MIN_CAPACITY(CAPACITY) ((CAPACITY) < HASH_MAP_GROUP_WIDTH ? HASH_MAP_GROUP_WIDTH : (CAPACITY))
+#define CTRL_HASH_MAP_ALIGN_CAPACITY(CAPACITY) (CTRL_HASH_MAP_MIN_CAPACITY(NEXT_POW_OF_2(((CAPACITY) * 8 + 6) / 7)))
+
+
+#if defined(HASH_MAP_CTRL_NEON)
+static inline uint32_t hashMapCtrlNeonMask(uint8x16_t compareResult) {  // emulate SSE2 movemask: one bit per matched byte
+    static const uint8_t bitWeights[HASH_MAP_GROUP_WIDTH] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t bits = vandq_u8(compareResult, vld1q_u8(bitWeights));
+    return (uint32_t) vaddv_u8(vget_low_u8(bits)) | ((uint32_t) vaddv_u8(vget_high_u8(bits)) << 8);
+}
+#endif
+
+static inline uint32_t hashMapCtrlMatch(const uint8_t *group, uint8_t ctrlByte) {  // bit mask of group slots equal to control byte
+#if defined(HASH_MAP_CTRL_SSE2)
+    __m128i ctrl = _mm_loadu_si128((const __m128i *) group);
+    return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char) ctrlByte)));
+#elif defined(HASH_MAP_CTRL_NEON)
+    return hashMapCtrlNeonMask(vceqq_u8(vld1q_u8(group), vdupq_n_u8(ctrlByte)));
+#else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < HASH_MAP_GROUP_WIDTH; i++) {
+        mask |= (uint32_t) (group[i] == ctrlByte) << i;
+    }
+    return mask;
+#endif
+}
+
+static inline uint32_t hashMapCtrlMatchEmptyOrDeleted(const uint8_t *group) {  // both special control bytes have high bit set
+#if defined(HASH_MAP_CTRL_SSE2)
+    return (uint32_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) group));
+#elif defined(HASH_MAP_CTRL_NEON)
+    return hashMapCtrlNeonMask(vtstq_u8(vld1q_u8(group), vdupq_n_u8(HASH_MAP_CTRL_EMPTY)));
+#else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < HASH_MAP_GROUP_WIDTH; i++) {
+        mask |= (uint32_t) ((group[i] & HASH_MAP_CTRL_EMPTY) != 0) << i;
+    }
+    return mask;
+#endif
+}
+
+static inline uint32_t hashMapCtrlLowestBit(uint32_t mask) {
+#if defined(__GNUC__)
+    return (uint32_t) __builtin_ctz(mask);
+#else
+    uint32_t index = 0;
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+
+#define CREATE_CTRL_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN) \
+typedef struct HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) { \
+    KEY_TYPE key;               \
+    VALUE_TYPE value;           \
+} HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME); \
+\
+typedef struct HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) { \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries; \
+    uint8_t *ctrl;                  \
+    uint32_t size;                  \
+    uint32_t capacity;              \
+    uint32_t deletedItemsCount;     \
+    uint32_t seed;                  \
+} HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME); \
+\
+typedef struct HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) {    \
+    KEY_TYPE key;                                                   \
+    VALUE_TYPE value;                                               \
+    HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map;                    \
+    uint32_t index;                                                 \
+} HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME);                  \
+                                                                    \
+static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMap)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint8_t *ctrl, uint32_t capacity) { \
+    if (map == NULL || capacity < HASH_MAP_GROUP_WIDTH) return NULL;  \
+    map->entries = entries;             \
+    map->ctrl = ctrl;                   \
+    map->size = 0;                      \
+    map->capacity = capacity;           \
+    map->deletedItemsCount = 0;         \
+    map->seed = HASH_MAP_NEW_SEED();    \
+    memset(ctrl, HASH_MAP_CTRL_EMPTY, capacity);    \
+    return map;                                     \
+}                                                   \
+\
+static inline uint32_t HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapSlot)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, uint32_t hash, uint32_t *freeIndex) { \
+    uint32_t groupMask = (map->capacity / HASH_MAP_GROUP_WIDTH) - 1;    \
+    uint32_t group = (hash >> 7) & groupMask;                           \
+    uint32_t freeSlot = map->capacity;                                  \
+                                                                        \
+    for (uint32_t probe = 0; probe <= groupMask; probe++) {             \
+        uint32_t offset = group * HASH_MAP_GROUP_WIDTH;                 \
+        const uint8_t *ctrl = &map->ctrl[offset];                       \
+        uint32_t match = hashMapCtrlMatch(ctrl, HASH_MAP_CTRL_TAG(hash)); \
+        while (match != 0) {                                            \
+            uint32_t index = offset + hashMapCtrlLowestBit(match);      \
+            if (COMPARE_FUN(key, map->entries[index].key) == 0) {       \
+                return index;                                           \
+            }                                                           \
+            match &= match - 1;                                         \
+        }                                                               \
+                                                                        \
+        if (freeSlot == map->capacity) {                                \
+            uint32_t freeMask = hashMapCtrlMatchEmptyOrDeleted(ctrl);   \
+            if (freeMask != 0) {                                        \
+                freeSlot = offset + hashMapCtrlLowestBit(freeMask);     \
+            }                                                           \
+        }                                                               \
+        if (hashMapCtrlMatch(ctrl, HASH_MAP_CTRL_EMPTY) != 0) break;    /* Key can't be placed beyond group that have never been full */ \
+        group = (group + probe + 1) & groupMask;                        /* Triangular probing visits each group once */ \
+    }                                                                   \
+    if (freeIndex != NULL) {                                            \
+        *freeIndex = freeSlot;                                          \
+    }                                                                   \
+    return map->capacity;                                               \
+}                                                                       \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapCompact)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) { \
+    if (map == NULL || map->deletedItemsCount == 0) return;                 \
+    for (uint32_t i = 0; i < map->capacity; i++) {   /* Tombstones become empty slots, live entries are marked as not placed yet */ \
+        map->ctrl[i] = (map->ctrl[i] & HASH_MAP_CTRL_EMPTY) != 0 ? HASH_MAP_CTRL_EMPTY : HASH_MAP_CTRL_DELETED; \
+    }                                                                       \
+                                                                            \
+    uint32_t groupMask = (map->capacity / HASH_MAP_GROUP_WIDTH) - 1;        \
+    for (uint32_t i = 0; i < map->capacity; i++) {                          \
+        while (map->ctrl[i] == HASH_MAP_CTRL_DELETED) {  /* Entry goes to the first free or not placed slot on its probe path */ \
+            uint32_t hash = hashMix32(HASH_MAP_KEY_HASH_CODE(HASH_FUN, map->entries[i].key, map->seed)); \
+            uint32_t group = (hash >> 7) & groupMask;                       \
+            uint32_t freeMask = 0;                                          \
+            for (uint32_t probe = 0; (freeMask = hashMapCtrlMatchEmptyOrDeleted(&map->ctrl[group * HASH_MAP_GROUP_WIDTH])) == 0; probe++) { \
+                group = (group + probe + 1) & groupMask;                    \
+            }                                                               \
+            uint32_t index = group * HASH_MAP_GROUP_WIDTH + hashMapCtrlLowestBit(freeMask); \
+            if (index == i) {                                               \
+                map->ctrl[i] = HASH_MAP_CTRL_TAG(hash);                     \
+            } else if (map->ctrl[index] == HASH_MAP_CTRL_EMPTY) {           \
+                map->entries[index] = map->entries[i];                      \
+                map->ctrl[index] = HASH_MAP_CTRL_TAG(hash);                 \
+                map->ctrl[i] = HASH_MAP_CTRL_EMPTY;                         \
+            } else {    /* Slot of not placed entry is taken, that entry is placed next from slot `i` */ \
+                HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) displacedEntry = map->entries[index]; \
+                map->entries[index] = map->entries[i];                      \
+                map->entries[i] = displacedEntry;                           \
+                map->ctrl[index] = HASH_MAP_CTRL_TAG(hash);                 \
+            }                                                               \
+        }                                                                   \
+    }                                                                       \
+    map->deletedItemsCount = 0;                                             \
+}                                                                           \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE value) {   \
+    if (map != NULL && map->size < HASH_MAP_CTRL_MAX_LOAD(map->capacity)) {                             \
+        if (HASH_MAP_CTRL_NEEDS_PURGE(map)) {   /* Groups without empty slots make missing key lookups scan whole table */   \
+            HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapCompact)(map);                                     \
+        }                                                                                               \
+        uint32_t hash = hashMix32(HASH_MAP_KEY_HASH_CODE(HASH_FUN, key, map->seed));            \
+        uint32_t freeIndex;                                                                             \
+        uint32_t index = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapSlot)(map, key, hash, &freeIndex); \
+        if (index != map->capacity) {                   \
+            map->entries[index].value = value;          \
+            return false;                               \
+        }                                               \
+                                                        \
+        if (map->ctrl[freeIndex] == HASH_MAP_CTRL_DELETED) { \
+            map->deletedItemsCount--;                   \
+        }                                               \
+        map->ctrl[freeIndex] = HASH_MAP_CTRL_TAG(hash); \
+        map->entries[freeIndex].key = key;              \
+        map->entries[freeIndex].value = value;          \
+        map->size++;                                    \
+        return true;                                    \
+    }                                                   \
+    return false;                                       \
+}                                                       \
+\
+static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMapOf)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint8_t *ctrl, uint32_t capacity, uint32_t size) { \
+    if (map == NULL || entries == NULL) return NULL;                                                \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) tmpEntries[size];                                  \
+    memcpy(tmpEntries, entries, sizeof(tmpEntries));                                                \
+    map = HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMap)(map, entries, ctrl, capacity);      \
+    for (uint32_t i = 0; map != NULL && i < size; i++) {                                            \
+        HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(map, tmpEntries[i].key, tmpEntries[i].value); \
+    }                                                                                               \
+    return map;                                                                                     \
+}                                                                                                   \
+\
+static inline uint32_t HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapSize)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return map != NULL ? map->size : 0; \
+}   \
+\
+static inline bool HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return map != NULL ? map->size == 0 : true; \
+}   \
+\
+static inline bool HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {   \
+    return !HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(map);        \
+}   \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapContains)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(map)) {                                      \
+        uint32_t hash = hashMix32(HASH_MAP_KEY_HASH_CODE(HASH_FUN, key, map->seed));                \
+        return HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapSlot)(map, key, hash, NULL) != map->capacity; \
+    }               \
+    return false;   \
+}                   \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetOrDefault)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE defaultValue) { \
+    if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(map)) {                                          \
+        uint32_t hash = hashMix32(HASH_MAP_KEY_HASH_CODE(HASH_FUN, key, map->seed));                    \
+        uint32_t index = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapSlot)(map, key, hash, NULL);            \
+        return index != map->capacity ? map->entries[index].value : defaultValue;                               \
+    }                           \
+    return defaultValue;        \
+}                               \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGet)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) {    \
+    return HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetOrDefault)(map, key, (VALUE_TYPE) {0});                                          \
+}                               \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRemove)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(map)) {                                          \
+        uint32_t hash = hashMix32(HASH_MAP_KEY_HASH_CODE(HASH_FUN, key, map->seed));                    \
+        uint32_t index = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapSlot)(map, key, hash, NULL);            \
+        if (index == map->capacity) return (VALUE_TYPE) {0};                                                    \
+        VALUE_TYPE value = map->entries[index].value;                                                           \
+        map->entries[index].key = (KEY_TYPE) {0};                                                               \
+        map->entries[index].value = (VALUE_TYPE) {0};                                                           \
+                                                                                                                \
+        const uint8_t *group = &map->ctrl[index & ~(HASH_MAP_GROUP_WIDTH - 1)];                                 \
+        if (hashMapCtrlMatch(group, HASH_MAP_CTRL_EMPTY) != 0) {  /* Group was never full, so no probe passed it and tombstone is not needed */ \
+            map->ctrl[index] = HASH_MAP_CTRL_EMPTY;             \
+        } else {                                                \
+            map->ctrl[index] = HASH_MAP_CTRL_DELETED;           \
+            map->deletedItemsCount++;                           \
+        }                                                       \
+        map->size--;                                            \
+        return value;                                           \
+    }                                                           \
+    return (VALUE_TYPE) {0};                                    \
+}                                                               \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapClear)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {    \
+    if (map != NULL && map->ctrl != NULL) {                     \
+        memset(map->ctrl, HASH_MAP_CTRL_EMPTY, map->capacity);  \
+        map->size = 0;                                          \
+        map->deletedItemsCount = 0;                             \
+    }                                                           \
+}                                                               \
+\
+static inline HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapIter)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) { \
+    HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) iterator = {.map = map, .index = 0};    \
+    return iterator;    \
+}                       \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHasNext)(HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) *iterator) { \
+    if (iterator != NULL && iterator->map != NULL) {            \
+        HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map = iterator->map;  \
+        while (iterator->index < map->capacity) {               \
+            uint32_t indexValue = iterator->index;              \
+            iterator->index++;                                  \
+                                                                \
+            if ((map->ctrl[indexValue] & HASH_MAP_CTRL_EMPTY) == 0) { \
+                iterator->key = map->entries[indexValue].key;     \
+                iterator->value = map->entries[indexValue].value; \
+                return true;                                    \
+            }                       \
+        }                           \
+        return false;               \
+    }                               \
+    return false;                   \
+}                                   \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAddAll)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *fromMap, HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *toMap) {  \
+    HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) iterator = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapIter)(fromMap);   \
+    while (HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHasNext)(&iterator)) {                  \
+        HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(toMap, iterator.key, iterator.value); \
+    }       \
+}           \
+
+
+
+#define CREATE_CTRL_HASH_MAP_TYPE_1(KEY_TYPE, VALUE_TYPE) CREATE_CTRL_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_TYPE, VALUE_TYPE, COMPARATOR_FOR_TYPE(KEY_TYPE), HASH_CODE_FOR_TYPE(KEY_TYPE))
+#define CREATE_CTRL_HASH_MAP_TYPE_2(KEY_TYPE, VALUE_TYPE, KEY_NAME) CREATE_CTRL_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, COMPARATOR_FOR_TYPE(KEY_TYPE), HASH_CODE_FOR_TYPE(KEY_TYPE))
+#define CREATE_CTRL_HASH_MAP_TYPE_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME) CREATE_CTRL_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARATOR_FOR_TYPE(KEY_TYPE), HASH_CODE_FOR_TYPE(KEY_TYPE))
+#define CREATE_CTRL_HASH_MAP_TYPE_4(KEY_TYPE, VALUE_TYPE, KEY_NAME, COMPARE_FUN, HASH_FUN) CREATE_CTRL_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, COMPARE_FUN, HASH_FUN)
+#define CREATE_CTRL_HASH_MAP_TYPE_5(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN) CREATE_CTRL_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN)
+
+#define CREATE_CTRL_HASH_MAP_TYPE(...)                                \
+    CREATE_HASH_MAP_TYPE_MACRO(__VA_ARGS__,                           \
+                        CREATE_CTRL_HASH_MAP_TYPE_5,                  \
+                        CREATE_CTRL_HASH_MAP_TYPE_4,                  \
+                        CREATE_CTRL_HASH_MAP_TYPE_3,                  \
+                        CREATE_CTRL_HASH_MAP_TYPE_2,                  \
+                        CREATE_CTRL_HASH_MAP_TYPE_1,                  \
+                        ERROR)(__VA_ARGS__)
+
+
+#define NEW_CTRL_HASH_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, CAPACITY) \
+HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMap)(&(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME)){0}, \
+                                                       (HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) [CTRL_HASH_MAP_ALIGN_CAPACITY(CAPACITY)]){0}, \
+                                                       (uint8_t [CTRL_HASH_MAP_ALIGN_CAPACITY(CAPACITY)]){0}, \
+                                                        CTRL_HASH_MAP_ALIGN_CAPACITY(CAPACITY))
+#define NEW_CTRL_HASH_MAP_2(KEY_TYPE, VALUE_TYPE, KEY_NAME, CAPACITY) NEW_CTRL_HASH_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, CAPACITY)
+#define NEW_CTRL_HASH_MAP_1(KEY_TYPE, VALUE_TYPE, CAPACITY) NEW_CTRL_HASH_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_TYPE, VALUE_TYPE, CAPACITY)
+
+#define NEW_CTRL_HASH_MAP(...)                                \
+    NEW_HASH_MAP_MACRO(__VA_ARGS__,                           \
+                        NEW_CTRL_HASH_MAP_3,                  \
+                        NEW_CTRL_HASH_MAP_2,                  \
+                        NEW_CTRL_HASH_MAP_1,                  \
+                        ERROR)(__VA_ARGS__)
+
+#define NEW_CTRL_HASH_MAP_4(...)    NEW_CTRL_HASH_MAP(__VA_ARGS__, 4)
+#define NEW_CTRL_HASH_MAP_8(...)    NEW_CTRL_HASH_MAP(__VA_ARGS__, 8)
+#define NEW_CTRL_HASH_MAP_16(...)   NEW_CTRL_HASH_MAP(__VA_ARGS__, 16)
+#define NEW_CTRL_HASH_MAP_32(...)   NEW_CTRL_HASH_MAP(__VA_ARGS__, 32)
+#define NEW_CTRL_HASH_MAP_64(...)   NEW_CTRL_HASH_MAP(__VA_ARGS__, 64)
+#define NEW_CTRL_HASH_MAP_128(...)  NEW_CTRL_HASH_MAP(__VA_ARGS__, 128)
+#define NEW_CTRL_HASH_MAP_256(...)  NEW_CTRL_HASH_MAP(__VA_ARGS__, 256)
+#define NEW_CTRL_HASH_MAP_512(...)  NEW_CTRL_HASH_MAP(__VA_ARGS__, 512)
+#define NEW_CTRL_HASH_MAP_1024(...) NEW_CTRL_HASH_MAP(__VA_ARGS__, 1024)
+
+#define NEW_CTRL_HASH_MAP_OF(CAPACITY, KEY_NAME, VALUE_NAME, ...) \
+HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMapOf)(&(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME)){0}, \
+                                                         (HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) [CTRL_HASH_MAP_ALIGN_CAPACITY(CAPACITY)]){__VA_ARGS__}, \
+                                                         (uint8_t [CTRL_HASH_MAP_ALIGN_CAPACITY(CAPACITY)]){0}, \
+                                                          CTRL_HASH_MAP_ALIGN_CAPACITY(CAPACITY),      \
+                                                          VAR_ARGS_LENGTH(HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME), __VA_ARGS__))
+
+#define CTRL_HASH_MAP_OF(KEY_NAME, VALUE_NAME, ...) HASH_MAP_OF_WITH(NEW_CTRL_HASH_MAP_OF, KEY_NAME, VALUE_NAME, __VA_ARGS__)
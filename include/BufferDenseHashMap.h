@@ -0,0 +1,256 @@
+#pragma once
+
+#include "BufferHashMap.h"
+
+// Alternative BufferHashMap layout: hash table slots keep only indexes into the dense array of entries.
+// Iteration, AddAll and Clear touch `size` entries instead of every slot, so drained or sparse maps stay cheap to walk.
+// Entries are kept in insertion order until removal, which moves the last entry to the freed place.
+
+#define DENSE_HASH_MAP_EMPTY_SLOT 0    // slot keeps entry index + 1
+#define DENSE_HASH_MAP_ENTRIES_CAPACITY(CAPACITY) (HASH_MAP_ALIGN_CAPACITY(CAPACITY) / HASH_MAP_EXPAND_FACTOR)
+
+
+#define CREATE_DENSE_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN) \
+typedef struct HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) { \
+    KEY_TYPE key;               \
+    VALUE_TYPE value;           \
+    uint32_t hash;              \
+} HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME); \
+\
+typedef struct HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) { \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries;  /* capacity / 2 entries, first `size` are used */ \
+    uint32_t *slots;                \
+    uint32_t size;                  \
+    uint32_t capacity;              \
+    uint32_t deletedItemsCount;     /* always 0, no tombstones are used */ \
+    uint32_t seed;                  \
+} HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME); \
+\
+typedef struct HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) {    \
+    KEY_TYPE key;                                                   \
+    VALUE_TYPE value;                                               \
+    HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map;                    \
+    uint32_t index;                                                 \
+} HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME);                  \
+                                                                    \
+static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMap)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint32_t *slots, uint32_t capacity) { \
+    if (map == NULL) return NULL;       \
+    map->entries = entries;             \
+    map->slots = slots;                 \
+    map->size = 0;                      \
+    map->capacity = capacity;           \
+    map->deletedItemsCount = 0;         \
+    map->seed = HASH_MAP_NEW_SEED();    \
+    memset(slots, DENSE_HASH_MAP_EMPTY_SLOT, capacity * sizeof(uint32_t)); \
+    return map;                         \
+}                                       \
+\
+static inline uint32_t HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapSlot)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, uint32_t hash) { \
+    uint32_t index = hash & (map->capacity - 1);                \
+    while (map->slots[index] != DENSE_HASH_MAP_EMPTY_SLOT) {    \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = &map->entries[map->slots[index] - 1]; \
+        if (entry->hash == hash && COMPARE_FUN(key, entry->key) == 0) { \
+            return index;                                       \
+        }                                                       \
+        index = (index + 1) & (map->capacity - 1);              \
+    }                                                           \
+    return index;   /* Empty slot where key can be placed */    \
+}                                                               \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE value) {   \
+    if (map != NULL && (map->size < (map->capacity / HASH_MAP_EXPAND_FACTOR))) {                           \
+        uint32_t hash = HASH_MAP_KEY_HASH_CODE(HASH_FUN, key, map->seed);                               \
+        uint32_t index = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapSlot)(map, key, hash);             \
+        if (map->slots[index] != DENSE_HASH_MAP_EMPTY_SLOT) {  \
+            map->entries[map->slots[index] - 1].value = value; \
+            return false;                                       \
+        }                                                       \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = &map->entries[map->size]; \
+        entry->key = key;                                       \
+        entry->value = value;                                   \
+        entry->hash = hash;                                     \
+        map->size++;                                            \
+        map->slots[index] = map->size;                          \
+        return true;                                            \
+    }                                                           \
+    return false;                                               \
+}                                                               \
+\
+static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMapOf)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint32_t *slots, uint32_t capacity, uint32_t size) { \
+    if (map == NULL || entries == NULL) return NULL;                                                \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) tmpEntries[size];                                  \
+    memcpy(tmpEntries, entries, sizeof(tmpEntries));                                                \
+    map = HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMap)(map, entries, slots, capacity);     \
+    for (uint32_t i = 0; i < size; i++) {                                                           \
+        HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(map, tmpEntries[i].key, tmpEntries[i].value); \
+    }                                                                                               \
+    return map;                                                                                     \
+}                                                                                                   \
+\
+static inline uint32_t HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapSize)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return map != NULL ? map->size : 0; \
+}   \
+\
+static inline bool HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return map != NULL ? map->size == 0 : true; \
+}   \
+\
+static inline bool HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {   \
+    return !HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(map);        \
+}   \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapContains)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(map)) {                              \
+        uint32_t hash = HASH_MAP_KEY_HASH_CODE(HASH_FUN, key, map->seed);                       \
+        uint32_t index = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapSlot)(map, key, hash);     \
+        return map->slots[index] != DENSE_HASH_MAP_EMPTY_SLOT;                                      \
+    }               \
+    return false;   \
+}                   \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetOrDefault)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE defaultValue) { \
+    if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(map)) {                              \
+        uint32_t hash = HASH_MAP_KEY_HASH_CODE(HASH_FUN, key, map->seed);                       \
+        uint32_t index = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapSlot)(map, key, hash);     \
+        uint32_t slot = map->slots[index];                                                          \
+        return slot != DENSE_HASH_MAP_EMPTY_SLOT ? map->entries[slot - 1].value : defaultValue;     \
+    }                           \
+    return defaultValue;        \
+}                               \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGet)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) {    \
+    return HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetOrDefault)(map, key, (VALUE_TYPE) {0});                                          \
+}                               \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRemove)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(map)) {                              \
+        uint32_t mask = map->capacity - 1;                                                          \
+        uint32_t hash = HASH_MAP_KEY_HASH_CODE(HASH_FUN, key, map->seed);                       \
+        uint32_t hole = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapSlot)(map, key, hash);      \
+        if (map->slots[hole] == DENSE_HASH_MAP_EMPTY_SLOT) return (VALUE_TYPE) {0};                \
+        uint32_t entryIndex = map->slots[hole] - 1;                                                 \
+        VALUE_TYPE value = map->entries[entryIndex].value;                                          \
+                                                                                                    \
+        uint32_t next = (hole + 1) & mask;                                                          \
+        while (map->slots[next] != DENSE_HASH_MAP_EMPTY_SLOT) {  /* Backward shift, slot can take the hole if its home is not between hole and itself */ \
+            uint32_t home = map->entries[map->slots[next] - 1].hash & mask;                         \
+            if (((next - home) & mask) >= ((next - hole) & mask)) {                                 \
+                map->slots[hole] = map->slots[next];                                                \
+                hole = next;                                                                        \
+            }                                                                                       \
+            next = (next + 1) & mask;                                                               \
+        }                                                                                           \
+        map->slots[hole] = DENSE_HASH_MAP_EMPTY_SLOT;                                               \
+                                                                                                    \
+        uint32_t lastIndex = map->size - 1;                                                         \
+        if (entryIndex != lastIndex) {  /* Fill the gap with the last entry and point its slot to the new place */ \
+            map->entries[entryIndex] = map->entries[lastIndex];                                     \
+            uint32_t index = map->entries[entryIndex].hash & mask;                                  \
+            while (map->slots[index] != lastIndex + 1) {                                            \
+                index = (index + 1) & mask;                                                         \
+            }                                                                                       \
+            map->slots[index] = entryIndex + 1;                                                     \
+        }                                                                                           \
+        map->entries[lastIndex].key = (KEY_TYPE) {0};                                               \
+        map->entries[lastIndex].value = (VALUE_TYPE) {0};                                           \
+        map->size--;                                                                                \
+        return value;                                                                               \
+    }                                                                                               \
+    return (VALUE_TYPE) {0};                                                                        \
+}                                                                                                   \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapClear)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {    \
+    if (map != NULL && map->slots != NULL) {                        \
+        uint32_t mask = map->capacity - 1;                          \
+        for (uint32_t i = 0; i < map->size; i++) {  /* Only slots of live entries are reset, other slots are already empty */ \
+            uint32_t index = map->entries[i].hash & mask;           \
+            while (map->slots[index] != i + 1) {                    \
+                index = (index + 1) & mask;                         \
+            }                                                       \
+            map->slots[index] = DENSE_HASH_MAP_EMPTY_SLOT;          \
+            map->entries[i].key = (KEY_TYPE) {0};                   \
+            map->entries[i].value = (VALUE_TYPE) {0};               \
+        }                                                           \
+        map->size = 0;                                              \
+    }                                                               \
+}                                                                   \
+\
+static inline HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapIter)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) { \
+    HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) iterator = {.map = map, .index = 0};    \
+    return iterator;    \
+}                       \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHasNext)(HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) *iterator) { \
+    if (iterator != NULL && iterator->map != NULL) {                \
+        HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map = iterator->map;  \
+        if (iterator->index > 0 && iterator->index <= map->size &&  /* Previous entry was removed and last one moved to its place */ \
+            COMPARE_FUN(iterator->key, map->entries[iterator->index - 1].key) != 0) { \
+            iterator->index--;                                      \
+        }                                                           \
+        if (iterator->index < map->size) {                          \
+            iterator->key = map->entries[iterator->index].key;      \
+            iterator->value = map->entries[iterator->index].value;  \
+            iterator->index++;                                      \
+            return true;                                            \
+        }                                                           \
+    }                                                               \
+    return false;                                                   \
+}                                                                   \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAddAll)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *fromMap, HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *toMap) {  \
+    for (uint32_t i = 0; i < fromMap->size; i++) {                                                        \
+        HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(toMap, fromMap->entries[i].key, fromMap->entries[i].value); \
+    }       \
+}           \
+
+
+
+#define CREATE_DENSE_HASH_MAP_TYPE_1(KEY_TYPE, VALUE_TYPE) CREATE_DENSE_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_TYPE, VALUE_TYPE, COMPARATOR_FOR_TYPE(KEY_TYPE), HASH_CODE_FOR_TYPE(KEY_TYPE))
+#define CREATE_DENSE_HASH_MAP_TYPE_2(KEY_TYPE, VALUE_TYPE, KEY_NAME) CREATE_DENSE_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, COMPARATOR_FOR_TYPE(KEY_TYPE), HASH_CODE_FOR_TYPE(KEY_TYPE))
+#define CREATE_DENSE_HASH_MAP_TYPE_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME) CREATE_DENSE_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARATOR_FOR_TYPE(KEY_TYPE), HASH_CODE_FOR_TYPE(KEY_TYPE))
+#define CREATE_DENSE_HASH_MAP_TYPE_4(KEY_TYPE, VALUE_TYPE, KEY_NAME, COMPARE_FUN, HASH_FUN) CREATE_DENSE_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, COMPARE_FUN, HASH_FUN)
+#define CREATE_DENSE_HASH_MAP_TYPE_5(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN) CREATE_DENSE_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN)
+
+#define CREATE_DENSE_HASH_MAP_TYPE(...)                                \
+    CREATE_HASH_MAP_TYPE_MACRO(__VA_ARGS__,                            \
+                        CREATE_DENSE_HASH_MAP_TYPE_5,                  \
+                        CREATE_DENSE_HASH_MAP_TYPE_4,                  \
+                        CREATE_DENSE_HASH_MAP_TYPE_3,                  \
+                        CREATE_DENSE_HASH_MAP_TYPE_2,                  \
+                        CREATE_DENSE_HASH_MAP_TYPE_1,                  \
+                        ERROR)(__VA_ARGS__)
+
+
+#define NEW_DENSE_HASH_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, CAPACITY) \
+HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMap)(&(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME)){0}, \
+                                                       (HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) [DENSE_HASH_MAP_ENTRIES_CAPACITY(CAPACITY)]){0}, \
+                                                       (uint32_t [HASH_MAP_ALIGN_CAPACITY(CAPACITY)]){0}, \
+                                                        HASH_MAP_ALIGN_CAPACITY(CAPACITY))
+#define NEW_DENSE_HASH_MAP_2(KEY_TYPE, VALUE_TYPE, KEY_NAME, CAPACITY) NEW_DENSE_HASH_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, CAPACITY)
+#define NEW_DENSE_HASH_MAP_1(KEY_TYPE, VALUE_TYPE, CAPACITY) NEW_DENSE_HASH_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_TYPE, VALUE_TYPE, CAPACITY)
+
+#define NEW_DENSE_HASH_MAP(...)                                \
+    NEW_HASH_MAP_MACRO(__VA_ARGS__,                            \
+                        NEW_DENSE_HASH_MAP_3,                  \
+                        NEW_DENSE_HASH_MAP_2,                  \
+                        NEW_DENSE_HASH_MAP_1,                  \
+                        ERROR)(__VA_ARGS__)
+
+#define NEW_DENSE_HASH_MAP_4(...)    NEW_DENSE_HASH_MAP(__VA_ARGS__, 4)
+#define NEW_DENSE_HASH_MAP_8(...)    NEW_DENSE_HASH_MAP(__VA_ARGS__, 8)
+#define NEW_DENSE_HASH_MAP_16(...)   NEW_DENSE_HASH_MAP(__VA_ARGS__, 16)
+#define NEW_DENSE_HASH_MAP_32(...)   NEW_DENSE_HASH_MAP(__VA_ARGS__, 32)
+#define NEW_DENSE_HASH_MAP_64(...)   NEW_DENSE_HASH_MAP(__VA_ARGS__, 64)
+#define NEW_DENSE_HASH_MAP_128(...)  NEW_DENSE_HASH_MAP(__VA_ARGS__, 128)
+#define NEW_DENSE_HASH_MAP_256(...)  NEW_DENSE_HASH_MAP(__VA_ARGS__, 256)
+#define NEW_DENSE_HASH_MAP_512(...)  NEW_DENSE_HASH_MAP(__VA_ARGS__, 512)
+#define NEW_DENSE_HASH_MAP_1024(...) NEW_DENSE_HASH_MAP(__VA_ARGS__, 1024)
+
+#define NEW_DENSE_HASH_MAP_OF(CAPACITY, KEY_NAME, VALUE_NAME, ...) \
+HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMapOf)(&(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME)){0}, \
+                                                         (HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) [DENSE_HASH_MAP_ENTRIES_CAPACITY(CAPACITY)]){__VA_ARGS__}, \
+                                                         (uint32_t [HASH_MAP_ALIGN_CAPACITY(CAPACITY)]){0}, \
+                                                          HASH_MAP_ALIGN_CAPACITY(CAPACITY),      \
+                                                          VAR_ARGS_LENGTH(HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME), __VA_ARGS__))
+
+#define DENSE_HASH_MAP_OF(KEY_NAME, VALUE_NAME, ...) HASH_MAP_OF_WITH(NEW_DENSE_HASH_MAP_OF, KEY_NAME, VALUE_NAME, __VA_ARGS__)
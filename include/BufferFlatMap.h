@@ -0,0 +1,247 @@
+#pragma once
+
+#include "BufferVector.h"
+#include "BufferHashMap.h"
+
+// Alternative Map layout for small, read-heavy maps: entries are kept sorted by key in a single BufferVector without empty slots.
+// Lookup is a branchless binary search, so there is no 2x `HASH_MAP_EXPAND_FACTOR` slack and no hash function, and for up to
+// ~64 entries the whole map usually takes a few cache lines. Add and Remove shift entries after the key, iteration is in key order.
+
+#define FLAT_MAP_ENTRIES_TYPEDEF(KEY_NAME, VALUE_NAME) KEY_NAME ## _ ## VALUE_NAME ## MapEntryVector
+#define FLAT_MAP_ENTRIES_METHOD(KEY_NAME, VALUE_NAME, POSTFIX) KEY_NAME ## _ ## VALUE_NAME ## MapEntryVec ## POSTFIX
+#define FLAT_MAP_NEW_ENTRIES(KEY_NAME, VALUE_NAME) new ## KEY_NAME ## _ ## VALUE_NAME ## MapEntryBuffVector
+#define FLAT_MAP_NEW_ENTRIES_OF(KEY_NAME, VALUE_NAME) new ## KEY_NAME ## _ ## VALUE_NAME ## MapEntryBuffVectorOf
+
+#define CREATE_FLAT_MAP_ENTRIES_VECTOR(ENTRY_TYPE, COMPARE_FUN) CREATE_VECTOR_TYPE_NAME(ENTRY_TYPE, ENTRY_TYPE, COMPARE_FUN)
+
+// Entry type and sorted array helpers shared by buffer and heap flat maps
+#define CREATE_FLAT_MAP_ENTRY_TYPE(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN) \
+typedef struct HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) { \
+    KEY_TYPE key;               \
+    VALUE_TYPE value;           \
+} HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME); \
+\
+static inline int HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapEntryComparator)(HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) one, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) two) { \
+    return COMPARE_FUN(one.key, two.key);   \
+}                                           \
+\
+static inline uint32_t HASH_MAP_METHOD(lowerBound, KEY_NAME, VALUE_NAME, MapEntries)(const HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint32_t size, KEY_TYPE key) { \
+    if (size == 0) return 0;                                            \
+    const HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *base = entries; \
+    while (size > 1) {  /* No early exit on match, compare result only selects next base, so compiler emits cmov instead of branch */ \
+        uint32_t half = size / 2;                                       \
+        base = COMPARE_FUN(base[half].key, key) < 0 ? &base[half] : base; \
+        size -= half;                                                   \
+    }                                                                   \
+    return (uint32_t) (base - entries) + (COMPARE_FUN(base->key, key) < 0); \
+}                                                                       \
+\
+static inline bool HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEntriesSorted)(const HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint32_t size) { \
+    for (uint32_t i = 1; i < size; i++) {                       \
+        if (COMPARE_FUN(entries[i - 1].key, entries[i].key) > 0) {  \
+            return false;                                       \
+        }                                                       \
+    }                                                           \
+    return true;                                                \
+}                                                               \
+\
+static inline void HASH_MAP_METHOD(sort, KEY_NAME, VALUE_NAME, MapEntries)(HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint32_t size) { \
+    for (uint32_t i = 1; i < size; i++) {   /* Insertion sort is stable, so equal keys keep input order, unlike qsort() */ \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) entry = entries[i];    \
+        uint32_t j = i;                                                     \
+        while (j > 0 && COMPARE_FUN(entries[j - 1].key, entry.key) > 0) {   \
+            entries[j] = entries[j - 1];                                    \
+            j--;                                                            \
+        }                                                                   \
+        entries[j] = entry;                                                 \
+    }                                                                       \
+}                                                                           \
+\
+static inline uint32_t HASH_MAP_METHOD(unique, KEY_NAME, VALUE_NAME, MapEntries)(HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint32_t size) { \
+    uint32_t count = 0;                                     \
+    for (uint32_t i = 0; i < size; i++) {   /* Equal keys are adjacent in sorted entries, the last of them is kept */ \
+        if (count > 0 && COMPARE_FUN(entries[count - 1].key, entries[i].key) == 0) {  \
+            entries[count - 1] = entries[i];                \
+        } else {                                            \
+            entries[count++] = entries[i];                  \
+        }                                                   \
+    }                                                       \
+    return count;                                           \
+}                                                           \
+
+
+#define CREATE_FLAT_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN) \
+CREATE_FLAT_MAP_ENTRY_TYPE(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN) \
+CREATE_FLAT_MAP_ENTRIES_VECTOR(HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME), HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapEntryComparator)) \
+\
+typedef struct HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) { \
+    FLAT_MAP_ENTRIES_TYPEDEF(KEY_NAME, VALUE_NAME) entries;  /* sorted by key, unique keys */ \
+} HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME); \
+\
+typedef struct HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) {    \
+    KEY_TYPE key;                                                   \
+    VALUE_TYPE value;                                               \
+    HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map;                    \
+    uint32_t index;                                                 \
+    uint32_t endIndex;                                              \
+} HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME);                  \
+                                                                    \
+static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferFlatMap)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint32_t capacity) { \
+    if (map == NULL || entries == NULL) return NULL;    \
+    return FLAT_MAP_NEW_ENTRIES(KEY_NAME, VALUE_NAME)(&map->entries, entries, capacity) != NULL ? map : NULL; \
+}                                                       \
+\
+static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferFlatMapOf)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint32_t capacity, uint32_t size) { \
+    if (map == NULL || entries == NULL || FLAT_MAP_NEW_ENTRIES_OF(KEY_NAME, VALUE_NAME)(&map->entries, entries, capacity, size) == NULL) return NULL; \
+    if (!HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEntriesSorted)(entries, size)) {  /* Initial entries are sorted in place, in the same buffer */ \
+        HASH_MAP_METHOD(sort, KEY_NAME, VALUE_NAME, MapEntries)(entries, size);         \
+    }                                                                                   \
+    map->entries.size = HASH_MAP_METHOD(unique, KEY_NAME, VALUE_NAME, MapEntries)(entries, size); \
+    return map;                                                                         \
+}                                                                                       \
+\
+static inline uint32_t HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapLowerBound)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    return map != NULL ? HASH_MAP_METHOD(lowerBound, KEY_NAME, VALUE_NAME, MapEntries)(map->entries.items, map->entries.size, key) : 0; \
+}                                   \
+\
+static inline HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    uint32_t index = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapLowerBound)(map, key);   \
+    if (map != NULL && index < map->entries.size && COMPARE_FUN(map->entries.items[index].key, key) == 0) { \
+        return &map->entries.items[index];  \
+    }                                       \
+    return NULL;                            \
+}                                           \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE value) {   \
+    if (map == NULL) return false;          \
+    uint32_t index = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapLowerBound)(map, key); \
+    if (index < map->entries.size && COMPARE_FUN(map->entries.items[index].key, key) == 0) {   \
+        map->entries.items[index].value = value;    /* Existing key is updated even when map is full */ \
+        return false;                               \
+    }                                               \
+    return FLAT_MAP_ENTRIES_METHOD(KEY_NAME, VALUE_NAME, AddAt)(&map->entries, index, (HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME)) {.key = key, .value = value}); \
+}                                           \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapFromArray)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) entries[], uint32_t length) { \
+    if (map == NULL || (entries == NULL && length > 0) || length > map->entries.capacity) return false; \
+    map->entries.size = 0;                                                          \
+    FLAT_MAP_ENTRIES_METHOD(KEY_NAME, VALUE_NAME, FromArray)(&map->entries, entries, length); \
+    if (!HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEntriesSorted)(map->entries.items, length)) {  /* Sorted input is only copied, other is sorted once */ \
+        HASH_MAP_METHOD(sort, KEY_NAME, VALUE_NAME, MapEntries)(map->entries.items, length); \
+    }                                                                               \
+    map->entries.size = HASH_MAP_METHOD(unique, KEY_NAME, VALUE_NAME, MapEntries)(map->entries.items, length); \
+    return true;                                                                    \
+}                                                                                   \
+\
+static inline uint32_t HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapSize)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return FLAT_MAP_ENTRIES_METHOD(KEY_NAME, VALUE_NAME, Size)(map != NULL ? &map->entries : NULL); \
+}   \
+\
+static inline bool HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapSize)(map) == 0; \
+}   \
+\
+static inline bool HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return !HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(map); \
+}   \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapContains)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    return HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key) != NULL; \
+}  \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGet)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) {    \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key);  \
+    return entry != NULL ? entry->value : (VALUE_TYPE) {0};     \
+}                                   \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetOrDefault)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE defaultValue) { \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key);  \
+    return entry != NULL ? entry->value : defaultValue;         \
+}                                   \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRemove)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key);  \
+    if (entry == NULL) return (VALUE_TYPE) {0};                 \
+    VALUE_TYPE value = entry->value;                            \
+    FLAT_MAP_ENTRIES_METHOD(KEY_NAME, VALUE_NAME, RemoveAt)(&map->entries, (uint32_t) (entry - map->entries.items)); \
+    return value;                                               \
+}                                                               \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAddAll)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *fromMap, HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *toMap) {  \
+    if (fromMap == NULL || toMap == NULL) return;               \
+    for (uint32_t i = 0; i < fromMap->entries.size; i++) {     /* Keys come in order, so tail of destination is shifted at most once per key */ \
+        HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(toMap, fromMap->entries.items[i].key, fromMap->entries.items[i].value); \
+    }                                                           \
+}                                                               \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapClear)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {    \
+    if (map != NULL) {                                          \
+        FLAT_MAP_ENTRIES_METHOD(KEY_NAME, VALUE_NAME, Clear)(&map->entries);  \
+    }                                                           \
+}                                                               \
+\
+static inline HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapIter)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) { \
+    HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) iterator = {.map = map, .index = 0, .endIndex = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapSize)(map)}; \
+    return iterator;    \
+}                       \
+\
+static inline HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRangeIter)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE fromKey, KEY_TYPE toKey) { \
+    HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) iterator = {.map = map};                        \
+    iterator.index = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapLowerBound)(map, fromKey);            \
+    iterator.endIndex = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapLowerBound)(map, toKey);   /* toKey itself is excluded */ \
+    return iterator;    \
+}                       \
+\
+static inline uint32_t HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRangeSize)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE fromKey, KEY_TYPE toKey) { \
+    HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) iterator = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRangeIter)(map, fromKey, toKey); \
+    return iterator.endIndex > iterator.index ? iterator.endIndex - iterator.index : 0; \
+}                       \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHasNext)(HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) *iterator) { \
+    if (iterator != NULL && iterator->map != NULL && iterator->index < iterator->endIndex && iterator->index < iterator->map->entries.size) { \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *pair = &iterator->map->entries.items[iterator->index++]; \
+        iterator->key = pair->key;          \
+        iterator->value = pair->value;      \
+        return true;                        \
+    }                                       \
+    return false;                           \
+}                                           \
+
+
+
+#define CREATE_FLAT_MAP_TYPE_1(KEY_TYPE, VALUE_TYPE) CREATE_FLAT_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_TYPE, VALUE_TYPE, COMPARATOR_FOR_TYPE(KEY_TYPE))
+#define CREATE_FLAT_MAP_TYPE_2(KEY_TYPE, VALUE_TYPE, KEY_NAME) CREATE_FLAT_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, COMPARATOR_FOR_TYPE(KEY_TYPE))
+#define CREATE_FLAT_MAP_TYPE_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME) CREATE_FLAT_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARATOR_FOR_TYPE(KEY_TYPE))
+#define CREATE_FLAT_MAP_TYPE_4(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN) CREATE_FLAT_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN)
+#define CREATE_FLAT_MAP_TYPE_MACRO(_1, _2, _3, _4, _5, FUN, ...) FUN
+
+#define CREATE_FLAT_MAP_TYPE(...)                                     \
+    CREATE_FLAT_MAP_TYPE_MACRO(__VA_ARGS__,                           \
+                        CREATE_FLAT_MAP_TYPE_4,                       \
+                        CREATE_FLAT_MAP_TYPE_3,                       \
+                        CREATE_FLAT_MAP_TYPE_2,                       \
+                        CREATE_FLAT_MAP_TYPE_1,                       \
+                        ERROR)(__VA_ARGS__)
+
+
+#define NEW_FLAT_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, CAPACITY) \
+HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferFlatMap)(&(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME)){0}, \
+                                                           (HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) [CAPACITY]){0}, \
+                                                            CAPACITY)
+#define NEW_FLAT_MAP_2(KEY_TYPE, VALUE_TYPE, KEY_NAME, CAPACITY) NEW_FLAT_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, CAPACITY)
+#define NEW_FLAT_MAP_1(KEY_TYPE, VALUE_TYPE, CAPACITY) NEW_FLAT_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_TYPE, VALUE_TYPE, CAPACITY)
+
+#define NEW_FLAT_MAP(...)                                     \
+    NEW_HASH_MAP_MACRO(__VA_ARGS__,                           \
+                        NEW_FLAT_MAP_3,                       \
+                        NEW_FLAT_MAP_2,                       \
+                        NEW_FLAT_MAP_1,                       \
+                        ERROR)(__VA_ARGS__)
+
+#define NEW_FLAT_MAP_OF(CAPACITY, KEY_NAME, VALUE_NAME, ...) \
+HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferFlatMapOf)(&(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME)){0}, \
+                                                             (HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) [CAPACITY]){__VA_ARGS__}, \
+                                                              CAPACITY,    \
+                                                              VAR_ARGS_LENGTH(HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME), __VA_ARGS__))
+
+#define FLAT_MAP_OF(KEY_NAME, VALUE_NAME, ...) HASH_MAP_OF_WITH(NEW_FLAT_MAP_OF, KEY_NAME, VALUE_NAME, __VA_ARGS__)
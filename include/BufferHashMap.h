@@ -2,11 +2,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include "Comparator.h"
+#include "HashTableCommon.h"
 
 #define HASH_MAP_EXPAND_FACTOR 2
 #define HASH_MAP_BUFFER_EXPAND_FACTOR(CAPACITY) ((CAPACITY) * HASH_MAP_EXPAND_FACTOR)
 #define HASH_MAP_ALIGN_CAPACITY(CAPACITY) (NEXT_POW_OF_2(HASH_MAP_BUFFER_EXPAND_FACTOR(CAPACITY)))
+#define HASH_MAP_TOMBSTONE_PURGE_THRESHOLD(CAPACITY) ((CAPACITY) / 4)  // removed entries count that triggers in place rehash on add
 
 #define HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) KEY_NAME ## _ ## VALUE_NAME ## MapEntry
 #define HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) KEY_NAME ## _ ## VALUE_NAME ## Map
@@ -21,6 +22,23 @@
                         HASH_MAP_METHOD_NAME_1,                  \
                         ERROR)(__VA_ARGS__)                      \
 
+#ifdef HASH_MAP_STATS
+#define CREATE_HASH_MAP_STATS_METHOD(KEY_NAME, VALUE_NAME) \
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetStats)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, HashTableStats *stats) { \
+    if (map == NULL || stats == NULL) return;   \
+    HASH_MAP_METHOD(sweep, KEY_NAME, VALUE_NAME, MapGenerations)(map);  \
+    hashStatsInit(stats, map->size, map->capacity, map->deletedItemsCount, map->resizeCount, sizeof(*map) + map->capacity * sizeof(map->entries[0])); \
+    for (uint32_t i = 0; i < map->capacity; i++) {  /* Probe lengths are measured on request, so lookups have no counting overhead */ \
+        if (!map->entries[i].isEmptySlot) {         \
+            hashStatsAddProbeLength(stats, (i - HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHomeIndex)(map, map->entries[i].key)) & (map->capacity - 1)); \
+        }                                           \
+    }                                               \
+    hashStatsComplete(stats);                       \
+}
+#else
+#define CREATE_HASH_MAP_STATS_METHOD(KEY_NAME, VALUE_NAME)
+#endif
+
 
 #define CREATE_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN) \
 typedef struct HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) { \
@@ -28,6 +46,7 @@ typedef struct HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) { \
     VALUE_TYPE value;           \
     bool isDeleted;             \
     bool isEmptySlot;           \
+    HASH_GENERATION_SLOT_FIELD  \
 } HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME); \
 \
 typedef struct HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) { \
@@ -35,6 +54,9 @@ typedef struct HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) { \
     uint32_t size;                  \
     uint32_t capacity;              \
     uint32_t deletedItemsCount;     \
+    uint32_t seed;                  \
+    HASH_STATS_RESIZE_COUNT_FIELD   \
+    HASH_GENERATION_TABLE_FIELDS    \
 } HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME); \
 \
 typedef struct HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) {    \
@@ -50,6 +72,9 @@ static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_
     map->size = 0;                      \
     map->capacity = capacity;           \
     map->deletedItemsCount = 0;         \
+    map->seed = HASH_MAP_NEW_SEED();    \
+    HASH_STATS_RESET_RESIZE_COUNT(map); \
+    HASH_GENERATION_RESET(map);         \
                                         \
     for (uint32_t i = 0; i < capacity; i++) {   \
         HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = &entries[i]; \
@@ -57,17 +82,38 @@ static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_
         entry->value = (VALUE_TYPE) {0};            \
         entry->isDeleted = false;                   \
         entry->isEmptySlot = true;                  \
+        HASH_GENERATION_STAMP(entry, 0);            \
     }                                               \
     return map;                                     \
 }                                                   \
 \
-static inline HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
-    uint32_t hash = HASH_FUN(key);                              \
-    uint32_t index = hash & (map->capacity - 1);                \
+static inline uint32_t HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHomeIndex)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    return HASH_MAP_KEY_HASH_CODE(HASH_FUN, key, map->seed) & (map->capacity - 1); \
+}                                                               \
+\
+static inline void HASH_MAP_METHOD(refresh, KEY_NAME, VALUE_NAME, MapEntry)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry) { \
+    (void) map;  /* used only with HASH_MAP_GENERATION_CLEAR */        \
+    if (HASH_GENERATION_IS_STALE(entry, HASH_GENERATION_OF(map))) {  /* Written before the last clear, becomes empty slot */ \
+        entry->isDeleted = false;                                   \
+        entry->isEmptySlot = true;                                  \
+        HASH_GENERATION_STAMP(entry, HASH_GENERATION_OF(map));      \
+    }                                                               \
+}                                                                   \
+\
+static inline void HASH_MAP_METHOD(sweep, KEY_NAME, VALUE_NAME, MapGenerations)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) { \
+    if (map == NULL || !HASH_GENERATION_HAS_STALE_SLOTS(map)) return;   /* Called before walking all slots, so costs no extra complexity */ \
+    for (uint32_t i = 0; i < map->capacity; i++) {                  \
+        HASH_MAP_METHOD(refresh, KEY_NAME, VALUE_NAME, MapEntry)(map, &map->entries[i]); \
+    }                                                               \
+    HASH_GENERATION_SWEPT(map);                                     \
+}                                                                   \
+\
+static inline HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntryFrom)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, uint32_t index) { \
     HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *tombstone = NULL;     \
                                                                 \
     while (true) {                                              \
         HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = &map->entries[index]; \
+        HASH_MAP_METHOD(refresh, KEY_NAME, VALUE_NAME, MapEntry)(map, entry); \
         if (entry->isEmptySlot) {                               \
             if (!entry->isDeleted) {                            \
                 return tombstone != NULL ? tombstone : entry;   \
@@ -83,26 +129,89 @@ static inline HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(fin
     }                                                           \
 }                                                               \
 \
+static inline HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    uint32_t index = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHomeIndex)(map, key); \
+    return HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntryFrom)(map, key, index); \
+}                                                               \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapCompact)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) { \
+    if (map == NULL || map->deletedItemsCount == 0) return;                     \
+    HASH_MAP_METHOD(sweep, KEY_NAME, VALUE_NAME, MapGenerations)(map);          \
+    for (uint32_t i = 0; i < map->capacity; i++) {   /* Tombstones become empty slots, live entries are marked as not placed yet */ \
+        map->entries[i].isDeleted = !map->entries[i].isEmptySlot;               \
+    }                                                                           \
+                                                                                \
+    for (uint32_t i = 0; i < map->capacity; i++) {                              \
+        if (map->entries[i].isEmptySlot || !map->entries[i].isDeleted) continue;\
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) movedEntry = map->entries[i]; \
+        map->entries[i].key = (KEY_TYPE) {0};                                   \
+        map->entries[i].value = (VALUE_TYPE) {0};                               \
+        map->entries[i].isDeleted = false;                                      \
+        map->entries[i].isEmptySlot = true;                                     \
+                                                                                \
+        while (true) {  /* Place entry to the first slot not taken by placed entries, not placed one from that slot is moved next */ \
+            uint32_t index = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHomeIndex)(map, movedEntry.key); \
+            while (!map->entries[index].isEmptySlot && !map->entries[index].isDeleted) { \
+                index = (index + 1) & (map->capacity - 1);                      \
+            }                                                                   \
+            HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) displacedEntry = map->entries[index]; \
+            map->entries[index] = movedEntry;                                   \
+            map->entries[index].isDeleted = false;                              \
+            if (displacedEntry.isEmptySlot) break;                              \
+            movedEntry = displacedEntry;                                        \
+        }                                                                       \
+    }                                                                           \
+    map->deletedItemsCount = 0;                                                 \
+    HASH_STATS_COUNT_RESIZE(map);                                               \
+}                                                                               \
+\
+static inline HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(insert, KEY_NAME, VALUE_NAME, MapEntry)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE value) { \
+    if (map == NULL) return NULL;                                                                       \
+    bool hasRoom = map->size < (map->capacity / HASH_MAP_EXPAND_FACTOR);                                \
+    if (hasRoom && map->deletedItemsCount > HASH_MAP_TOMBSTONE_PURGE_THRESHOLD(map->capacity)) {  /* Keeps empty slots that terminate probes */ \
+        HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapCompact)(map);                                         \
+    }                                                                                                   \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key); \
+    if (!entry->isEmptySlot) return entry;  /* Existing key entry is returned as is */                \
+    if (!hasRoom) return NULL;              \
+                                            \
+    if (entry->isDeleted) {                 \
+        map->deletedItemsCount--;           \
+    }                                       \
+    entry->key = key;                       \
+    entry->value = value;                   \
+    entry->isDeleted = false;               \
+    entry->isEmptySlot = false;             \
+    map->size++;                            \
+    return entry;                           \
+}                                           \
+\
 static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE value) {   \
     if (map != NULL && (map->size < (map->capacity / HASH_MAP_EXPAND_FACTOR))) {                           \
-        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key);                                                                                                 \
-        bool alreadyExist = !entry->isEmptySlot; \
-        if (!alreadyExist) {           \
-            map->size++;                    \
-        }                                   \
-                                            \
-        if (entry->isDeleted) {             \
-            map->deletedItemsCount--;       \
-        }                                   \
+        uint32_t size = map->size;          \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(insert, KEY_NAME, VALUE_NAME, MapEntry)(map, key, value); \
         entry->key = key;                   \
         entry->value = value;               \
-        entry->isDeleted = false;           \
-        entry->isEmptySlot = false;         \
-        return !alreadyExist;               \
+        return map->size != size;           \
     }                                       \
     return false;                           \
 }                                           \
 \
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapUpsert)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE value, VALUE_TYPE (*merge)(VALUE_TYPE, VALUE_TYPE)) { \
+    uint32_t size = map != NULL ? map->size : 0;    \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(insert, KEY_NAME, VALUE_NAME, MapEntry)(map, key, value); \
+    if (entry == NULL) return false;                \
+    if (map->size == size) {    /* Existing key, merged with the new value in the same probe */ \
+        entry->value = merge != NULL ? merge(entry->value, value) : value; \
+    }                                               \
+    return true;                                    \
+}                                                   \
+\
+static inline VALUE_TYPE * HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetOrAddSlot)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE defaultValue) { \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(insert, KEY_NAME, VALUE_NAME, MapEntry)(map, key, defaultValue); \
+    return entry != NULL ? &entry->value : NULL;    /* Slot is valid until the next add or remove */ \
+}                                                   \
+\
 static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMapOf)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint32_t capacity, uint32_t size) { \
     if (map == NULL || entries == NULL) return NULL;                                                \
     HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) tmpEntries[size];                                  \
@@ -147,6 +256,27 @@ static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetOrDefault)(
     return (VALUE_TYPE) {0};        \
 }                                   \
 \
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetBatch)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE keys[], uint32_t count, VALUE_TYPE values[]) { \
+    uint32_t indexes[HASH_MAP_BATCH_SIZE];                                              \
+    for (uint32_t offset = 0; offset < count; offset += HASH_MAP_BATCH_SIZE) {          \
+        uint32_t batchSize = count - offset < HASH_MAP_BATCH_SIZE ? count - offset : HASH_MAP_BATCH_SIZE; \
+        if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(map)) {                 \
+            for (uint32_t i = 0; i < batchSize; i++) {                                  \
+                values[offset + i] = (VALUE_TYPE) {0};                                  \
+            }                                                                           \
+            continue;                                                                   \
+        }                                                                               \
+        for (uint32_t i = 0; i < batchSize; i++) {  /* Hash all keys first, so home slots are loaded in parallel, not found keys get zero value */ \
+            indexes[i] = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHomeIndex)(map, keys[offset + i]);    \
+            HASH_MAP_PREFETCH(&map->entries[indexes[i]]);                               \
+        }                                                                               \
+        for (uint32_t i = 0; i < batchSize; i++) {                                      \
+            HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntryFrom)(map, keys[offset + i], indexes[i]); \
+            values[offset + i] = !entry->isEmptySlot ? entry->value : (VALUE_TYPE) {0}; \
+        }                                                                               \
+    }                                                                                   \
+}                                                                                       \
+\
 static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRemove)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
     if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(map)) {                                                          \
         HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key);  \
@@ -164,6 +294,7 @@ static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRemove)(HASH_M
 }                                           \
 \
 static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAddAll)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *fromMap, HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *toMap) {  \
+    HASH_MAP_METHOD(sweep, KEY_NAME, VALUE_NAME, MapGenerations)(fromMap);                    \
     for (uint32_t i = 0; i < fromMap->capacity; i++) {                                        \
         HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = &fromMap->entries[i];           \
         if (!entry->isEmptySlot) {                                                            \
@@ -174,11 +305,14 @@ static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAddAll)(HASH_MAP_TYP
 \
 static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapClear)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {    \
     if (map != NULL && map->entries != NULL) {          \
-        for (uint32_t i = 0; i < map->capacity; i++) {  \
-            map->entries[i].key = (KEY_TYPE) {0};       \
-            map->entries[i].value = (VALUE_TYPE) {0};   \
-            map->entries[i].isDeleted = false;          \
-            map->entries[i].isEmptySlot = true;         \
+        if (!HASH_GENERATION_ADVANCE(map)) {    /* Without generations or on their wraparound every slot is reset */ \
+            for (uint32_t i = 0; i < map->capacity; i++) {  \
+                map->entries[i].key = (KEY_TYPE) {0};       \
+                map->entries[i].value = (VALUE_TYPE) {0};   \
+                map->entries[i].isDeleted = false;          \
+                map->entries[i].isEmptySlot = true;         \
+                HASH_GENERATION_STAMP(&map->entries[i], HASH_GENERATION_OF(map)); \
+            }                                               \
         }                                               \
         map->size = 0;                                  \
         map->deletedItemsCount = 0;                     \
@@ -186,6 +320,7 @@ static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapClear)(HASH_MAP_TYPE
 }                                                       \
 \
 static inline HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapIter)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) { \
+    HASH_MAP_METHOD(sweep, KEY_NAME, VALUE_NAME, MapGenerations)(map);                      \
     HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) iterator = {.map = map, .index = 0};    \
     return iterator;    \
 }                       \
@@ -207,7 +342,9 @@ static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHasNext)(HASH_MAP_IT
         return false;               \
     }                               \
     return false;                   \
-}\
+}                                   \
+\
+CREATE_HASH_MAP_STATS_METHOD(KEY_NAME, VALUE_NAME)
 
 
 
@@ -254,7 +391,7 @@ HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMap)(&(HASH_MAP_TYPEDEF(KEY_NAM
 #define NEW_HASH_MAP_1024(...) NEW_HASH_MAP(__VA_ARGS__, 1024)
 
 
-#define MAP_ENTRY(KEY, VALUE) {(KEY), (VALUE), false, true}
+#define MAP_ENTRY(KEY, VALUE) {(KEY), (VALUE)}
 
 #define NEW_HASH_MAP_OF(CAPACITY, KEY_NAME, VALUE_NAME, ...) \
 HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMapOf)(&(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME)){0}, \
@@ -262,81 +399,81 @@ HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMapOf)(&(HASH_MAP_TYPEDEF(KEY_N
                                                           HASH_MAP_ALIGN_CAPACITY(CAPACITY),      \
                                                           VAR_ARGS_LENGTH(HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME), __VA_ARGS__))
 
-#define CREATE_HASH_MAP_1(KEY_NAME, VALUE_NAME, K1) \
-        NEW_HASH_MAP_OF(1, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, K1))
+#define CREATE_HASH_MAP_1(NEW_OF, KEY_NAME, VALUE_NAME, K1) \
+        NEW_OF(1, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, K1))
 
-#define CREATE_HASH_MAP_2(KEY_NAME, VALUE_NAME, K1, V1) \
-        NEW_HASH_MAP_OF(1, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1))
+#define CREATE_HASH_MAP_2(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1) \
+        NEW_OF(1, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1))
 
-#define CREATE_HASH_MAP_3(KEY_NAME, VALUE_NAME, K1, V1, K2) \
-        NEW_HASH_MAP_OF(2, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, K2))
+#define CREATE_HASH_MAP_3(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2) \
+        NEW_OF(2, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, K2))
 
-#define CREATE_HASH_MAP_4(KEY_NAME, VALUE_NAME, K1, V1, K2, V2) \
-        NEW_HASH_MAP_OF(2, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2))
+#define CREATE_HASH_MAP_4(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2) \
+        NEW_OF(2, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2))
 
-#define CREATE_HASH_MAP_5(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3) \
-        NEW_HASH_MAP_OF(3, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, K3))
+#define CREATE_HASH_MAP_5(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3) \
+        NEW_OF(3, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, K3))
 
-#define CREATE_HASH_MAP_6(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3) \
-        NEW_HASH_MAP_OF(3, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3))
+#define CREATE_HASH_MAP_6(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3) \
+        NEW_OF(3, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3))
 
-#define CREATE_HASH_MAP_7(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4) \
-        NEW_HASH_MAP_OF(4, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, K4))
+#define CREATE_HASH_MAP_7(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4) \
+        NEW_OF(4, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, K4))
 
-#define CREATE_HASH_MAP_8(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4) \
-        NEW_HASH_MAP_OF(4, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4))
+#define CREATE_HASH_MAP_8(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4) \
+        NEW_OF(4, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4))
 
-#define CREATE_HASH_MAP_9(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5) \
-        NEW_HASH_MAP_OF(5, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, K5))
+#define CREATE_HASH_MAP_9(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5) \
+        NEW_OF(5, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, K5))
 
-#define CREATE_HASH_MAP_10(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5) \
-        NEW_HASH_MAP_OF(5, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5))
+#define CREATE_HASH_MAP_10(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5) \
+        NEW_OF(5, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5))
 
-#define CREATE_HASH_MAP_11(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6) \
-        NEW_HASH_MAP_OF(6, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, K6))
+#define CREATE_HASH_MAP_11(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6) \
+        NEW_OF(6, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, K6))
 
-#define CREATE_HASH_MAP_12(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6) \
-        NEW_HASH_MAP_OF(6, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6))
+#define CREATE_HASH_MAP_12(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6) \
+        NEW_OF(6, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6))
 
-#define CREATE_HASH_MAP_13(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7) \
-        NEW_HASH_MAP_OF(7, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, K7))
+#define CREATE_HASH_MAP_13(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7) \
+        NEW_OF(7, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, K7))
 
-#define CREATE_HASH_MAP_14(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7) \
-        NEW_HASH_MAP_OF(7, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7))
+#define CREATE_HASH_MAP_14(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7) \
+        NEW_OF(7, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7))
 
-#define CREATE_HASH_MAP_15(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8) \
-        NEW_HASH_MAP_OF(8, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, K8))
+#define CREATE_HASH_MAP_15(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8) \
+        NEW_OF(8, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, K8))
 
-#define CREATE_HASH_MAP_16(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8) \
-        NEW_HASH_MAP_OF(8, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8))
+#define CREATE_HASH_MAP_16(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8) \
+        NEW_OF(8, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8))
 
-#define CREATE_HASH_MAP_17(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9) \
-        NEW_HASH_MAP_OF(9, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, K9))
+#define CREATE_HASH_MAP_17(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9) \
+        NEW_OF(9, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, K9))
 
-#define CREATE_HASH_MAP_18(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9, V9) \
-        NEW_HASH_MAP_OF(9, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, V9))
+#define CREATE_HASH_MAP_18(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9, V9) \
+        NEW_OF(9, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, V9))
 
-#define CREATE_HASH_MAP_19(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9, V9, K10) \
-        NEW_HASH_MAP_OF(10, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, V9), MAP_ENTRY(K10, K10))
+#define CREATE_HASH_MAP_19(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9, V9, K10) \
+        NEW_OF(10, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, V9), MAP_ENTRY(K10, K10))
 
-#define CREATE_HASH_MAP_20(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9, V9, K10, V10) \
-        NEW_HASH_MAP_OF(10, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, V9), MAP_ENTRY(K10, V10))
+#define CREATE_HASH_MAP_20(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9, V9, K10, V10) \
+        NEW_OF(10, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, V9), MAP_ENTRY(K10, V10))
 
-#define CREATE_HASH_MAP_21(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9, V9, K10, V10, K11) \
-        NEW_HASH_MAP_OF(11, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, V9), MAP_ENTRY(K10, V10), MAP_ENTRY(K11, K11))
+#define CREATE_HASH_MAP_21(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9, V9, K10, V10, K11) \
+        NEW_OF(11, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, V9), MAP_ENTRY(K10, V10), MAP_ENTRY(K11, K11))
 
-#define CREATE_HASH_MAP_22(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9, V9, K10, V10, K11, V11) \
-        NEW_HASH_MAP_OF(11, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, V9), MAP_ENTRY(K10, V10), MAP_ENTRY(K11, V11))
+#define CREATE_HASH_MAP_22(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9, V9, K10, V10, K11, V11) \
+        NEW_OF(11, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, V9), MAP_ENTRY(K10, V10), MAP_ENTRY(K11, V11))
 
-#define CREATE_HASH_MAP_23(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9, V9, K10, V10, K11, V11, K12) \
-        NEW_HASH_MAP_OF(12, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, V9), MAP_ENTRY(K10, V10), MAP_ENTRY(K11, V11), MAP_ENTRY(K12, K12))
+#define CREATE_HASH_MAP_23(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9, V9, K10, V10, K11, V11, K12) \
+        NEW_OF(12, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, V9), MAP_ENTRY(K10, V10), MAP_ENTRY(K11, V11), MAP_ENTRY(K12, K12))
 
-#define CREATE_HASH_MAP_24(KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9, V9, K10, V10, K11, V11, K12, V12) \
-        NEW_HASH_MAP_OF(12, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, V9), MAP_ENTRY(K10, V10), MAP_ENTRY(K11, V11), MAP_ENTRY(K12, V12))
+#define CREATE_HASH_MAP_24(NEW_OF, KEY_NAME, VALUE_NAME, K1, V1, K2, V2, K3, V3, K4, V4, K5, V5, K6, V6, K7, V7, K8, V8, K9, V9, K10, V10, K11, V11, K12, V12) \
+        NEW_OF(12, KEY_NAME, VALUE_NAME, MAP_ENTRY(K1, V1), MAP_ENTRY(K2, V2), MAP_ENTRY(K3, V3), MAP_ENTRY(K4, V4), MAP_ENTRY(K5, V5), MAP_ENTRY(K6, V6), MAP_ENTRY(K7, V7), MAP_ENTRY(K8, V8), MAP_ENTRY(K9, V9), MAP_ENTRY(K10, V10), MAP_ENTRY(K11, V11), MAP_ENTRY(K12, V12))
 
 #define GET_CREATE_HASH_MAP_MACRO(KEY_NAME, VALUE_NAME, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, FUN, ...) FUN
 
-#define HASH_MAP_OF(KEY_NAME, VALUE_NAME, ...)                          \
+#define HASH_MAP_OF_WITH(NEW_OF, KEY_NAME, VALUE_NAME, ...)             \
     GET_CREATE_HASH_MAP_MACRO(KEY_NAME, VALUE_NAME, __VA_ARGS__,        \
                         CREATE_HASH_MAP_24,                   \
                         CREATE_HASH_MAP_23,                   \
@@ -362,4 +499,6 @@ HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMapOf)(&(HASH_MAP_TYPEDEF(KEY_N
                         CREATE_HASH_MAP_3,                   \
                         CREATE_HASH_MAP_2,                   \
                         CREATE_HASH_MAP_1,                   \
-                        ERROR)(KEY_NAME, VALUE_NAME, __VA_ARGS__)
+                        ERROR)(NEW_OF, KEY_NAME, VALUE_NAME, __VA_ARGS__)
+
+#define HASH_MAP_OF(KEY_NAME, VALUE_NAME, ...) HASH_MAP_OF_WITH(NEW_HASH_MAP_OF, KEY_NAME, VALUE_NAME, __VA_ARGS__)
@@ -2,11 +2,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include "Comparator.h"
+#include "HashTableCommon.h"
 
 #define HASH_SET_EXPAND_FACTOR 2
 #define HASH_SET_BUFFER_EXPAND_FACTOR(CAPACITY) ((CAPACITY) * HASH_SET_EXPAND_FACTOR)
 #define HASH_SET_ALIGN_CAPACITY(CAPACITY) (NEXT_POW_OF_2(HASH_SET_BUFFER_EXPAND_FACTOR(CAPACITY)))
+#define HASH_SET_TOMBSTONE_PURGE_THRESHOLD(CAPACITY) ((CAPACITY) / 4)  // removed values count that triggers in place rehash on add
 
 #define HASH_SET_ENTRY_TYPEDEF(NAME) NAME ##HashSetEntry
 #define HASH_SET_TYPEDEF(NAME) NAME ##HashSet
@@ -21,12 +22,30 @@
                         HASH_SET_METHOD_NAME_1,                  \
                         ERROR)(__VA_ARGS__)                      \
 
+#ifdef HASH_MAP_STATS
+#define CREATE_HASH_SET_STATS_METHOD(NAME) \
+static inline void HASH_SET_METHOD(NAME, SetGetStats)(HASH_SET_TYPEDEF(NAME) *set, HashTableStats *stats) { \
+    if (set == NULL || stats == NULL) return;   \
+    HASH_SET_METHOD(sweep, NAME, SetGenerations)(set);  \
+    hashStatsInit(stats, set->size, set->capacity, set->deletedItemsCount, set->resizeCount, sizeof(*set) + set->capacity * sizeof(set->entries[0])); \
+    for (uint32_t i = 0; i < set->capacity; i++) {  \
+        if (!set->entries[i].isEmptySlot) {         \
+            hashStatsAddProbeLength(stats, (i - HASH_SET_METHOD(NAME, SetHomeIndex)(set, set->entries[i].value)) & (set->capacity - 1)); \
+        }                                           \
+    }                                               \
+    hashStatsComplete(stats);                       \
+}
+#else
+#define CREATE_HASH_SET_STATS_METHOD(NAME)
+#endif
+
 
 #define CREATE_HASH_SET_TYPE_NAME(TYPE, NAME, COMPARE_FUN, HASH_FUN) \
 typedef struct HASH_SET_ENTRY_TYPEDEF(NAME) { \
     TYPE value;                 \
     bool isDeleted;             \
     bool isEmptySlot;           \
+    HASH_GENERATION_SLOT_FIELD  \
 } HASH_SET_ENTRY_TYPEDEF(NAME); \
 \
 typedef struct HASH_SET_TYPEDEF(NAME) { \
@@ -34,6 +53,9 @@ typedef struct HASH_SET_TYPEDEF(NAME) { \
     uint32_t size;                  \
     uint32_t capacity;              \
     uint32_t deletedItemsCount;     \
+    uint32_t seed;                  \
+    HASH_STATS_RESIZE_COUNT_FIELD   \
+    HASH_GENERATION_TABLE_FIELDS    \
 } HASH_SET_TYPEDEF(NAME);           \
 \
 typedef struct HASH_SET_ITERATOR_TYPEDEF(NAME) {    \
@@ -48,23 +70,48 @@ static inline HASH_SET_TYPEDEF(NAME) * HASH_SET_METHOD(new, NAME, BufferSet)(HAS
     set->size = 0;                      \
     set->capacity = capacity;           \
     set->deletedItemsCount = 0;         \
+    set->seed = HASH_MAP_NEW_SEED();    \
+    HASH_STATS_RESET_RESIZE_COUNT(set); \
+    HASH_GENERATION_RESET(set);         \
     \
     for (uint32_t i = 0; i < capacity; i++) {   \
         HASH_SET_ENTRY_TYPEDEF(NAME) *entry = &entries[i]; \
         entry->value = (TYPE) {0};              \
         entry->isDeleted = false;               \
         entry->isEmptySlot = true;              \
+        HASH_GENERATION_STAMP(entry, 0);        \
     }                                           \
     return set;                                 \
 }                                               \
                                                 \
+static inline uint32_t HASH_SET_METHOD(NAME, SetHomeIndex)(HASH_SET_TYPEDEF(NAME) *set, TYPE value) { \
+    return HASH_MAP_KEY_HASH_CODE(HASH_FUN, value, set->seed) & (set->capacity - 1); \
+}                                                       \
+\
+static inline void HASH_SET_METHOD(refresh, NAME, SetEntry)(HASH_SET_TYPEDEF(NAME) *set, HASH_SET_ENTRY_TYPEDEF(NAME) *entry) { \
+    (void) set;  /* used only with HASH_MAP_GENERATION_CLEAR */        \
+    if (HASH_GENERATION_IS_STALE(entry, HASH_GENERATION_OF(set))) {  /* Written before the last clear, becomes empty slot */ \
+        entry->isDeleted = false;                                   \
+        entry->isEmptySlot = true;                                  \
+        HASH_GENERATION_STAMP(entry, HASH_GENERATION_OF(set));      \
+    }                                                               \
+}                                                                   \
+\
+static inline void HASH_SET_METHOD(sweep, NAME, SetGenerations)(HASH_SET_TYPEDEF(NAME) *set) { \
+    if (set == NULL || !HASH_GENERATION_HAS_STALE_SLOTS(set)) return;   /* Called before walking all slots, so costs no extra complexity */ \
+    for (uint32_t i = 0; i < set->capacity; i++) {                  \
+        HASH_SET_METHOD(refresh, NAME, SetEntry)(set, &set->entries[i]); \
+    }                                                               \
+    HASH_GENERATION_SWEPT(set);                                     \
+}                                                                   \
+\
 static inline HASH_SET_ENTRY_TYPEDEF(NAME) * HASH_SET_METHOD(find, NAME, SetEntry)(HASH_SET_TYPEDEF(NAME) *set, TYPE value) { \
-    uint32_t hash = HASH_FUN(value);                    \
-    uint32_t index = hash & (set->capacity - 1);        \
+    uint32_t index = HASH_SET_METHOD(NAME, SetHomeIndex)(set, value); \
     HASH_SET_ENTRY_TYPEDEF(NAME) *tombstone = NULL;     \
                                                         \
     while (true) {                                      \
         HASH_SET_ENTRY_TYPEDEF(NAME) *entry = &set->entries[index]; \
+        HASH_SET_METHOD(refresh, NAME, SetEntry)(set, entry);  \
         if (entry->isEmptySlot) {                               \
             if (!entry->isDeleted) {                            \
                 return tombstone != NULL ? tombstone : entry;   \
@@ -80,8 +127,41 @@ static inline HASH_SET_ENTRY_TYPEDEF(NAME) * HASH_SET_METHOD(find, NAME, SetEntr
     }                                                           \
 }                                                               \
 \
+static inline void HASH_SET_METHOD(NAME, SetCompact)(HASH_SET_TYPEDEF(NAME) *set) { \
+    if (set == NULL || set->deletedItemsCount == 0) return;                     \
+    HASH_SET_METHOD(sweep, NAME, SetGenerations)(set);                          \
+    for (uint32_t i = 0; i < set->capacity; i++) {   /* Tombstones become empty slots, live values are marked as not placed yet */ \
+        set->entries[i].isDeleted = !set->entries[i].isEmptySlot;               \
+    }                                                                           \
+                                                                                \
+    for (uint32_t i = 0; i < set->capacity; i++) {                              \
+        if (set->entries[i].isEmptySlot || !set->entries[i].isDeleted) continue;\
+        HASH_SET_ENTRY_TYPEDEF(NAME) movedEntry = set->entries[i];              \
+        set->entries[i].value = (TYPE) {0};                                     \
+        set->entries[i].isDeleted = false;                                      \
+        set->entries[i].isEmptySlot = true;                                     \
+                                                                                \
+        while (true) {  /* Place value to the first slot not taken by placed values, not placed one from that slot is moved next */ \
+            uint32_t index = HASH_SET_METHOD(NAME, SetHomeIndex)(set, movedEntry.value); \
+            while (!set->entries[index].isEmptySlot && !set->entries[index].isDeleted) { \
+                index = (index + 1) & (set->capacity - 1);                      \
+            }                                                                   \
+            HASH_SET_ENTRY_TYPEDEF(NAME) displacedEntry = set->entries[index];  \
+            set->entries[index] = movedEntry;                                   \
+            set->entries[index].isDeleted = false;                              \
+            if (displacedEntry.isEmptySlot) break;                              \
+            movedEntry = displacedEntry;                                        \
+        }                                                                       \
+    }                                                                           \
+    set->deletedItemsCount = 0;                                                 \
+    HASH_STATS_COUNT_RESIZE(set);                                               \
+}                                                                               \
+\
 static inline bool HASH_SET_METHOD(NAME, SetAdd)(HASH_SET_TYPEDEF(NAME) *set, TYPE value) {   \
     if (set != NULL && (set->size < (set->capacity / HASH_SET_EXPAND_FACTOR))) {                  \
+        if (set->deletedItemsCount > HASH_SET_TOMBSTONE_PURGE_THRESHOLD(set->capacity)) {  /* Keeps empty slots that terminate probes */ \
+            HASH_SET_METHOD(NAME, SetCompact)(set);                                         \
+        }                                                                                   \
         HASH_SET_ENTRY_TYPEDEF(NAME) *entry = HASH_SET_METHOD(find, NAME, SetEntry)(set, value);                                                               \
         bool alreadyExist = !entry->isEmptySlot;    \
         if (!alreadyExist) {                \
@@ -145,6 +225,7 @@ static inline bool HASH_SET_METHOD(NAME, SetRemove)(HASH_SET_TYPEDEF(NAME) *set,
 }                                               \
 \
 static inline void HASH_SET_METHOD(NAME, SetAddAll)(HASH_SET_TYPEDEF(NAME) *fromSet, HASH_SET_TYPEDEF(NAME) *toSet) {  \
+    HASH_SET_METHOD(sweep, NAME, SetGenerations)(fromSet);                    \
     for (uint32_t i = 0; i < fromSet->capacity; i++) {                        \
         HASH_SET_ENTRY_TYPEDEF(NAME) *entry = &fromSet->entries[i];           \
         if (!entry->isEmptySlot) {                                            \
@@ -155,10 +236,13 @@ static inline void HASH_SET_METHOD(NAME, SetAddAll)(HASH_SET_TYPEDEF(NAME) *from
 \
 static inline void HASH_SET_METHOD(NAME, SetClear)(HASH_SET_TYPEDEF(NAME) *set) {    \
     if (set != NULL && set->entries != NULL) {          \
-        for (uint32_t i = 0; i < set->capacity; i++) {  \
-            set->entries[i].value = (TYPE) {0};         \
-            set->entries[i].isDeleted = false;          \
-            set->entries[i].isEmptySlot = true;         \
+        if (!HASH_GENERATION_ADVANCE(set)) {    /* Without generations or on their wraparound every slot is reset */ \
+            for (uint32_t i = 0; i < set->capacity; i++) {  \
+                set->entries[i].value = (TYPE) {0};         \
+                set->entries[i].isDeleted = false;          \
+                set->entries[i].isEmptySlot = true;         \
+                HASH_GENERATION_STAMP(&set->entries[i], HASH_GENERATION_OF(set)); \
+            }                                               \
         }                                               \
         set->size = 0;                                  \
         set->deletedItemsCount = 0;                     \
@@ -166,6 +250,7 @@ static inline void HASH_SET_METHOD(NAME, SetClear)(HASH_SET_TYPEDEF(NAME) *set)
 }                                                       \
 \
 static inline HASH_SET_ITERATOR_TYPEDEF(NAME) HASH_SET_METHOD(NAME, SetIter)(HASH_SET_TYPEDEF(NAME) *set) { \
+    HASH_SET_METHOD(sweep, NAME, SetGenerations)(set);                      \
     HASH_SET_ITERATOR_TYPEDEF(NAME) iterator = {.set = set, .index = 0};    \
     return iterator;    \
 }                       \
@@ -196,7 +281,131 @@ static inline bool HASH_SET_METHOD(NAME, SetContainsAll)(HASH_SET_TYPEDEF(NAME)
         }                                                                         \
     }                                                                             \
     return true;                                                                  \
-}\
+}                                                                                 \
+\
+static inline bool HASH_SET_METHOD(NAME, SetUnion)(HASH_SET_TYPEDEF(NAME) *resultSet, HASH_SET_TYPEDEF(NAME) *firstSet, HASH_SET_TYPEDEF(NAME) *secondSet) { \
+    if (resultSet == NULL || firstSet == NULL || secondSet == NULL) return false;   /* resultSet can be one of operands */ \
+    HASH_SET_METHOD(sweep, NAME, SetGenerations)(firstSet);                         \
+    HASH_SET_METHOD(sweep, NAME, SetGenerations)(secondSet);                        \
+    bool isAllAdded = true;     /* operand that is also resultSet is skipped, so set is never changed while iterated */ \
+    for (uint32_t i = 0; resultSet != firstSet && i < firstSet->capacity; i++) {    \
+        if (!firstSet->entries[i].isEmptySlot && !HASH_SET_METHOD(NAME, SetAdd)(resultSet, firstSet->entries[i].value)) { \
+            isAllAdded &= HASH_SET_METHOD(NAME, SetContains)(resultSet, firstSet->entries[i].value); \
+        }                                                                           \
+    }                                                                               \
+    for (uint32_t i = 0; resultSet != secondSet && i < secondSet->capacity; i++) {  \
+        if (!secondSet->entries[i].isEmptySlot && !HASH_SET_METHOD(NAME, SetAdd)(resultSet, secondSet->entries[i].value)) { \
+            isAllAdded &= HASH_SET_METHOD(NAME, SetContains)(resultSet, secondSet->entries[i].value); \
+        }                                                                           \
+    }                                                                               \
+    return isAllAdded;  /* false when resultSet is full */                          \
+}                                                                                   \
+\
+static inline bool HASH_SET_METHOD(NAME, SetRetainAll)(HASH_SET_TYPEDEF(NAME) *set, HASH_SET_TYPEDEF(NAME) *retainSet) { \
+    if (set == NULL || retainSet == NULL || set == retainSet) return false;         \
+    if (retainSet->size == 0) {     /* nothing to retain, no need to walk set slots */ \
+        bool isChanged = set->size > 0;                                             \
+        HASH_SET_METHOD(NAME, SetClear)(set);                                       \
+        return isChanged;                                                           \
+    }                                                                               \
+    HASH_SET_METHOD(sweep, NAME, SetGenerations)(set);                              \
+    uint32_t initialSize = set->size;   /* all slots of set are visited, values are probed in retainSet */ \
+    for (uint32_t i = 0; i < set->capacity; i++) {                                  \
+        HASH_SET_ENTRY_TYPEDEF(NAME) *entry = &set->entries[i];                     \
+        if (!entry->isEmptySlot && !HASH_SET_METHOD(NAME, SetContains)(retainSet, entry->value)) { \
+            HASH_SET_METHOD(NAME, SetRemove)(set, entry->value);                    \
+        }                                                                           \
+    }                                                                               \
+    return set->size != initialSize;                                                \
+}                                                                                   \
+\
+static inline bool HASH_SET_METHOD(NAME, SetIntersect)(HASH_SET_TYPEDEF(NAME) *resultSet, HASH_SET_TYPEDEF(NAME) *firstSet, HASH_SET_TYPEDEF(NAME) *secondSet) { \
+    if (resultSet == NULL || firstSet == NULL || secondSet == NULL) return false;   \
+    if (resultSet == firstSet || resultSet == secondSet) {   /* in place, values missing in other operand are removed */ \
+        HASH_SET_METHOD(NAME, SetRetainAll)(resultSet, resultSet == firstSet ? secondSet : firstSet); \
+        return true;                                                                \
+    }                                                                               \
+    HASH_SET_TYPEDEF(NAME) *iterateSet = firstSet->size <= secondSet->size ? firstSet : secondSet;   /* iterate smaller, probe bigger */ \
+    HASH_SET_TYPEDEF(NAME) *probeSet = iterateSet == firstSet ? secondSet : firstSet;               \
+    HASH_SET_METHOD(sweep, NAME, SetGenerations)(iterateSet);                       \
+    bool isAllAdded = true;                                                         \
+    for (uint32_t i = 0; i < iterateSet->capacity; i++) {                           \
+        HASH_SET_ENTRY_TYPEDEF(NAME) *entry = &iterateSet->entries[i];              \
+        if (!entry->isEmptySlot && HASH_SET_METHOD(NAME, SetContains)(probeSet, entry->value) \
+            && !HASH_SET_METHOD(NAME, SetAdd)(resultSet, entry->value)) {           \
+            isAllAdded &= HASH_SET_METHOD(NAME, SetContains)(resultSet, entry->value); \
+        }                                                                           \
+    }                                                                               \
+    return isAllAdded;                                                              \
+}                                                                                   \
+\
+static inline bool HASH_SET_METHOD(NAME, SetSymmetricDifference)(HASH_SET_TYPEDEF(NAME) *resultSet, HASH_SET_TYPEDEF(NAME) *firstSet, HASH_SET_TYPEDEF(NAME) *secondSet) { \
+    if (resultSet == NULL || firstSet == NULL || secondSet == NULL) return false;   \
+    HASH_SET_METHOD(sweep, NAME, SetGenerations)(firstSet);                         \
+    HASH_SET_METHOD(sweep, NAME, SetGenerations)(secondSet);                        \
+    bool isAllAdded = true;                                                         \
+    if (resultSet == firstSet || resultSet == secondSet) {   /* in place, common values are removed, other operand values added */ \
+        HASH_SET_TYPEDEF(NAME) *otherSet = resultSet == firstSet ? secondSet : firstSet; \
+        if (otherSet == resultSet) {                                                \
+            HASH_SET_METHOD(NAME, SetClear)(resultSet);                             \
+            return true;                                                            \
+        }                                                                           \
+        for (uint32_t i = 0; i < otherSet->capacity; i++) {                         \
+            HASH_SET_ENTRY_TYPEDEF(NAME) *entry = &otherSet->entries[i];            \
+            if (entry->isEmptySlot) continue;                                       \
+            if (!HASH_SET_METHOD(NAME, SetRemove)(resultSet, entry->value)          \
+                && !HASH_SET_METHOD(NAME, SetAdd)(resultSet, entry->value)) {       \
+                isAllAdded = false;                                                 \
+            }                                                                       \
+        }                                                                           \
+        return isAllAdded;                                                          \
+    }                                                                               \
+    for (uint32_t i = 0; i < firstSet->capacity; i++) {                             \
+        HASH_SET_ENTRY_TYPEDEF(NAME) *entry = &firstSet->entries[i];                \
+        if (!entry->isEmptySlot && !HASH_SET_METHOD(NAME, SetContains)(secondSet, entry->value) \
+            && !HASH_SET_METHOD(NAME, SetAdd)(resultSet, entry->value)) {           \
+            isAllAdded &= HASH_SET_METHOD(NAME, SetContains)(resultSet, entry->value); \
+        }                                                                           \
+    }                                                                               \
+    for (uint32_t i = 0; i < secondSet->capacity; i++) {                            \
+        HASH_SET_ENTRY_TYPEDEF(NAME) *entry = &secondSet->entries[i];               \
+        if (!entry->isEmptySlot && !HASH_SET_METHOD(NAME, SetContains)(firstSet, entry->value) \
+            && !HASH_SET_METHOD(NAME, SetAdd)(resultSet, entry->value)) {           \
+            isAllAdded &= HASH_SET_METHOD(NAME, SetContains)(resultSet, entry->value); \
+        }                                                                           \
+    }                                                                               \
+    return isAllAdded;                                                              \
+}                                                                                   \
+\
+static inline bool HASH_SET_METHOD(NAME, SetSubtract)(HASH_SET_TYPEDEF(NAME) *set, HASH_SET_TYPEDEF(NAME) *subtractSet) { \
+    if (set == NULL || subtractSet == NULL || set == subtractSet) {                 \
+        if (set != NULL && set == subtractSet && set->size > 0) {                   \
+            HASH_SET_METHOD(NAME, SetClear)(set);                                   \
+            return true;                                                            \
+        }                                                                           \
+        return false;                                                               \
+    }                                                                               \
+    HASH_SET_METHOD(sweep, NAME, SetGenerations)(set);                              \
+    HASH_SET_METHOD(sweep, NAME, SetGenerations)(subtractSet);                      \
+    uint32_t initialSize = set->size;                                               \
+    if (subtractSet->size <= set->size) {   /* remove values of smaller set from bigger one */ \
+        for (uint32_t i = 0; i < subtractSet->capacity; i++) {                      \
+            if (!subtractSet->entries[i].isEmptySlot) {                             \
+                HASH_SET_METHOD(NAME, SetRemove)(set, subtractSet->entries[i].value); \
+            }                                                                       \
+        }                                                                           \
+    } else {    /* removal leaves tombstones in place, so set can be iterated and changed at once */ \
+        for (uint32_t i = 0; i < set->capacity; i++) {                              \
+            HASH_SET_ENTRY_TYPEDEF(NAME) *entry = &set->entries[i];                 \
+            if (!entry->isEmptySlot && HASH_SET_METHOD(NAME, SetContains)(subtractSet, entry->value)) { \
+                HASH_SET_METHOD(NAME, SetRemove)(set, entry->value);                \
+            }                                                                       \
+        }                                                                           \
+    }                                                                               \
+    return set->size != initialSize;                                                \
+}                                                                                   \
+\
+CREATE_HASH_SET_STATS_METHOD(NAME)
 
 
 
@@ -230,7 +439,7 @@ HASH_SET_METHOD(new, NAME, BufferSet)(&(HASH_SET_TYPEDEF(NAME)){0}, \
 #define NEW_HASH_SET_512(NAME)  NEW_HASH_SET(NAME, 512)
 #define NEW_HASH_SET_1024(NAME) NEW_HASH_SET(NAME, 1024)
 
-#define SET_ENTRY(VALUE) {(VALUE), false, true}
+#define SET_ENTRY(VALUE) {(VALUE)}
 
 #define NEW_HASH_SET_OF(CAPACITY, NAME, ...) \
 HASH_SET_METHOD(new, NAME, BufferSetOf)(&(HASH_SET_TYPEDEF(NAME)){0}, \
@@ -0,0 +1,271 @@
+#pragma once
+
+#include "BufferHashMap.h"
+
+// Alternative BufferHashMap layout: keys, values and 2-bit slot states are kept in separate arrays (structure of arrays).
+// There is no per entry padding and flags, e.g. `uint32_t -> uint32_t` slot takes 8.25 bytes instead of 12,
+// and probing reads only dense state bits and keys, while values are touched only for the found slot.
+
+#define PACKED_HASH_MAP_KEY_TYPEDEF(KEY_NAME, VALUE_NAME) KEY_NAME ## _ ## VALUE_NAME ## MapKey
+#define PACKED_HASH_MAP_VALUE_TYPEDEF(KEY_NAME, VALUE_NAME) KEY_NAME ## _ ## VALUE_NAME ## MapValue
+
+
+#define CREATE_PACKED_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN) \
+typedef KEY_TYPE PACKED_HASH_MAP_KEY_TYPEDEF(KEY_NAME, VALUE_NAME);       /* lets `..._OF()` macros declare arrays by type names */ \
+typedef VALUE_TYPE PACKED_HASH_MAP_VALUE_TYPEDEF(KEY_NAME, VALUE_NAME);   \
+typedef struct HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) {   /* only used to pass initial pairs to `..._OF()` macros */ \
+    KEY_TYPE key;               \
+    VALUE_TYPE value;           \
+} HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME); \
+\
+typedef struct HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) { \
+    KEY_TYPE *keys;                 \
+    VALUE_TYPE *values;             \
+    uint8_t *states;                \
+    uint32_t size;                  \
+    uint32_t capacity;              \
+    uint32_t deletedItemsCount;     \
+    uint32_t seed;                  \
+} HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME); \
+\
+typedef struct HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) {    \
+    KEY_TYPE key;                                                   \
+    VALUE_TYPE value;                                               \
+    HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map;                    \
+    uint32_t index;                                                 \
+} HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME);                  \
+                                                                    \
+static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMap)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE *keys, VALUE_TYPE *values, uint8_t *states, uint32_t capacity) { \
+    if (map == NULL) return NULL;       \
+    map->keys = keys;                   \
+    map->values = values;               \
+    map->states = states;               \
+    map->size = 0;                      \
+    map->capacity = capacity;           \
+    map->deletedItemsCount = 0;         \
+    map->seed = HASH_MAP_NEW_SEED();    \
+    memset(states, 0, HASH_SLOT_STATES_SIZE(capacity)); \
+    return map;                         \
+}                                       \
+\
+static inline uint32_t HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHomeIndex)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    return HASH_MAP_KEY_HASH_CODE(HASH_FUN, key, map->seed) & (map->capacity - 1); \
+}                                                               \
+\
+static inline uint32_t HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapSlot)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    uint32_t index = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHomeIndex)(map, key); \
+    uint32_t freeIndex = map->capacity;                         \
+                                                                \
+    while (true) {                                              \
+        uint8_t state = hashSlotState(map->states, index);      \
+        if (state == HASH_SLOT_EMPTY) {                         \
+            return freeIndex != map->capacity ? freeIndex : index;  /* Slot where key can be placed */ \
+        } else if (state == HASH_SLOT_DELETED) {                \
+            if (freeIndex == map->capacity) {                   \
+                freeIndex = index;                              \
+            }                                                   \
+        } else if (COMPARE_FUN(key, map->keys[index]) == 0) {   \
+            return index;                                       \
+        }                                                       \
+        index = (index + 1) & (map->capacity - 1);              \
+    }                                                           \
+}                                                               \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapCompact)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) { \
+    if (map == NULL || map->deletedItemsCount == 0) return;                     \
+    for (uint32_t i = 0; i < map->capacity; i++) {   /* Tombstones become empty slots, live entries are marked as not placed yet */ \
+        uint8_t state = hashSlotState(map->states, i);                          \
+        hashSlotSetState(map->states, i, state == HASH_SLOT_USED ? HASH_SLOT_MOVING : HASH_SLOT_EMPTY); \
+    }                                                                           \
+                                                                                \
+    for (uint32_t i = 0; i < map->capacity; i++) {                              \
+        if (hashSlotState(map->states, i) != HASH_SLOT_MOVING) continue;        \
+        KEY_TYPE movedKey = map->keys[i];                                       \
+        VALUE_TYPE movedValue = map->values[i];                                 \
+        hashSlotSetState(map->states, i, HASH_SLOT_EMPTY);                      \
+                                                                                \
+        while (true) {  /* Place entry to the first slot not taken by placed entries, not placed one from that slot is moved next */ \
+            uint32_t index = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHomeIndex)(map, movedKey); \
+            while (hashSlotState(map->states, index) == HASH_SLOT_USED) {       \
+                index = (index + 1) & (map->capacity - 1);                      \
+            }                                                                   \
+            bool isDisplaced = hashSlotState(map->states, index) == HASH_SLOT_MOVING; \
+            KEY_TYPE displacedKey = map->keys[index];                           \
+            VALUE_TYPE displacedValue = map->values[index];                     \
+            map->keys[index] = movedKey;                                        \
+            map->values[index] = movedValue;                                    \
+            hashSlotSetState(map->states, index, HASH_SLOT_USED);               \
+            if (!isDisplaced) break;                                            \
+            movedKey = displacedKey;                                            \
+            movedValue = displacedValue;                                        \
+        }                                                                       \
+    }                                                                           \
+    map->deletedItemsCount = 0;                                                 \
+}                                                                               \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE value) {   \
+    if (map != NULL && (map->size < (map->capacity / HASH_MAP_EXPAND_FACTOR))) {                           \
+        if (map->deletedItemsCount > HASH_MAP_TOMBSTONE_PURGE_THRESHOLD(map->capacity)) {                   \
+            HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapCompact)(map);                                         \
+        }                                                                                                   \
+        uint32_t index = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapSlot)(map, key);                    \
+        uint8_t state = hashSlotState(map->states, index);                                                  \
+        map->values[index] = value;             \
+        if (state == HASH_SLOT_USED) return false;  \
+                                                \
+        if (state == HASH_SLOT_DELETED) {       \
+            map->deletedItemsCount--;           \
+        }                                       \
+        map->keys[index] = key;                 \
+        hashSlotSetState(map->states, index, HASH_SLOT_USED); \
+        map->size++;                            \
+        return true;                            \
+    }                                           \
+    return false;                               \
+}                                               \
+\
+static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMapOf)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE *keys, VALUE_TYPE *values, uint8_t *states, uint32_t capacity, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint32_t size) { \
+    map = HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMap)(map, keys, values, states, capacity);  \
+    for (uint32_t i = 0; map != NULL && i < size; i++) {                                            \
+        HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(map, entries[i].key, entries[i].value);       \
+    }                                                                                               \
+    return map;                                                                                     \
+}                                                                                                   \
+\
+static inline uint32_t HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapSize)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return map != NULL ? map->size : 0; \
+}   \
+\
+static inline bool HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return map != NULL ? map->size == 0 : true; \
+}   \
+\
+static inline bool HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {   \
+    return !HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(map);        \
+}   \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapContains)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(map)) {                                      \
+        uint32_t index = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapSlot)(map, key);                    \
+        return hashSlotState(map->states, index) == HASH_SLOT_USED;                                         \
+    }               \
+    return false;   \
+}                   \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetOrDefault)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE defaultValue) { \
+    if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(map)) {                                      \
+        uint32_t index = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapSlot)(map, key);                    \
+        return hashSlotState(map->states, index) == HASH_SLOT_USED ? map->values[index] : defaultValue;     \
+    }                           \
+    return defaultValue;        \
+}                               \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGet)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) {    \
+    return HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetOrDefault)(map, key, (VALUE_TYPE) {0});                                          \
+}                               \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRemove)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(map)) {                                      \
+        uint32_t index = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapSlot)(map, key);                    \
+        if (hashSlotState(map->states, index) != HASH_SLOT_USED) return (VALUE_TYPE) {0};                  \
+        VALUE_TYPE value = map->values[index];                                                              \
+        map->keys[index] = (KEY_TYPE) {0};                                                                  \
+        map->values[index] = (VALUE_TYPE) {0};                                                              \
+        hashSlotSetState(map->states, index, HASH_SLOT_DELETED);                                            \
+        map->size--;                        \
+        map->deletedItemsCount++;           \
+        return value;                       \
+    }                                       \
+    return (VALUE_TYPE) {0};                \
+}                                           \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAddAll)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *fromMap, HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *toMap) {  \
+    for (uint32_t i = 0; i < fromMap->capacity; i++) {                                                      \
+        if (hashSlotState(fromMap->states, i) == HASH_SLOT_USED) {                                          \
+            HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(toMap, fromMap->keys[i], fromMap->values[i]);     \
+        }   \
+    }       \
+}           \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapClear)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {    \
+    if (map != NULL && map->states != NULL) {                               \
+        memset(map->states, 0, HASH_SLOT_STATES_SIZE(map->capacity));       \
+        map->size = 0;                                                      \
+        map->deletedItemsCount = 0;                                         \
+    }                                                                       \
+}                                                                           \
+\
+static inline HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapIter)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) { \
+    HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) iterator = {.map = map, .index = 0};    \
+    return iterator;    \
+}                       \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHasNext)(HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) *iterator) { \
+    if (iterator != NULL && iterator->map != NULL) {        \
+        HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map = iterator->map;  \
+        while (iterator->index < map->capacity) {           \
+            uint32_t index = iterator->index++;             \
+            if (hashSlotState(map->states, index) == HASH_SLOT_USED) { \
+                iterator->key = map->keys[index];           \
+                iterator->value = map->values[index];       \
+                return true;                                \
+            }                                               \
+        }                                                   \
+    }                                                       \
+    return false;                                           \
+}                                                           \
+
+
+
+#define CREATE_PACKED_HASH_MAP_TYPE_1(KEY_TYPE, VALUE_TYPE) CREATE_PACKED_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_TYPE, VALUE_TYPE, COMPARATOR_FOR_TYPE(KEY_TYPE), HASH_CODE_FOR_TYPE(KEY_TYPE))
+#define CREATE_PACKED_HASH_MAP_TYPE_2(KEY_TYPE, VALUE_TYPE, KEY_NAME) CREATE_PACKED_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, COMPARATOR_FOR_TYPE(KEY_TYPE), HASH_CODE_FOR_TYPE(KEY_TYPE))
+#define CREATE_PACKED_HASH_MAP_TYPE_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME) CREATE_PACKED_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARATOR_FOR_TYPE(KEY_TYPE), HASH_CODE_FOR_TYPE(KEY_TYPE))
+#define CREATE_PACKED_HASH_MAP_TYPE_4(KEY_TYPE, VALUE_TYPE, KEY_NAME, COMPARE_FUN, HASH_FUN) CREATE_PACKED_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, COMPARE_FUN, HASH_FUN)
+#define CREATE_PACKED_HASH_MAP_TYPE_5(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN) CREATE_PACKED_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN)
+
+#define CREATE_PACKED_HASH_MAP_TYPE(...)                                \
+    CREATE_HASH_MAP_TYPE_MACRO(__VA_ARGS__,                             \
+                        CREATE_PACKED_HASH_MAP_TYPE_5,                  \
+                        CREATE_PACKED_HASH_MAP_TYPE_4,                  \
+                        CREATE_PACKED_HASH_MAP_TYPE_3,                  \
+                        CREATE_PACKED_HASH_MAP_TYPE_2,                  \
+                        CREATE_PACKED_HASH_MAP_TYPE_1,                  \
+                        ERROR)(__VA_ARGS__)
+
+
+#define NEW_PACKED_HASH_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, CAPACITY) \
+HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMap)(&(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME)){0}, \
+                                                       (KEY_TYPE [HASH_MAP_ALIGN_CAPACITY(CAPACITY)]){0}, \
+                                                       (VALUE_TYPE [HASH_MAP_ALIGN_CAPACITY(CAPACITY)]){0}, \
+                                                       (uint8_t [HASH_SLOT_STATES_SIZE(HASH_MAP_ALIGN_CAPACITY(CAPACITY))]){0}, \
+                                                        HASH_MAP_ALIGN_CAPACITY(CAPACITY))
+#define NEW_PACKED_HASH_MAP_2(KEY_TYPE, VALUE_TYPE, KEY_NAME, CAPACITY) NEW_PACKED_HASH_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, CAPACITY)
+#define NEW_PACKED_HASH_MAP_1(KEY_TYPE, VALUE_TYPE, CAPACITY) NEW_PACKED_HASH_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_TYPE, VALUE_TYPE, CAPACITY)
+
+#define NEW_PACKED_HASH_MAP(...)                                \
+    NEW_HASH_MAP_MACRO(__VA_ARGS__,                             \
+                        NEW_PACKED_HASH_MAP_3,                  \
+                        NEW_PACKED_HASH_MAP_2,                  \
+                        NEW_PACKED_HASH_MAP_1,                  \
+                        ERROR)(__VA_ARGS__)
+
+#define NEW_PACKED_HASH_MAP_4(...)    NEW_PACKED_HASH_MAP(__VA_ARGS__, 4)
+#define NEW_PACKED_HASH_MAP_8(...)    NEW_PACKED_HASH_MAP(__VA_ARGS__, 8)
+#define NEW_PACKED_HASH_MAP_16(...)   NEW_PACKED_HASH_MAP(__VA_ARGS__, 16)
+#define NEW_PACKED_HASH_MAP_32(...)   NEW_PACKED_HASH_MAP(__VA_ARGS__, 32)
+#define NEW_PACKED_HASH_MAP_64(...)   NEW_PACKED_HASH_MAP(__VA_ARGS__, 64)
+#define NEW_PACKED_HASH_MAP_128(...)  NEW_PACKED_HASH_MAP(__VA_ARGS__, 128)
+#define NEW_PACKED_HASH_MAP_256(...)  NEW_PACKED_HASH_MAP(__VA_ARGS__, 256)
+#define NEW_PACKED_HASH_MAP_512(...)  NEW_PACKED_HASH_MAP(__VA_ARGS__, 512)
+#define NEW_PACKED_HASH_MAP_1024(...) NEW_PACKED_HASH_MAP(__VA_ARGS__, 1024)
+
+#define NEW_PACKED_HASH_MAP_OF(CAPACITY, KEY_NAME, VALUE_NAME, ...) \
+HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMapOf)(&(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME)){0}, \
+                                                         (PACKED_HASH_MAP_KEY_TYPEDEF(KEY_NAME, VALUE_NAME) [HASH_MAP_ALIGN_CAPACITY(CAPACITY)]){0}, \
+                                                         (PACKED_HASH_MAP_VALUE_TYPEDEF(KEY_NAME, VALUE_NAME) [HASH_MAP_ALIGN_CAPACITY(CAPACITY)]){0}, \
+                                                         (uint8_t [HASH_SLOT_STATES_SIZE(HASH_MAP_ALIGN_CAPACITY(CAPACITY))]){0}, \
+                                                          HASH_MAP_ALIGN_CAPACITY(CAPACITY),      \
+                                                         (HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) []){__VA_ARGS__}, \
+                                                          VAR_ARGS_LENGTH(HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME), __VA_ARGS__))
+
+#define PACKED_HASH_MAP_OF(KEY_NAME, VALUE_NAME, ...) HASH_MAP_OF_WITH(NEW_PACKED_HASH_MAP_OF, KEY_NAME, VALUE_NAME, __VA_ARGS__)
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "BufferHashSet.h"
+
+// Alternative BufferHashSet layout: values and 2-bit slot states are kept in separate arrays (structure of arrays).
+// There is no per entry padding and flags, e.g. `uint32_t` slot takes 4.25 bytes instead of 8.
+
+#define PACKED_HASH_SET_VALUE_TYPEDEF(NAME) NAME ## SetValue
+
+
+#define CREATE_PACKED_HASH_SET_TYPE_NAME(TYPE, NAME, COMPARE_FUN, HASH_FUN) \
+typedef TYPE PACKED_HASH_SET_VALUE_TYPEDEF(NAME);   /* lets `..._OF()` macros declare arrays by type name */ \
+typedef struct HASH_SET_ENTRY_TYPEDEF(NAME) {       /* only used to pass initial values to `..._OF()` macros */ \
+    TYPE value;                 \
+} HASH_SET_ENTRY_TYPEDEF(NAME); \
+\
+typedef struct HASH_SET_TYPEDEF(NAME) { \
+    TYPE *values;                   \
+    uint8_t *states;                \
+    uint32_t size;                  \
+    uint32_t capacity;              \
+    uint32_t deletedItemsCount;     \
+    uint32_t seed;                  \
+} HASH_SET_TYPEDEF(NAME);           \
+\
+typedef struct HASH_SET_ITERATOR_TYPEDEF(NAME) {    \
+    TYPE value;                                     \
+    HASH_SET_TYPEDEF(NAME) *set;                    \
+    uint32_t index;                                 \
+} HASH_SET_ITERATOR_TYPEDEF(NAME);                  \
+                                                    \
+static inline HASH_SET_TYPEDEF(NAME) * HASH_SET_METHOD(new, NAME, BufferSet)(HASH_SET_TYPEDEF(NAME) *set, TYPE *values, uint8_t *states, uint32_t capacity) { \
+    if (set == NULL) return NULL;       \
+    set->values = values;               \
+    set->states = states;               \
+    set->size = 0;                      \
+    set->capacity = capacity;           \
+    set->deletedItemsCount = 0;         \
+    set->seed = HASH_MAP_NEW_SEED();    \
+    memset(states, 0, HASH_SLOT_STATES_SIZE(capacity)); \
+    return set;                         \
+}                                       \
+                                        \
+static inline uint32_t HASH_SET_METHOD(NAME, SetHomeIndex)(HASH_SET_TYPEDEF(NAME) *set, TYPE value) { \
+    return HASH_MAP_KEY_HASH_CODE(HASH_FUN, value, set->seed) & (set->capacity - 1); \
+}                                                       \
+\
+static inline uint32_t HASH_SET_METHOD(find, NAME, SetSlot)(HASH_SET_TYPEDEF(NAME) *set, TYPE value) { \
+    uint32_t index = HASH_SET_METHOD(NAME, SetHomeIndex)(set, value); \
+    uint32_t freeIndex = set->capacity;                         \
+                                                                \
+    while (true) {                                              \
+        uint8_t state = hashSlotState(set->states, index);      \
+        if (state == HASH_SLOT_EMPTY) {                         \
+            return freeIndex != set->capacity ? freeIndex : index;  /* Slot where value can be placed */ \
+        } else if (state == HASH_SLOT_DELETED) {                \
+            if (freeIndex == set->capacity) {                   \
+                freeIndex = index;                              \
+            }                                                   \
+        } else if (COMPARE_FUN(value, set->values[index]) == 0) {   \
+            return index;                                       \
+        }                                                       \
+        index = (index + 1) & (set->capacity - 1);              \
+    }                                                           \
+}                                                               \
+\
+static inline void HASH_SET_METHOD(NAME, SetCompact)(HASH_SET_TYPEDEF(NAME) *set) { \
+    if (set == NULL || set->deletedItemsCount == 0) return;                     \
+    for (uint32_t i = 0; i < set->capacity; i++) {   /* Tombstones become empty slots, live values are marked as not placed yet */ \
+        uint8_t state = hashSlotState(set->states, i);                          \
+        hashSlotSetState(set->states, i, state == HASH_SLOT_USED ? HASH_SLOT_MOVING : HASH_SLOT_EMPTY); \
+    }                                                                           \
+                                                                                \
+    for (uint32_t i = 0; i < set->capacity; i++) {                              \
+        if (hashSlotState(set->states, i) != HASH_SLOT_MOVING) continue;        \
+        TYPE movedValue = set->values[i];                                       \
+        hashSlotSetState(set->states, i, HASH_SLOT_EMPTY);                      \
+                                                                                \
+        while (true) {  /* Place value to the first slot not taken by placed values, not placed one from that slot is moved next */ \
+            uint32_t index = HASH_SET_METHOD(NAME, SetHomeIndex)(set, movedValue); \
+            while (hashSlotState(set->states, index) == HASH_SLOT_USED) {       \
+                index = (index + 1) & (set->capacity - 1);                      \
+            }                                                                   \
+            bool isDisplaced = hashSlotState(set->states, index) == HASH_SLOT_MOVING; \
+            TYPE displacedValue = set->values[index];                           \
+            set->values[index] = movedValue;                                    \
+            hashSlotSetState(set->states, index, HASH_SLOT_USED);               \
+            if (!isDisplaced) break;                                            \
+            movedValue = displacedValue;                                        \
+        }                                                                       \
+    }                                                                           \
+    set->deletedItemsCount = 0;                                                 \
+}                                                                               \
+\
+static inline bool HASH_SET_METHOD(NAME, SetAdd)(HASH_SET_TYPEDEF(NAME) *set, TYPE value) {   \
+    if (set != NULL && (set->size < (set->capacity / HASH_SET_EXPAND_FACTOR))) {                  \
+        if (set->deletedItemsCount > HASH_SET_TOMBSTONE_PURGE_THRESHOLD(set->capacity)) {       \
+            HASH_SET_METHOD(NAME, SetCompact)(set);                                             \
+        }                                                                                       \
+        uint32_t index = HASH_SET_METHOD(find, NAME, SetSlot)(set, value);                      \
+        uint8_t state = hashSlotState(set->states, index);                                      \
+        if (state == HASH_SLOT_USED) return false;  \
+                                                \
+        if (state == HASH_SLOT_DELETED) {       \
+            set->deletedItemsCount--;           \
+        }                                       \
+        set->values[index] = value;             \
+        hashSlotSetState(set->states, index, HASH_SLOT_USED); \
+        set->size++;                            \
+        return true;                            \
+    }                                           \
+    return false;                               \
+}                                               \
+\
+static inline HASH_SET_TYPEDEF(NAME) * HASH_SET_METHOD(new, NAME, BufferSetOf)(HASH_SET_TYPEDEF(NAME) *set, TYPE *values, uint8_t *states, uint32_t capacity, HASH_SET_ENTRY_TYPEDEF(NAME) *entries, uint32_t size) { \
+    set = HASH_SET_METHOD(new, NAME, BufferSet)(set, values, states, capacity); \
+    for (uint32_t i = 0; set != NULL && i < size; i++) {                        \
+        HASH_SET_METHOD(NAME, SetAdd)(set, entries[i].value);                   \
+    }                                                   \
+    return set;                                         \
+}                                                       \
+\
+static inline uint32_t HASH_SET_METHOD(NAME, SetSize)(HASH_SET_TYPEDEF(NAME) *set) {  \
+    return set != NULL ? set->size : 0; \
+}   \
+\
+static inline bool HASH_SET_METHOD(is, NAME, SetEmpty)(HASH_SET_TYPEDEF(NAME) *set) {  \
+    return set != NULL ? set->size == 0 : true; \
+}   \
+\
+static inline bool HASH_SET_METHOD(is, NAME, SetNotEmpty)(HASH_SET_TYPEDEF(NAME) *set) {   \
+    return !HASH_SET_METHOD(is, NAME, SetEmpty)(set);        \
+}   \
+\
+static inline bool HASH_SET_METHOD(NAME, SetContains)(HASH_SET_TYPEDEF(NAME) *set, TYPE value) {  \
+    if (HASH_SET_METHOD(is, NAME, SetNotEmpty)(set)) {               \
+        uint32_t index = HASH_SET_METHOD(find, NAME, SetSlot)(set, value); \
+        return hashSlotState(set->states, index) == HASH_SLOT_USED;  \
+    }               \
+    return false;   \
+}                   \
+\
+static inline bool HASH_SET_METHOD(NAME, SetRemove)(HASH_SET_TYPEDEF(NAME) *set, TYPE value) { \
+    if (HASH_SET_METHOD(is, NAME, SetNotEmpty)(set)) {                  \
+        uint32_t index = HASH_SET_METHOD(find, NAME, SetSlot)(set, value);  \
+        if (hashSlotState(set->states, index) != HASH_SLOT_USED) return false; \
+        set->values[index] = (TYPE) {0};        \
+        hashSlotSetState(set->states, index, HASH_SLOT_DELETED); \
+        set->size--;                            \
+        set->deletedItemsCount++;               \
+        return true;                            \
+    }                                           \
+    return false;                               \
+}                                               \
+\
+static inline void HASH_SET_METHOD(NAME, SetAddAll)(HASH_SET_TYPEDEF(NAME) *fromSet, HASH_SET_TYPEDEF(NAME) *toSet) {  \
+    for (uint32_t i = 0; i < fromSet->capacity; i++) {                        \
+        if (hashSlotState(fromSet->states, i) == HASH_SLOT_USED) {            \
+            HASH_SET_METHOD(NAME, SetAdd)(toSet, fromSet->values[i]);         \
+        }                                                                     \
+    }                                                                         \
+}                                                                             \
+\
+static inline void HASH_SET_METHOD(NAME, SetClear)(HASH_SET_TYPEDEF(NAME) *set) {    \
+    if (set != NULL && set->states != NULL) {                               \
+        memset(set->states, 0, HASH_SLOT_STATES_SIZE(set->capacity));       \
+        set->size = 0;                                                      \
+        set->deletedItemsCount = 0;                                         \
+    }                                                                       \
+}                                                                           \
+\
+static inline HASH_SET_ITERATOR_TYPEDEF(NAME) HASH_SET_METHOD(NAME, SetIter)(HASH_SET_TYPEDEF(NAME) *set) { \
+    HASH_SET_ITERATOR_TYPEDEF(NAME) iterator = {.set = set, .index = 0};    \
+    return iterator;    \
+}                       \
+\
+static inline bool HASH_SET_METHOD(NAME, SetHasNext)(HASH_SET_ITERATOR_TYPEDEF(NAME) *iterator) { \
+    if (iterator != NULL && iterator->set != NULL) {        \
+        HASH_SET_TYPEDEF(NAME) *set = iterator->set;        \
+        while (iterator->index < set->capacity) {           \
+            uint32_t index = iterator->index++;             \
+            if (hashSlotState(set->states, index) == HASH_SLOT_USED) { \
+                iterator->value = set->values[index];       \
+                return true;                                \
+            }                                               \
+        }                                                   \
+    }                                                       \
+    return false;                                           \
+}                                                           \
+                                                            \
+static inline bool HASH_SET_METHOD(NAME, SetContainsAll)(HASH_SET_TYPEDEF(NAME) *fromSet, HASH_SET_TYPEDEF(NAME) *compareSet) { \
+    HASH_SET_ITERATOR_TYPEDEF(NAME) iterator = HASH_SET_METHOD(NAME, SetIter)(compareSet); \
+    while (HASH_SET_METHOD(NAME, SetHasNext)(&iterator)) {                        \
+        if (!HASH_SET_METHOD(NAME, SetContains)(fromSet, iterator.value)) {       \
+            return false;                                                         \
+        }                                                                         \
+    }                                                                             \
+    return true;                                                                  \
+}\
+
+
+
+#define CREATE_PACKED_HASH_SET_TYPE_1(TYPE) CREATE_PACKED_HASH_SET_TYPE_NAME(TYPE, TYPE, COMPARATOR_FOR_TYPE(TYPE), HASH_CODE_FOR_TYPE(TYPE))
+#define CREATE_PACKED_HASH_SET_TYPE_2(TYPE, NAME) CREATE_PACKED_HASH_SET_TYPE_NAME(TYPE, NAME, COMPARATOR_FOR_TYPE(TYPE), HASH_CODE_FOR_TYPE(TYPE))
+#define CREATE_PACKED_HASH_SET_TYPE_3(TYPE, COMPARE_FUN, HASH_FUN) CREATE_PACKED_HASH_SET_TYPE_NAME(TYPE, TYPE, COMPARE_FUN, HASH_FUN)
+#define CREATE_PACKED_HASH_SET_TYPE_4(TYPE, NAME, COMPARE_FUN, HASH_FUN) CREATE_PACKED_HASH_SET_TYPE_NAME(TYPE, NAME, COMPARE_FUN, HASH_FUN)
+
+#define CREATE_PACKED_HASH_SET_TYPE(...)                                \
+    CREATE_HASH_SET_TYPE_MACRO(__VA_ARGS__,                             \
+                        CREATE_PACKED_HASH_SET_TYPE_4,                  \
+                        CREATE_PACKED_HASH_SET_TYPE_3,                  \
+                        CREATE_PACKED_HASH_SET_TYPE_2,                  \
+                        CREATE_PACKED_HASH_SET_TYPE_1,                  \
+                        ERROR)(__VA_ARGS__)
+
+
+#define NEW_PACKED_HASH_SET(NAME, CAPACITY) \
+HASH_SET_METHOD(new, NAME, BufferSet)(&(HASH_SET_TYPEDEF(NAME)){0}, \
+                                       (PACKED_HASH_SET_VALUE_TYPEDEF(NAME) [HASH_SET_ALIGN_CAPACITY(CAPACITY)]){0}, \
+                                       (uint8_t [HASH_SLOT_STATES_SIZE(HASH_SET_ALIGN_CAPACITY(CAPACITY))]){0}, \
+                                        HASH_SET_ALIGN_CAPACITY(CAPACITY))
+
+#define NEW_PACKED_HASH_SET_4(NAME)    NEW_PACKED_HASH_SET(NAME, 4)
+#define NEW_PACKED_HASH_SET_8(NAME)    NEW_PACKED_HASH_SET(NAME, 8)
+#define NEW_PACKED_HASH_SET_16(NAME)   NEW_PACKED_HASH_SET(NAME, 16)
+#define NEW_PACKED_HASH_SET_32(NAME)   NEW_PACKED_HASH_SET(NAME, 32)
+#define NEW_PACKED_HASH_SET_64(NAME)   NEW_PACKED_HASH_SET(NAME, 64)
+#define NEW_PACKED_HASH_SET_128(NAME)  NEW_PACKED_HASH_SET(NAME, 128)
+#define NEW_PACKED_HASH_SET_256(NAME)  NEW_PACKED_HASH_SET(NAME, 256)
+#define NEW_PACKED_HASH_SET_512(NAME)  NEW_PACKED_HASH_SET(NAME, 512)
+#define NEW_PACKED_HASH_SET_1024(NAME) NEW_PACKED_HASH_SET(NAME, 1024)
+
+#define NEW_PACKED_HASH_SET_OF(CAPACITY, NAME, ...) \
+HASH_SET_METHOD(new, NAME, BufferSetOf)(&(HASH_SET_TYPEDEF(NAME)){0}, \
+                                         (PACKED_HASH_SET_VALUE_TYPEDEF(NAME) [HASH_SET_ALIGN_CAPACITY(CAPACITY)]){0}, \
+                                         (uint8_t [HASH_SLOT_STATES_SIZE(HASH_SET_ALIGN_CAPACITY(CAPACITY))]){0}, \
+                                          HASH_SET_ALIGN_CAPACITY(CAPACITY),      \
+                                         (HASH_SET_ENTRY_TYPEDEF(NAME) []){__VA_ARGS__}, \
+                                          VAR_ARGS_LENGTH(HASH_SET_ENTRY_TYPEDEF(NAME), __VA_ARGS__))
+
+#define PACKED_HASH_SET_OF(NAME, ...) NEW_PACKED_HASH_SET_OF(VAR_ARGS_LENGTH(PACKED_HASH_SET_VALUE_TYPEDEF(NAME), __VA_ARGS__), NAME, __VA_ARGS__)
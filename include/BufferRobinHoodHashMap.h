@@ -0,0 +1,227 @@
+#pragma once
+
+#include "BufferHashMap.h"
+
+// Robin Hood probing layout for BufferHashMap, uses the same method names and `NEW_HASH_MAP...` creation macros.
+// Entries that are far from their home slot take place of closer ones, and removal shifts following entries back instead of leaving tombstones.
+// So probe length stays bounded under constant add/remove traffic in fixed capacity buffer.
+// Removing current key while iterating is supported, other modifications during iteration are not
+#define CREATE_ROBIN_HOOD_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN) \
+typedef struct HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) { \
+    KEY_TYPE key;               \
+    VALUE_TYPE value;           \
+    uint32_t probeLength;       /* 0 for empty slot, otherwise distance from home slot + 1 */ \
+} HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME); \
+\
+typedef struct HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) { \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries; \
+    uint32_t size;                  \
+    uint32_t capacity;              \
+    uint32_t deletedItemsCount;     /* always 0, no tombstones are used */ \
+    uint32_t seed;                  \
+} HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME); \
+\
+typedef struct HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) {    \
+    KEY_TYPE key;                                                   \
+    VALUE_TYPE value;                                               \
+    HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map;                    \
+    uint32_t index;                                                 \
+    uint32_t startIndex;                                            \
+} HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME);                  \
+                                                                    \
+static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMap)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint32_t capacity) { \
+    if (map == NULL) return NULL;       \
+    map->entries = entries;             \
+    map->size = 0;                      \
+    map->capacity = capacity;           \
+    map->deletedItemsCount = 0;         \
+    map->seed = HASH_MAP_NEW_SEED();    \
+                                        \
+    for (uint32_t i = 0; i < capacity; i++) {   \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = &entries[i]; \
+        entry->key = (KEY_TYPE) {0};                \
+        entry->value = (VALUE_TYPE) {0};            \
+        entry->probeLength = 0;                     \
+    }                                               \
+    return map;                                     \
+}                                                   \
+\
+static inline HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    uint32_t index = HASH_MAP_KEY_HASH_CODE(HASH_FUN, key, map->seed) & (map->capacity - 1); \
+    uint32_t probeLength = 1;                                   \
+                                                                \
+    while (true) {                                              \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = &map->entries[index]; \
+        if (entry->probeLength < probeLength) {                 /* Empty slot or entry closer to its home, key would have been placed before */ \
+            return NULL;                                        \
+        }                                                       \
+        if (entry->probeLength == probeLength && COMPARE_FUN(key, entry->key) == 0) { \
+            return entry;                                       \
+        }                                                       \
+        index = (index + 1) & (map->capacity - 1);              \
+        probeLength++;                                          \
+    }                                                           \
+}                                                               \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE value) {   \
+    if (map != NULL && (map->size < (map->capacity / HASH_MAP_EXPAND_FACTOR))) {                           \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key); \
+        if (entry != NULL) {                \
+            entry->value = value;           \
+            return false;                   \
+        }                                   \
+                                            \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) carry = {.key = key, .value = value, .probeLength = 1}; \
+        uint32_t index = HASH_MAP_KEY_HASH_CODE(HASH_FUN, key, map->seed) & (map->capacity - 1); \
+        while (map->entries[index].probeLength != 0) {          \
+            if (map->entries[index].probeLength < carry.probeLength) {  /* Take slot from the closer to home entry and move it further */ \
+                HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) tmp = map->entries[index]; \
+                map->entries[index] = carry;                    \
+                carry = tmp;                                    \
+            }                                                   \
+            index = (index + 1) & (map->capacity - 1);          \
+            carry.probeLength++;                                \
+        }                                                       \
+        map->entries[index] = carry;        \
+        map->size++;                        \
+        return true;                        \
+    }                                       \
+    return false;                           \
+}                                           \
+\
+static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMapOf)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint32_t capacity, uint32_t size) { \
+    if (map == NULL || entries == NULL) return NULL;                                                \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) tmpEntries[size];                                  \
+    memcpy(tmpEntries, entries, sizeof(tmpEntries));                                                \
+    map = HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, BufferMap)(map, entries, capacity);            \
+    for (uint32_t i = 0; i < size; i++) {                                                           \
+        HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(map, tmpEntries[i].key, tmpEntries[i].value); \
+    }                                                                                               \
+    return map;                                                                                     \
+}                                                                                                   \
+\
+static inline uint32_t HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapSize)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return map != NULL ? map->size : 0; \
+}   \
+\
+static inline bool HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return map != NULL ? map->size == 0 : true; \
+}   \
+\
+static inline bool HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {   \
+    return !HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(map);        \
+}   \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapContains)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    return HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(map) &&                                 \
+           HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key) != NULL;                       \
+}  \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetOrDefault)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE defaultValue) { \
+    if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(map)) {                                                          \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key);  \
+        return entry != NULL ? entry->value : defaultValue;   \
+    }                               \
+    return defaultValue;            \
+}                                   \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGet)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) {    \
+    return HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetOrDefault)(map, key, (VALUE_TYPE) {0});                                          \
+}                                   \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRemove)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(map)) {                                                          \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key);  \
+        if (entry == NULL) return (VALUE_TYPE) {0};                 \
+        VALUE_TYPE value = entry->value;                            \
+                                                                    \
+        uint32_t index = (uint32_t) (entry - map->entries);         \
+        uint32_t nextIndex = (index + 1) & (map->capacity - 1);     \
+        while (map->entries[nextIndex].probeLength > 1) {           /* Backward shift until empty slot or entry at its home */ \
+            map->entries[index] = map->entries[nextIndex];          \
+            map->entries[index].probeLength--;                      \
+            index = nextIndex;                                      \
+            nextIndex = (nextIndex + 1) & (map->capacity - 1);      \
+        }                                                           \
+        map->entries[index].key = (KEY_TYPE) {0};                   \
+        map->entries[index].value = (VALUE_TYPE) {0};               \
+        map->entries[index].probeLength = 0;                        \
+        map->size--;                                                \
+        return value;                                               \
+    }                                                               \
+    return (VALUE_TYPE) {0};                                        \
+}                                                                   \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapClear)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {    \
+    if (map != NULL && map->entries != NULL) {          \
+        for (uint32_t i = 0; i < map->capacity; i++) {  \
+            map->entries[i].key = (KEY_TYPE) {0};       \
+            map->entries[i].value = (VALUE_TYPE) {0};   \
+            map->entries[i].probeLength = 0;            \
+        }                                               \
+        map->size = 0;                                  \
+    }                                                   \
+}                                                       \
+\
+static inline HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapIter)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) { \
+    HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) iterator = {.map = map, .index = 0, .startIndex = 0};    \
+    if (map != NULL) {                                                                      \
+        while (iterator.startIndex < map->capacity && map->entries[iterator.startIndex].probeLength != 0) { \
+            iterator.startIndex++;  /* Start from empty slot, so backward shift never moves not visited entry before iterator */ \
+        }                                                                                   \
+    }                   \
+    return iterator;    \
+}                       \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHasNext)(HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) *iterator) { \
+    if (iterator != NULL && iterator->map != NULL) {        \
+        HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map = iterator->map;  \
+        if (iterator->index > 0) {                          /* Current key was removed and next entry shifted in its place */ \
+            HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *previous = &map->entries[(iterator->startIndex + iterator->index - 1) & (map->capacity - 1)]; \
+            if (previous->probeLength != 0 && COMPARE_FUN(previous->key, iterator->key) != 0) { \
+                iterator->key = previous->key;              \
+                iterator->value = previous->value;          \
+                return true;                                \
+            }                                               \
+        }                                                   \
+        while (iterator->index < map->capacity) {           \
+            uint32_t indexValue = (iterator->startIndex + iterator->index) & (map->capacity - 1); \
+            iterator->index++;                              \
+                                                            \
+            HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *pair = &map->entries[indexValue];\
+            if (pair->probeLength != 0) {                   \
+                iterator->key = pair->key;                  \
+                iterator->value = pair->value;              \
+                return true;                                \
+            }                       \
+        }                           \
+        return false;               \
+    }                               \
+    return false;                   \
+}                                   \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAddAll)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *fromMap, HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *toMap) {  \
+    for (uint32_t i = 0; i < fromMap->capacity; i++) {                                        \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = &fromMap->entries[i];           \
+        if (entry->probeLength != 0) {                                                        \
+            HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(toMap, entry->key, entry->value);   \
+        }   \
+    }       \
+}           \
+
+
+
+#define CREATE_ROBIN_HOOD_HASH_MAP_TYPE_1(KEY_TYPE, VALUE_TYPE) CREATE_ROBIN_HOOD_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_TYPE, VALUE_TYPE, COMPARATOR_FOR_TYPE(KEY_TYPE), HASH_CODE_FOR_TYPE(KEY_TYPE))
+#define CREATE_ROBIN_HOOD_HASH_MAP_TYPE_2(KEY_TYPE, VALUE_TYPE, KEY_NAME) CREATE_ROBIN_HOOD_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, COMPARATOR_FOR_TYPE(KEY_TYPE), HASH_CODE_FOR_TYPE(KEY_TYPE))
+#define CREATE_ROBIN_HOOD_HASH_MAP_TYPE_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME) CREATE_ROBIN_HOOD_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARATOR_FOR_TYPE(KEY_TYPE), HASH_CODE_FOR_TYPE(KEY_TYPE))
+#define CREATE_ROBIN_HOOD_HASH_MAP_TYPE_4(KEY_TYPE, VALUE_TYPE, KEY_NAME, COMPARE_FUN, HASH_FUN) CREATE_ROBIN_HOOD_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, COMPARE_FUN, HASH_FUN)
+#define CREATE_ROBIN_HOOD_HASH_MAP_TYPE_5(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN) CREATE_ROBIN_HOOD_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN)
+
+#define CREATE_ROBIN_HOOD_HASH_MAP_TYPE(...)                          \
+    CREATE_HASH_MAP_TYPE_MACRO(__VA_ARGS__,                           \
+                        CREATE_ROBIN_HOOD_HASH_MAP_TYPE_5,            \
+                        CREATE_ROBIN_HOOD_HASH_MAP_TYPE_4,            \
+                        CREATE_ROBIN_HOOD_HASH_MAP_TYPE_3,            \
+                        CREATE_ROBIN_HOOD_HASH_MAP_TYPE_2,            \
+                        CREATE_ROBIN_HOOD_HASH_MAP_TYPE_1,            \
+                        ERROR)(__VA_ARGS__)
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "BufferHashSet.h"
+
+// Robin Hood probing layout for BufferHashSet, uses the same method names and `NEW_HASH_SET...` creation macros.
+// Removal shifts following entries back instead of leaving tombstones, so probe length stays bounded under churn.
+// Removing current value while iterating is supported, other modifications during iteration are not
+#define CREATE_ROBIN_HOOD_HASH_SET_TYPE_NAME(TYPE, NAME, COMPARE_FUN, HASH_FUN) \
+typedef struct HASH_SET_ENTRY_TYPEDEF(NAME) { \
+    TYPE value;                 \
+    uint32_t probeLength;       /* 0 for empty slot, otherwise distance from home slot + 1 */ \
+} HASH_SET_ENTRY_TYPEDEF(NAME); \
+\
+typedef struct HASH_SET_TYPEDEF(NAME) { \
+    HASH_SET_ENTRY_TYPEDEF(NAME) *entries; \
+    uint32_t size;                  \
+    uint32_t capacity;              \
+    uint32_t deletedItemsCount;     /* always 0, no tombstones are used */ \
+    uint32_t seed;                  \
+} HASH_SET_TYPEDEF(NAME);           \
+\
+typedef struct HASH_SET_ITERATOR_TYPEDEF(NAME) {    \
+    TYPE value;                                     \
+    HASH_SET_TYPEDEF(NAME) *set;                    \
+    uint32_t index;                                 \
+    uint32_t startIndex;                            \
+} HASH_SET_ITERATOR_TYPEDEF(NAME);                  \
+                                                    \
+static inline HASH_SET_TYPEDEF(NAME) * HASH_SET_METHOD(new, NAME, BufferSet)(HASH_SET_TYPEDEF(NAME) *set, HASH_SET_ENTRY_TYPEDEF(NAME) *entries, uint32_t capacity) { \
+    if (set == NULL) return NULL;       \
+    set->entries = entries;             \
+    set->size = 0;                      \
+    set->capacity = capacity;           \
+    set->deletedItemsCount = 0;         \
+    set->seed = HASH_MAP_NEW_SEED();    \
+    \
+    for (uint32_t i = 0; i < capacity; i++) {   \
+        HASH_SET_ENTRY_TYPEDEF(NAME) *entry = &entries[i]; \
+        entry->value = (TYPE) {0};              \
+        entry->probeLength = 0;                 \
+    }                                           \
+    return set;                                 \
+}                                               \
+                                                \
+static inline HASH_SET_ENTRY_TYPEDEF(NAME) * HASH_SET_METHOD(find, NAME, SetEntry)(HASH_SET_TYPEDEF(NAME) *set, TYPE value) { \
+    uint32_t index = HASH_MAP_KEY_HASH_CODE(HASH_FUN, value, set->seed) & (set->capacity - 1); \
+    uint32_t probeLength = 1;                               \
+                                                            \
+    while (true) {                                          \
+        HASH_SET_ENTRY_TYPEDEF(NAME) *entry = &set->entries[index]; \
+        if (entry->probeLength < probeLength) {             /* Empty slot or entry closer to its home, value would have been placed before */ \
+            return NULL;                                    \
+        }                                                   \
+        if (entry->probeLength == probeLength && COMPARE_FUN(value, entry->value) == 0) { \
+            return entry;                                   \
+        }                                                   \
+        index = (index + 1) & (set->capacity - 1);          \
+        probeLength++;                                      \
+    }                                                       \
+}                                                           \
+\
+static inline bool HASH_SET_METHOD(NAME, SetAdd)(HASH_SET_TYPEDEF(NAME) *set, TYPE value) {   \
+    if (set != NULL && (set->size < (set->capacity / HASH_SET_EXPAND_FACTOR))) {                  \
+        if (HASH_SET_METHOD(find, NAME, SetEntry)(set, value) != NULL) {  \
+            return false;                                   \
+        }                                                   \
+                                                            \
+        HASH_SET_ENTRY_TYPEDEF(NAME) carry = {.value = value, .probeLength = 1}; \
+        uint32_t index = HASH_MAP_KEY_HASH_CODE(HASH_FUN, value, set->seed) & (set->capacity - 1); \
+        while (set->entries[index].probeLength != 0) {              \
+            if (set->entries[index].probeLength < carry.probeLength) {  /* Take slot from the closer to home entry and move it further */ \
+                HASH_SET_ENTRY_TYPEDEF(NAME) tmp = set->entries[index]; \
+                set->entries[index] = carry;                        \
+                carry = tmp;                                        \
+            }                                                       \
+            index = (index + 1) & (set->capacity - 1);              \
+            carry.probeLength++;                                    \
+        }                                   \
+        set->entries[index] = carry;        \
+        set->size++;                        \
+        return true;                        \
+    }                                       \
+    return false;                           \
+}                                           \
+\
+static inline HASH_SET_TYPEDEF(NAME) * HASH_SET_METHOD(new, NAME, BufferSetOf)(HASH_SET_TYPEDEF(NAME) *set, HASH_SET_ENTRY_TYPEDEF(NAME) *entries, uint32_t capacity, uint32_t size) { \
+    if (set == NULL || entries == NULL) return NULL;    \
+    HASH_SET_ENTRY_TYPEDEF(NAME) tmpEntries[size];      \
+    memcpy(tmpEntries, entries, sizeof(tmpEntries));    \
+    set = HASH_SET_METHOD(new, NAME, BufferSet)(set, entries, capacity); \
+    for (uint32_t i = 0; i < size; i++) {               \
+        HASH_SET_METHOD(NAME, SetAdd)(set, tmpEntries[i].value); \
+    }                                                   \
+    return set;                                         \
+}                                                       \
+\
+static inline uint32_t HASH_SET_METHOD(NAME, SetSize)(HASH_SET_TYPEDEF(NAME) *set) {  \
+    return set != NULL ? set->size : 0; \
+}   \
+\
+static inline bool HASH_SET_METHOD(is, NAME, SetEmpty)(HASH_SET_TYPEDEF(NAME) *set) {  \
+    return set != NULL ? set->size == 0 : true; \
+}   \
+\
+static inline bool HASH_SET_METHOD(is, NAME, SetNotEmpty)(HASH_SET_TYPEDEF(NAME) *set) {   \
+    return !HASH_SET_METHOD(is, NAME, SetEmpty)(set);        \
+}   \
+\
+static inline bool HASH_SET_METHOD(NAME, SetContains)(HASH_SET_TYPEDEF(NAME) *set, TYPE value) {  \
+    return HASH_SET_METHOD(is, NAME, SetNotEmpty)(set) &&                         \
+           HASH_SET_METHOD(find, NAME, SetEntry)(set, value) != NULL;             \
+}                   \
+\
+static inline bool HASH_SET_METHOD(NAME, SetRemove)(HASH_SET_TYPEDEF(NAME) *set, TYPE value) { \
+    if (HASH_SET_METHOD(is, NAME, SetNotEmpty)(set)) {                                          \
+        HASH_SET_ENTRY_TYPEDEF(NAME) *entry = HASH_SET_METHOD(find, NAME, SetEntry)(set, value);  \
+        if (entry == NULL) return false;                            \
+                                                                    \
+        uint32_t index = (uint32_t) (entry - set->entries);         \
+        uint32_t nextIndex = (index + 1) & (set->capacity - 1);     \
+        while (set->entries[nextIndex].probeLength > 1) {           /* Backward shift until empty slot or entry at its home */ \
+            set->entries[index] = set->entries[nextIndex];          \
+            set->entries[index].probeLength--;                      \
+            index = nextIndex;                                      \
+            nextIndex = (nextIndex + 1) & (set->capacity - 1);      \
+        }                                                           \
+        set->entries[index].value = (TYPE) {0};     \
+        set->entries[index].probeLength = 0;        \
+        set->size--;                                \
+        return true;                                \
+    }                                               \
+    return false;                                   \
+}                                                   \
+\
+static inline void HASH_SET_METHOD(NAME, SetAddAll)(HASH_SET_TYPEDEF(NAME) *fromSet, HASH_SET_TYPEDEF(NAME) *toSet) {  \
+    for (uint32_t i = 0; i < fromSet->capacity; i++) {                        \
+        HASH_SET_ENTRY_TYPEDEF(NAME) *entry = &fromSet->entries[i];           \
+        if (entry->probeLength != 0) {                                        \
+            HASH_SET_METHOD(NAME, SetAdd)(toSet, entry->value);               \
+        }                                                                     \
+    }                                                                         \
+}                                                                    \
+\
+static inline void HASH_SET_METHOD(NAME, SetClear)(HASH_SET_TYPEDEF(NAME) *set) {    \
+    if (set != NULL && set->entries != NULL) {          \
+        for (uint32_t i = 0; i < set->capacity; i++) {  \
+            set->entries[i].value = (TYPE) {0};         \
+            set->entries[i].probeLength = 0;            \
+        }                                               \
+        set->size = 0;                                  \
+    }                                                   \
+}                                                       \
+\
+static inline HASH_SET_ITERATOR_TYPEDEF(NAME) HASH_SET_METHOD(NAME, SetIter)(HASH_SET_TYPEDEF(NAME) *set) { \
+    HASH_SET_ITERATOR_TYPEDEF(NAME) iterator = {.set = set, .index = 0, .startIndex = 0};    \
+    if (set != NULL) {                                                                      \
+        while (iterator.startIndex < set->capacity && set->entries[iterator.startIndex].probeLength != 0) { \
+            iterator.startIndex++;  /* Start from empty slot, so backward shift never moves not visited entry before iterator */ \
+        }                                                                                   \
+    }                   \
+    return iterator;    \
+}                       \
+\
+static inline bool HASH_SET_METHOD(NAME, SetHasNext)(HASH_SET_ITERATOR_TYPEDEF(NAME) *iterator) { \
+    if (iterator != NULL && iterator->set != NULL) {        \
+        HASH_SET_TYPEDEF(NAME) *set = iterator->set;        \
+        if (iterator->index > 0) {                          /* Current value was removed and next entry shifted in its place */ \
+            HASH_SET_ENTRY_TYPEDEF(NAME) *previous = &set->entries[(iterator->startIndex + iterator->index - 1) & (set->capacity - 1)]; \
+            if (previous->probeLength != 0 && COMPARE_FUN(previous->value, iterator->value) != 0) { \
+                iterator->value = previous->value;          \
+                return true;                                \
+            }                                               \
+        }                                                   \
+        while (iterator->index < set->capacity) {           \
+            uint32_t indexValue = (iterator->startIndex + iterator->index) & (set->capacity - 1); \
+            iterator->index++;                              \
+                                                            \
+            HASH_SET_ENTRY_TYPEDEF(NAME) *pair = &set->entries[indexValue]; \
+            if (pair->probeLength != 0) {                   \
+                iterator->value = pair->value;              \
+                return true;                                \
+            }                       \
+        }                           \
+        return false;               \
+    }                               \
+    return false;                   \
+}                                                                    \
+                                                                     \
+static inline bool HASH_SET_METHOD(NAME, SetContainsAll)(HASH_SET_TYPEDEF(NAME) *fromSet, HASH_SET_TYPEDEF(NAME) *compareSet) { \
+    HASH_SET_ITERATOR_TYPEDEF(NAME) iterator = HASH_SET_METHOD(NAME, SetIter)(compareSet); \
+    while (HASH_SET_METHOD(NAME, SetHasNext)(&iterator)) {                        \
+        if (!HASH_SET_METHOD(NAME, SetContains)(fromSet, iterator.value)) {       \
+            return false;                                                         \
+        }                                                                         \
+    }                                                                             \
+    return true;                                                                  \
+}\
+
+
+
+#define CREATE_ROBIN_HOOD_HASH_SET_TYPE_1(TYPE) CREATE_ROBIN_HOOD_HASH_SET_TYPE_NAME(TYPE, TYPE, COMPARATOR_FOR_TYPE(TYPE), HASH_CODE_FOR_TYPE(TYPE))
+#define CREATE_ROBIN_HOOD_HASH_SET_TYPE_2(TYPE, NAME) CREATE_ROBIN_HOOD_HASH_SET_TYPE_NAME(TYPE, NAME, COMPARATOR_FOR_TYPE(TYPE), HASH_CODE_FOR_TYPE(TYPE))
+#define CREATE_ROBIN_HOOD_HASH_SET_TYPE_3(TYPE, COMPARE_FUN, HASH_FUN) CREATE_ROBIN_HOOD_HASH_SET_TYPE_NAME(TYPE, TYPE, COMPARE_FUN, HASH_FUN)
+#define CREATE_ROBIN_HOOD_HASH_SET_TYPE_4(TYPE, NAME, COMPARE_FUN, HASH_FUN) CREATE_ROBIN_HOOD_HASH_SET_TYPE_NAME(TYPE, NAME, COMPARE_FUN, HASH_FUN)
+
+#define CREATE_ROBIN_HOOD_HASH_SET_TYPE(...)                          \
+    CREATE_HASH_SET_TYPE_MACRO(__VA_ARGS__,                           \
+                        CREATE_ROBIN_HOOD_HASH_SET_TYPE_4,            \
+                        CREATE_ROBIN_HOOD_HASH_SET_TYPE_3,            \
+                        CREATE_ROBIN_HOOD_HASH_SET_TYPE_2,            \
+                        CREATE_ROBIN_HOOD_HASH_SET_TYPE_1,            \
+                        ERROR)(__VA_ARGS__)
@@ -20,6 +20,20 @@
 
 #define NEXT_POW_OF_2(val) (NEXT_POW_OF_TWO_5(val) + 1)
 
+#define STR_HASH_FNV_1A 1   // byte at a time, cheap on 8/16/32-bit MCUs without fast 64-bit multiplication
+#define STR_HASH_WYHASH 2   // 8 bytes per step with 64x64->128 bit multiply mixing, much faster for long keys on 64-bit CPUs
+
+#ifndef STR_HASH_ALGORITHM
+#define STR_HASH_ALGORITHM STR_HASH_FNV_1A  // used by strHashCode() and HashMap keys
+#endif
+
+#define INT_HASH_IDENTITY 1   // value itself, cheapest, sequential keys don't collide, but keys with power of 2 stride share a few slots
+#define INT_HASH_MURMUR3  2   // murmur3 finalizer, every key bit affects slot index bits, a few multiplications per hash
+
+#ifndef INT_HASH_ALGORITHM
+#define INT_HASH_ALGORITHM INT_HASH_IDENTITY  // used by CREATE_NUMBER_HASH_CODE() types and 64-bit integer hash codes
+#endif
+
 #define COMPARATOR_FOR_TYPE(TYPE) TYPE ## Comparator
 #define HASH_CODE_FOR_TYPE(TYPE)  TYPE ## HashCode
 
@@ -30,9 +44,15 @@ static inline int NAME ##Comparator(TYPE one, TYPE two) { \
     return (((one) < (two)) ? (-1) : (((one) == (two)) ? 0 : 1));             \
 } \
 
+#if INT_HASH_ALGORITHM == INT_HASH_MURMUR3
+#define NUMBER_HASH_CODE(TYPE, value) (sizeof(TYPE) > sizeof(uint32_t) ? hashMix64((uint64_t) (value)) : hashMix32((uint32_t) (value)))
+#else
+#define NUMBER_HASH_CODE(TYPE, value) ((uint32_t) (value))
+#endif
+
 #define CREATE_NUMBER_HASH_CODE(NAME, TYPE) \
 static inline uint32_t NAME ##HashCode(TYPE value) { \
-    return (uint32_t) value;             \
+    return NUMBER_HASH_CODE(TYPE, value); \
 } \
 
 #define CREATE_CUSTOM_COMPARATOR(NAME, TYPE, PARAM_NAME_1, PARAM_NAME_2, EXPR) \
@@ -45,6 +65,24 @@ static inline uint32_t NAME ##HashCode(TYPE PARAM_NAME) { \
     return (EXPR);             \
 }
 
+static inline uint32_t hashMix32(uint32_t hash) {  // murmur3 finalizer, every hash bit affects all slot index bits
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6B;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+static inline uint32_t hashMix64(uint64_t hash) {  // murmur3 64-bit finalizer, folded to 32 bits
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return (uint32_t) hash ^ (uint32_t) (hash >> 32);
+}
+
 CREATE_NUMBER_COMPARATOR(int, int);                 // intComparator()
 CREATE_NUMBER_COMPARATOR(long, long);               // longComparator()
 CREATE_NUMBER_COMPARATOR(char, char);               // charComparator()
@@ -60,7 +98,6 @@ CREATE_NUMBER_COMPARATOR(uint64_t, uint64_t);       // uint64_tComparator()
 CREATE_NUMBER_HASH_CODE(int, int);                 // intHashCode()
 CREATE_NUMBER_HASH_CODE(long, long);               // longHashCode()
 CREATE_NUMBER_HASH_CODE(char, char);               // charHashCode()
-CREATE_NUMBER_HASH_CODE(float, float);             // floatHashCode()
 CREATE_NUMBER_HASH_CODE(int8_t, int8_t);           // int8_tHashCode()
 CREATE_NUMBER_HASH_CODE(uint8_t, uint8_t);         // uint8_tHashCode()
 CREATE_NUMBER_HASH_CODE(int16_t, int16_t);         // int16_tHashCode()
@@ -78,19 +115,47 @@ static inline int strComparator(const char *one, const char *two) {
 }
 
 static inline uint32_t int64_tHashCode(int64_t value) {
+#if INT_HASH_ALGORITHM == INT_HASH_MURMUR3
+    return hashMix64((uint64_t) value);
+#else
     return LL_HASH_CODE(value);
+#endif
 }
 
 static inline uint32_t uint64_tHashCode(uint64_t value) {
+#if INT_HASH_ALGORITHM == INT_HASH_MURMUR3
+    return hashMix64(value);
+#else
     return LL_HASH_CODE(value);
+#endif
+}
+
+static inline uint32_t floatHashCode(float value) {  // Hash of bit pattern is always mixed, low mantissa bits of round values are zero
+    uint32_t bits = 0x7FC00000;    // all NaNs share the hash
+    if (value == 0.0f) {
+        bits = 0;                  // -0.0 and 0.0 are equal for floatComparator()
+    } else if (value == value) {
+        memcpy(&bits, &value, sizeof(bits));
+    }
+    return hashMix32(bits);
 }
 
 static inline uint32_t doubleHashCode(double value) {
-    int64_t bits = (int64_t) value;
-    return LL_HASH_CODE(bits);
+    uint64_t bits = 0x7FF8000000000000ull;
+    if (value == 0.0) {
+        bits = 0;
+    } else if (value == value) {
+        memcpy(&bits, &value, sizeof(bits));
+    }
+    return hashMix64(bits);
 }
 
 uint32_t strHashCode(const char *key);
+uint32_t strHashCodeN(const char *key, uint32_t length); // same as strHashCode() for the key with known length, no NUL terminator required
+uint32_t fnv1aHashCode(const char *key, uint32_t length);
+uint32_t wyHashCode(const char *key, uint32_t length);
+uint32_t strHashCodeSeeded(const char *key, uint32_t length, uint32_t seed);  // seed changes the whole hash, not only the slot index
+uint32_t hashSeedNext(void);
 
 int doubleComparator(double one, double two);
 int floatComparator(float one, float two);
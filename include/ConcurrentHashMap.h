@@ -0,0 +1,46 @@
+#pragma once
+
+#include <pthread.h>
+#include "HashMap.h"
+
+#ifndef CONCURRENT_HASH_MAP_SHARD_COUNT
+#define CONCURRENT_HASH_MAP_SHARD_COUNT 16  // Shards used when 0 passed on creation, rounded up to power of two
+#endif
+
+#ifndef CONCURRENT_HASH_MAP_CACHE_LINE_SIZE
+#define CONCURRENT_HASH_MAP_CACHE_LINE_SIZE 64
+#endif
+
+typedef struct ConcurrentHashMap *ConcurrentHashMap;
+
+typedef struct ConcurrentHashMapShard {
+    pthread_rwlock_t lock;
+    HashMap hashMap;
+    uint32_t size;  // shard map size copy, summed without locks by getConcurrentHashMapSize()
+    char padding[CONCURRENT_HASH_MAP_CACHE_LINE_SIZE];  // keeps neighbour shard lock out of this shard cache lines
+} ConcurrentHashMapShard;
+
+struct ConcurrentHashMap {
+    ConcurrentHashMapShard *shards;
+    uint32_t shardCount;
+    uint32_t shardShift;    // shard is selected by high hash bits, table slot by low bits of the same hash
+    bool isKeyOwner;
+};
+
+ConcurrentHashMap getConcurrentHashMapInstance(uint32_t capacity, uint32_t shardCount);
+ConcurrentHashMap getKeyOwningConcurrentHashMapInstance(uint32_t capacity, uint32_t shardCount);  // keys are copied, so callers can reuse key buffers right after put
+
+bool concurrentHashMapPut(ConcurrentHashMap map, const char *key, MapValueType value);
+bool concurrentHashMapPutN(ConcurrentHashMap map, const char *key, uint32_t length, MapValueType value);
+MapValueType concurrentHashMapGet(ConcurrentHashMap map, const char *key);
+MapValueType concurrentHashMapGetN(ConcurrentHashMap map, const char *key, uint32_t length);
+MapValueType concurrentHashMapRemove(ConcurrentHashMap map, const char *key);
+MapValueType concurrentHashMapRemoveN(ConcurrentHashMap map, const char *key, uint32_t length);
+MapValueType concurrentHashMapCompute(ConcurrentHashMap map, const char *key, MapComputeFunction function, void *context);  // function is called under shard write lock
+bool isConcurrentHashMapContainsKey(ConcurrentHashMap map, const char *key);
+
+void concurrentHashMapClear(ConcurrentHashMap map);
+uint32_t getConcurrentHashMapSize(ConcurrentHashMap map);   // sum of shard sizes, not a snapshot while other threads write
+bool isConcurrentHashMapEmpty(ConcurrentHashMap map);
+
+void concurrentHashMapDelete(ConcurrentHashMap map);
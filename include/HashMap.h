@@ -4,18 +4,42 @@
 #include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "HashTableCommon.h"
 
 #ifndef HASH_MAP_LOAD_FACTOR
 #define HASH_MAP_LOAD_FACTOR 0.75
 #endif
 
+// #define HASH_MAP_ROBIN_HOOD  // Robin Hood probing with backward shift deletion instead of tombstones, keeps probe length bounded under insert/remove churn
+// #define HASH_MAP_INCREMENTAL_REHASH  // Resize moves entries to the new table by parts on each put/remove, instead of single stop-the-world rehash
+
+#ifndef HASH_MAP_REHASH_STEP
+#define HASH_MAP_REHASH_STEP 16   // Old table slots migrated per put/remove call in incremental rehash mode, at least 2 to finish before the next resize
+#endif
+
+#ifndef HASH_MAP_KEY_ARENA_MIN_SIZE
+#define HASH_MAP_KEY_ARENA_MIN_SIZE 256  // Initial key arena size in bytes for key owning map
+#endif
+
+#define HASH_MAP_VACATED_SLOT UINT32_MAX   // Robin Hood probe length mark for old table slot left by migration or removal
+
 typedef struct HashMap *HashMap;
 typedef void* MapValueType; // Map can keep any type, change for specific
 
+// Remaps key value, value is NULL for absent key. Returned value is stored, NULL result removes the key
+typedef MapValueType (*MapComputeFunction)(const char *key, MapValueType value, void *context);
+
 typedef struct MapEntry {
     char *key;  // key is NULL if this slot empty
     MapValueType value;
+    uint32_t hash;  // cached key hashCode, compared before key and reused on resize
+    uint32_t keyLength; // key is not required to be NUL-terminated when added with length
+#ifdef HASH_MAP_ROBIN_HOOD
+    uint32_t probeLength;   // distance from home slot
+#else
     bool isDeleted;
+#endif
+    HASH_GENERATION_SLOT_FIELD  // with `HASH_MAP_GENERATION_CLEAR`, slot stamped before the last clear is empty
 } MapEntry;
 
 struct HashMap {
@@ -23,26 +47,59 @@ struct HashMap {
     uint32_t size;
     uint32_t capacity;
     uint32_t deletedItemsCount;
+    uint32_t seed;              // mixed into key hash with `HASH_MAP_SEEDED_HASH`, 0 otherwise
+    bool isKeyOwner;            // keys are copied to the map arena instead of keeping caller pointers
+    char *keyArena;             // NUL-terminated key copies, removed keys stay until arena compaction
+    uint32_t keyArenaSize;
+    uint32_t keyArenaCapacity;
+    uint32_t keyArenaRemovedSize;   // bytes of removed keys, arena is compacted when they take a quarter of it
+#ifdef HASH_MAP_STATS
+    uint32_t resizeCount;
+#endif
+    HASH_GENERATION_TABLE_FIELDS
+#ifdef HASH_MAP_INCREMENTAL_REHASH
+    MapEntry *oldEntries;   // previous table, not NULL while entries are migrated from it
+    uint32_t oldCapacity;
+    uint32_t migrateIndex;  // next old table slot to migrate
+#endif
 };
 
 typedef struct HashMapIterator {
     const char *key;
+    uint32_t keyLength;
     MapValueType value;
     HashMap hashMap;
     uint32_t index;
+    uint32_t startIndex;
 } HashMapIterator;
 
 HashMap getHashMapInstance(uint32_t capacity);
+HashMap getKeyOwningHashMapInstance(uint32_t capacity);    // keeps own copies of the keys, so caller buffers can be reused right after put
 
 bool hashMapPut(HashMap hashMap, const char *key, MapValueType value);
+bool hashMapPutN(HashMap hashMap, const char *key, uint32_t length, MapValueType value);
+bool hashMapPutWithHash(HashMap hashMap, const char *key, uint32_t length, uint32_t hash, MapValueType value);
 MapValueType hashMapGet(HashMap hashMap, const char *key);
+MapValueType hashMapGetN(HashMap hashMap, const char *key, uint32_t length);
+MapValueType hashMapGetWithHash(HashMap hashMap, const char *key, uint32_t length, uint32_t hash);
 MapValueType hashMapGetOrDefault(HashMap hashMap, const char *key, MapValueType defaultValue);
+void hashMapGetBatch(HashMap hashMap, const char *keys[], uint32_t count, MapValueType values[]);  // values[i] is NULL when keys[i] not found
 MapEntry *hashMapGetEntry(HashMap hashMap, const char *key);
+MapEntry *hashMapGetEntryWithHash(HashMap hashMap, const char *key, uint32_t length, uint32_t hash);  // entry of the key, tells absent key from NULL value
+
+MapValueType hashMapCompute(HashMap hashMap, const char *key, MapComputeFunction function, void *context);   // single probe read-modify-write, returns new value
+MapValueType hashMapComputeWithHash(HashMap hashMap, const char *key, uint32_t length, uint32_t hash, MapComputeFunction function, void *context);
+MapValueType *hashMapGetOrInsert(HashMap hashMap, const char *key, MapValueType defaultValue); // value slot of the key, valid until next put/remove, NULL when out of memory
+MapValueType *hashMapGetOrInsertWithHash(HashMap hashMap, const char *key, uint32_t length, uint32_t hash, MapValueType defaultValue);
 
 MapValueType hashMapRemove(HashMap hashMap, const char *key);
+MapValueType hashMapRemoveN(HashMap hashMap, const char *key, uint32_t length);
+MapValueType hashMapRemoveWithHash(HashMap hashMap, const char *key, uint32_t length, uint32_t hash);
 MapValueType hashMapRemoveEntry(HashMap hashMap, MapEntry *entry);
 
-void hashMapAddAll(HashMap from, HashMap to);
+void hashMapAddAll(HashMap from, HashMap to);  // destination is resized once up front for all keys of both maps
+bool hashMapReserve(HashMap hashMap, uint32_t size);    // preallocates table for `size` keys, no resize while adding them
+bool hashMapShrinkToFit(HashMap hashMap);   // smallest table for current size, drops removed entries and bytes of removed owned keys
 void hashMapClear(HashMap hashMap);
 
 bool isHashMapEmpty(HashMap hashMap);
@@ -55,4 +112,10 @@ bool hashMapHasNext(HashMapIterator *iterator);
 
 void hashMapDelete(HashMap hashMap);
 
+#ifdef HASH_MAP_STATS
+void hashMapGetStats(HashMap hashMap, HashTableStats *stats);  // walks the whole table, call from diagnostics, not from hot paths
+#endif
+
+uint32_t hashMapKeyHashCode(HashMap hashMap, const char *key, uint32_t length);   // hash expected by `...WithHash()` functions of this map
+
 void initSingletonHashMap(HashMap *hashMap, uint32_t capacity);
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Comparator.h"
+
+// Build options and helpers shared by HashMap and buffer Map/Set/Bloom filter tables: seeding, batch lookup, slot states, statistics and generations
+
+// #define HASH_MAP_SEEDED_HASH   // Random per map seed mixed into key hash, crafted keys can't be sent to a single probe chain
+
+#ifndef HASH_MAP_SEED
+#define HASH_MAP_SEED() hashSeedNext()  // Seed source for new maps, redefine to hardware RNG read if available
+#endif
+
+#ifdef HASH_MAP_SEEDED_HASH
+#define HASH_MAP_NEW_SEED() HASH_MAP_SEED()
+#define HASH_MAP_SEEDED_HASH_CODE(HASH, SEED) seededHashCode((HASH), (SEED))
+#define HASH_MAP_SEEDED_FUN_strHashCode ~, HASH_MAP_STR_KEY_HASH_CODE   // string hash takes seed as initial state, so full hash collisions differ per map too
+#else
+#define HASH_MAP_NEW_SEED() 0
+#define HASH_MAP_SEEDED_HASH_CODE(HASH, SEED) (HASH)
+#endif
+
+// Key hash of buffer Map/Set, HASH_FUN with seeded variant registered as `HASH_MAP_SEEDED_FUN_<HASH_FUN>` is called instead of seed mixing after it
+#define HASH_MAP_KEY_HASH_CODE(HASH_FUN, KEY, SEED) HASH_MAP_PICK_SECOND(HASH_MAP_SEEDED_FUN_ ## HASH_FUN, HASH_MAP_FUN_KEY_HASH_CODE, ~)(HASH_FUN, KEY, SEED)
+#define HASH_MAP_FUN_KEY_HASH_CODE(HASH_FUN, KEY, SEED) HASH_MAP_SEEDED_HASH_CODE(HASH_FUN(KEY), SEED)
+#define HASH_MAP_STR_KEY_HASH_CODE(HASH_FUN, KEY, SEED) strHashCodeSeeded((KEY), strlen(KEY), (SEED))
+#define HASH_MAP_PICK_SECOND(...) HASH_MAP_SECOND_ARG(__VA_ARGS__)
+#define HASH_MAP_SECOND_ARG(FIRST, SECOND, ...) SECOND
+
+#ifndef HASH_MAP_BATCH_SIZE
+#define HASH_MAP_BATCH_SIZE 16  // Keys hashed and prefetched ahead of the first probe in batch lookup
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define HASH_MAP_PREFETCH(ADDRESS) __builtin_prefetch((ADDRESS), 0, 1)
+#else
+#define HASH_MAP_PREFETCH(ADDRESS) ((void) (ADDRESS))
+#endif
+
+#define HASH_SLOT_EMPTY   0   // 2-bit slot states of packed Map/Set layouts, four slots per byte
+#define HASH_SLOT_USED    1
+#define HASH_SLOT_DELETED 2
+#define HASH_SLOT_MOVING  3   // live slot not placed yet by in place rehash
+#define HASH_SLOT_STATES_SIZE(CAPACITY) (((CAPACITY) + 3) / 4)
+
+// #define HASH_MAP_STATS  // Adds ...GetStats() with probe length and occupancy report to HashMap and buffer Map/Set
+
+#ifndef HASH_STATS_HISTOGRAM_SIZE
+#define HASH_STATS_HISTOGRAM_SIZE 16    // probe length histogram buckets, the last one counts all longer probes
+#endif
+
+#ifdef HASH_MAP_STATS
+#define HASH_STATS_RESIZE_COUNT_FIELD uint32_t resizeCount;   // member of buffer Map/Set struct
+#define HASH_STATS_RESET_RESIZE_COUNT(TABLE) ((TABLE)->resizeCount = 0)
+#define HASH_STATS_COUNT_RESIZE(TABLE) ((TABLE)->resizeCount++)
+#else
+#define HASH_STATS_RESIZE_COUNT_FIELD
+#define HASH_STATS_RESET_RESIZE_COUNT(TABLE) ((void) 0)
+#define HASH_STATS_COUNT_RESIZE(TABLE) ((void) 0)
+#endif
+
+// #define HASH_MAP_GENERATION_CLEAR  // Slots are stamped with table generation, clear only bumps it and slots with older stamp read as empty
+
+#ifdef HASH_MAP_GENERATION_CLEAR
+#define HASH_GENERATION_SLOT_FIELD uint16_t generation;   // member of Map/Set entry
+#define HASH_GENERATION_TABLE_FIELDS uint16_t generation; bool hasStaleSlots;   // members of Map/Set struct
+#define HASH_GENERATION_RESET(TABLE) ((TABLE)->generation = 0, (TABLE)->hasStaleSlots = false)
+#define HASH_GENERATION_OF(TABLE) ((TABLE)->generation)
+#define HASH_GENERATION_IS_STALE(SLOT, GENERATION) ((SLOT)->generation != (GENERATION))
+#define HASH_GENERATION_STAMP(SLOT, GENERATION) ((SLOT)->generation = (GENERATION))
+#define HASH_GENERATION_HAS_STALE_SLOTS(TABLE) ((TABLE)->hasStaleSlots)
+#define HASH_GENERATION_SWEPT(TABLE) ((TABLE)->hasStaleSlots = false)
+#define HASH_GENERATION_ADVANCE(TABLE) ((TABLE)->hasStaleSlots = (++(TABLE)->generation != 0))  // false on wraparound, then every slot must be reset
+#else
+#define HASH_GENERATION_SLOT_FIELD
+#define HASH_GENERATION_TABLE_FIELDS
+#define HASH_GENERATION_RESET(TABLE) ((void) 0)
+#define HASH_GENERATION_OF(TABLE) 0
+#define HASH_GENERATION_IS_STALE(SLOT, GENERATION) false
+#define HASH_GENERATION_STAMP(SLOT, GENERATION) ((void) 0)
+#define HASH_GENERATION_HAS_STALE_SLOTS(TABLE) false
+#define HASH_GENERATION_SWEPT(TABLE) ((void) 0)
+#define HASH_GENERATION_ADVANCE(TABLE) false
+#endif
+
+static inline uint32_t seededHashCode(uint32_t hash, uint32_t seed) {
+    return hashMix32(hash ^ seed);
+}
+
+static inline uint8_t hashSlotState(const uint8_t *states, uint32_t index) {
+    return (states[index >> 2] >> ((index & 3) << 1)) & 0x03;
+}
+
+static inline void hashSlotSetState(uint8_t *states, uint32_t index, uint8_t state) {
+    uint8_t shift = (index & 3) << 1;
+    states[index >> 2] = (uint8_t) ((states[index >> 2] & ~(0x03 << shift)) | (state << shift));
+}
+
+#ifdef HASH_MAP_STATS
+typedef struct HashTableStats {
+    uint32_t size;
+    uint32_t capacity;
+    uint32_t deletedItemsCount;
+    float loadFactor;           // size / capacity
+    float tombstoneRatio;       // deletedItemsCount / capacity
+    float averageProbeLength;   // slots between key home index and its slot, 0 when key is in the home slot
+    uint32_t maxProbeLength;
+    uint64_t totalProbeLength;
+    uint32_t probeLengthHistogram[HASH_STATS_HISTOGRAM_SIZE];   // keys count by probe length
+    uint32_t resizeCount;       // HashMap table grows, buffer Map/Set in place tombstone purges
+    size_t allocatedBytes;      // table struct, entries and key arena
+} HashTableStats;
+
+static inline void hashStatsInit(HashTableStats *stats, uint32_t size, uint32_t capacity, uint32_t deletedItemsCount, uint32_t resizeCount, size_t allocatedBytes) {
+    memset(stats, 0, sizeof(HashTableStats));
+    stats->size = size;
+    stats->capacity = capacity;
+    stats->deletedItemsCount = deletedItemsCount;
+    stats->resizeCount = resizeCount;
+    stats->allocatedBytes = allocatedBytes;
+}
+
+static inline void hashStatsAddProbeLength(HashTableStats *stats, uint32_t probeLength) {
+    stats->probeLengthHistogram[probeLength < HASH_STATS_HISTOGRAM_SIZE ? probeLength : HASH_STATS_HISTOGRAM_SIZE - 1]++;
+    stats->totalProbeLength += probeLength;
+    if (probeLength > stats->maxProbeLength) {
+        stats->maxProbeLength = probeLength;
+    }
+}
+
+static inline void hashStatsComplete(HashTableStats *stats) {
+    uint32_t keyCount = 0;
+    for (uint32_t i = 0; i < HASH_STATS_HISTOGRAM_SIZE; i++) {
+        keyCount += stats->probeLengthHistogram[i];
+    }
+    stats->loadFactor = stats->capacity > 0 ? (float) stats->size / (float) stats->capacity : 0;
+    stats->tombstoneRatio = stats->capacity > 0 ? (float) stats->deletedItemsCount / (float) stats->capacity : 0;
+    stats->averageProbeLength = keyCount > 0 ? (float) stats->totalProbeLength / (float) keyCount : 0;
+}
+#endif
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "HeapVector.h"
+#include "BufferFlatMap.h"
+
+// Heap allocated BufferFlatMap layout: sorted entries are kept in HeapVector, which doubles when full
+// and halves when less than quarter is used, so there is no need to know map size up front.
+
+#define HEAP_FLAT_MAP_MIN_CAPACITY 4
+
+#define HEAP_FLAT_MAP_ENTRIES_TYPEDEF(KEY_NAME, VALUE_NAME) KEY_NAME ## _ ## VALUE_NAME ## MapEntryHeapVec
+#define HEAP_FLAT_MAP_ENTRIES_METHOD(KEY_NAME, VALUE_NAME, POSTFIX) KEY_NAME ## _ ## VALUE_NAME ## MapEntryHeapVec ## POSTFIX
+#define HEAP_FLAT_MAP_NEW_ENTRIES(KEY_NAME, VALUE_NAME) new ## KEY_NAME ## _ ## VALUE_NAME ## MapEntryHeapVec
+
+#define CREATE_HEAP_FLAT_MAP_ENTRIES_VECTOR(ENTRY_TYPE, COMPARE_FUN) CREATE_HEAP_VECTOR_TYPE_NAME(ENTRY_TYPE, ENTRY_TYPE, COMPARE_FUN)
+
+
+#define CREATE_HEAP_FLAT_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN) \
+CREATE_FLAT_MAP_ENTRY_TYPE(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN) \
+CREATE_HEAP_FLAT_MAP_ENTRIES_VECTOR(HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME), HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapEntryComparator)) \
+\
+typedef struct HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) { \
+    HEAP_FLAT_MAP_ENTRIES_TYPEDEF(KEY_NAME, VALUE_NAME) *entries;    /* sorted by key, unique keys */ \
+} HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME); \
+\
+typedef struct HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) {    \
+    KEY_TYPE key;                                                   \
+    VALUE_TYPE value;                                               \
+    HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map;                    \
+    uint32_t index;                                                 \
+    uint32_t endIndex;                                              \
+} HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME);                  \
+                                                                    \
+static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, HeapFlatMap)(uint32_t capacity) { \
+    HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map = malloc(sizeof(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME))); \
+    if (map == NULL) return NULL;       \
+    map->entries = HEAP_FLAT_MAP_NEW_ENTRIES(KEY_NAME, VALUE_NAME)(capacity > HEAP_FLAT_MAP_MIN_CAPACITY ? capacity : HEAP_FLAT_MAP_MIN_CAPACITY); \
+    if (map->entries == NULL) {         \
+        free(map);                      \
+        return NULL;                    \
+    }                                   \
+    return map;                         \
+}                                       \
+\
+static inline uint32_t HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapLowerBound)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    return map != NULL ? HASH_MAP_METHOD(lowerBound, KEY_NAME, VALUE_NAME, MapEntries)(map->entries->items, map->entries->size, key) : 0; \
+}                                   \
+\
+static inline HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    uint32_t index = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapLowerBound)(map, key);   \
+    if (map != NULL && index < map->entries->size && COMPARE_FUN(map->entries->items[index].key, key) == 0) { \
+        return &map->entries->items[index]; \
+    }                                       \
+    return NULL;                            \
+}                                           \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE value) {   \
+    if (map == NULL) return false;          \
+    uint32_t index = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapLowerBound)(map, key); \
+    if (index < map->entries->size && COMPARE_FUN(map->entries->items[index].key, key) == 0) { \
+        map->entries->items[index].value = value;   \
+        return false;                               \
+    }                                               \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) entry = {.key = key, .value = value};  \
+    return index == map->entries->size ?    /* AddAt() can't append to full vector */   \
+           HEAP_FLAT_MAP_ENTRIES_METHOD(KEY_NAME, VALUE_NAME, Add)(map->entries, entry) :   \
+           HEAP_FLAT_MAP_ENTRIES_METHOD(KEY_NAME, VALUE_NAME, AddAt)(map->entries, index, entry); \
+}                                           \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapFromArray)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) entries[], uint32_t length) { \
+    if (map == NULL || (entries == NULL && length > 0)) return false;               \
+    map->entries->size = 0;                                                         \
+    HEAP_FLAT_MAP_ENTRIES_METHOD(KEY_NAME, VALUE_NAME, FromArray)(map->entries, entries, length); \
+    if (map->entries->size != length) {     /* Out of memory, map is left empty */  \
+        map->entries->size = 0;                                                     \
+        return false;                                                               \
+    }                                                                               \
+    if (!HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEntriesSorted)(map->entries->items, length)) { \
+        HASH_MAP_METHOD(sort, KEY_NAME, VALUE_NAME, MapEntries)(map->entries->items, length); \
+    }                                                                               \
+    map->entries->size = HASH_MAP_METHOD(unique, KEY_NAME, VALUE_NAME, MapEntries)(map->entries->items, length); \
+    return true;                                                                    \
+}                                                                                   \
+\
+static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, HeapFlatMapOf)(uint32_t capacity, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint32_t size) { \
+    HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map = HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, HeapFlatMap)(capacity > size ? capacity : size); \
+    if (map != NULL) {                                                  \
+        HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapFromArray)(map, entries, size); \
+    }                                                                   \
+    return map;                                                         \
+}                                                                       \
+\
+static inline uint32_t HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapSize)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return HEAP_FLAT_MAP_ENTRIES_METHOD(KEY_NAME, VALUE_NAME, Size)(map != NULL ? map->entries : NULL); \
+}   \
+\
+static inline bool HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapSize)(map) == 0; \
+}   \
+\
+static inline bool HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return !HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(map); \
+}   \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapContains)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    return HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key) != NULL; \
+}  \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGet)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) {    \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key);  \
+    return entry != NULL ? entry->value : (VALUE_TYPE) {0};     \
+}                                   \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetOrDefault)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE defaultValue) { \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key);  \
+    return entry != NULL ? entry->value : defaultValue;         \
+}                                   \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRemove)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key);  \
+    if (entry == NULL) return (VALUE_TYPE) {0};                 \
+    VALUE_TYPE value = entry->value;    /* RemoveAt() can move entries to smaller array */ \
+    HEAP_FLAT_MAP_ENTRIES_METHOD(KEY_NAME, VALUE_NAME, RemoveAt)(map->entries, (uint32_t) (entry - map->entries->items)); \
+    return value;                                               \
+}                                                               \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAddAll)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *fromMap, HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *toMap) {  \
+    if (fromMap == NULL || toMap == NULL) return;               \
+    for (uint32_t i = 0; i < fromMap->entries->size; i++) {     \
+        HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(toMap, fromMap->entries->items[i].key, fromMap->entries->items[i].value); \
+    }                                                           \
+}                                                               \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapClear)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {    \
+    if (map != NULL) {                                          \
+        HEAP_FLAT_MAP_ENTRIES_METHOD(KEY_NAME, VALUE_NAME, Clear)(map->entries);  \
+    }                                                           \
+}                                                               \
+\
+static inline HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapIter)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) { \
+    HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) iterator = {.map = map, .index = 0, .endIndex = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapSize)(map)}; \
+    return iterator;    \
+}                       \
+\
+static inline HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRangeIter)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE fromKey, KEY_TYPE toKey) { \
+    HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) iterator = {.map = map};                        \
+    iterator.index = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapLowerBound)(map, fromKey);            \
+    iterator.endIndex = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapLowerBound)(map, toKey);   /* toKey itself is excluded */ \
+    return iterator;    \
+}                       \
+\
+static inline uint32_t HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRangeSize)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE fromKey, KEY_TYPE toKey) { \
+    HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) iterator = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRangeIter)(map, fromKey, toKey); \
+    return iterator.endIndex > iterator.index ? iterator.endIndex - iterator.index : 0; \
+}                       \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHasNext)(HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) *iterator) { \
+    if (iterator != NULL && iterator->map != NULL && iterator->index < iterator->endIndex && iterator->index < iterator->map->entries->size) { \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *pair = &iterator->map->entries->items[iterator->index++]; \
+        iterator->key = pair->key;          \
+        iterator->value = pair->value;      \
+        return true;                        \
+    }                                       \
+    return false;                           \
+}                                           \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapDelete)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) { \
+    if (map != NULL) {          \
+        HEAP_FLAT_MAP_ENTRIES_METHOD(KEY_NAME, VALUE_NAME, Delete)(map->entries); \
+        free(map);              \
+    }                           \
+}                               \
+
+
+
+#define CREATE_HEAP_FLAT_MAP_TYPE_1(KEY_TYPE, VALUE_TYPE) CREATE_HEAP_FLAT_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_TYPE, VALUE_TYPE, COMPARATOR_FOR_TYPE(KEY_TYPE))
+#define CREATE_HEAP_FLAT_MAP_TYPE_2(KEY_TYPE, VALUE_TYPE, KEY_NAME) CREATE_HEAP_FLAT_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, COMPARATOR_FOR_TYPE(KEY_TYPE))
+#define CREATE_HEAP_FLAT_MAP_TYPE_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME) CREATE_HEAP_FLAT_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARATOR_FOR_TYPE(KEY_TYPE))
+#define CREATE_HEAP_FLAT_MAP_TYPE_4(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN) CREATE_HEAP_FLAT_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN)
+
+#define CREATE_HEAP_FLAT_MAP_TYPE(...)                                \
+    CREATE_FLAT_MAP_TYPE_MACRO(__VA_ARGS__,                           \
+                        CREATE_HEAP_FLAT_MAP_TYPE_4,                  \
+                        CREATE_HEAP_FLAT_MAP_TYPE_3,                  \
+                        CREATE_HEAP_FLAT_MAP_TYPE_2,                  \
+                        CREATE_HEAP_FLAT_MAP_TYPE_1,                  \
+                        ERROR)(__VA_ARGS__)
+
+
+#define NEW_HEAP_FLAT_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, CAPACITY) HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, HeapFlatMap)(CAPACITY)
+#define NEW_HEAP_FLAT_MAP_2(KEY_TYPE, VALUE_TYPE, KEY_NAME, CAPACITY) NEW_HEAP_FLAT_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, CAPACITY)
+#define NEW_HEAP_FLAT_MAP_1(KEY_TYPE, VALUE_TYPE, CAPACITY) NEW_HEAP_FLAT_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_TYPE, VALUE_TYPE, CAPACITY)
+
+#define NEW_HEAP_FLAT_MAP(...)                                \
+    NEW_HASH_MAP_MACRO(__VA_ARGS__,                           \
+                        NEW_HEAP_FLAT_MAP_3,                  \
+                        NEW_HEAP_FLAT_MAP_2,                  \
+                        NEW_HEAP_FLAT_MAP_1,                  \
+                        ERROR)(__VA_ARGS__)
+
+#define NEW_HEAP_FLAT_MAP_OF(CAPACITY, KEY_NAME, VALUE_NAME, ...) \
+HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, HeapFlatMapOf)(CAPACITY,                                 \
+                                                          (HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) []){__VA_ARGS__}, \
+                                                          VAR_ARGS_LENGTH(HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME), __VA_ARGS__))
+
+#define HEAP_FLAT_MAP_OF(KEY_NAME, VALUE_NAME, ...) HASH_MAP_OF_WITH(NEW_HEAP_FLAT_MAP_OF, KEY_NAME, VALUE_NAME, __VA_ARGS__)
@@ -0,0 +1,304 @@
+#pragma once
+
+#include "BufferHashMap.h"
+
+// Heap allocated BufferHashMap layout that grows instead of rejecting adds when half full.
+// Keys and values are stored by value in the typed entries, comparator and hash function are inlined same as in `CREATE_HASH_MAP_TYPE`.
+// Table is doubled when used and deleted slots reach half of capacity, or rebuilt at the same size when most of them are tombstones.
+
+#define HEAP_HASH_MAP_MIN_CAPACITY 8
+#define HEAP_HASH_MAP_ALIGN_CAPACITY(CAPACITY) ((CAPACITY) > (HEAP_HASH_MAP_MIN_CAPACITY / HASH_MAP_EXPAND_FACTOR) ? HASH_MAP_ALIGN_CAPACITY(CAPACITY) : HEAP_HASH_MAP_MIN_CAPACITY)
+
+
+#define CREATE_HEAP_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN) \
+typedef struct HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) { \
+    KEY_TYPE key;               \
+    VALUE_TYPE value;           \
+    bool isDeleted;             \
+    bool isEmptySlot;           \
+} HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME); \
+\
+typedef struct HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) { \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries; \
+    uint32_t size;                  \
+    uint32_t capacity;              \
+    uint32_t deletedItemsCount;     \
+    uint32_t seed;                  \
+} HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME); \
+\
+typedef struct HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) {    \
+    KEY_TYPE key;                                                   \
+    VALUE_TYPE value;                                               \
+    HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map;                    \
+    uint32_t index;                                                 \
+} HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME);                  \
+                                                                    \
+static inline HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, MapEntries)(uint32_t capacity) { \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries = malloc(capacity * sizeof(HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME))); \
+    if (entries == NULL) return NULL;               \
+    for (uint32_t i = 0; i < capacity; i++) {       \
+        entries[i].key = (KEY_TYPE) {0};            \
+        entries[i].value = (VALUE_TYPE) {0};        \
+        entries[i].isDeleted = false;               \
+        entries[i].isEmptySlot = true;              \
+    }                                               \
+    return entries;                                 \
+}                                                   \
+\
+static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, HeapMap)(uint32_t capacity) { \
+    HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map = malloc(sizeof(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME))); \
+    if (map == NULL) return NULL;       \
+    map->capacity = HEAP_HASH_MAP_ALIGN_CAPACITY(capacity); \
+    map->entries = HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, MapEntries)(map->capacity); \
+    if (map->entries == NULL) {         \
+        free(map);                      \
+        return NULL;                    \
+    }                                   \
+    map->size = 0;                      \
+    map->deletedItemsCount = 0;         \
+    map->seed = HASH_MAP_NEW_SEED();    \
+    return map;                         \
+}                                       \
+\
+static inline uint32_t HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHomeIndex)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    return HASH_MAP_KEY_HASH_CODE(HASH_FUN, key, map->seed) & (map->capacity - 1); \
+}                                                               \
+\
+static inline HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *tombstone = NULL;     \
+    uint32_t index = HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHomeIndex)(map, key); \
+                                                                \
+    while (true) {                                              \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = &map->entries[index]; \
+        if (entry->isEmptySlot) {                               \
+            if (!entry->isDeleted) {                            \
+                return tombstone != NULL ? tombstone : entry;   \
+            } else {                                            \
+                if (tombstone == NULL) {                        \
+                    tombstone = entry;                          \
+                }                                               \
+            }                                                   \
+        } else if (COMPARE_FUN(key, entry->key) == 0) {         \
+            return entry;                                       \
+        }                                                       \
+        index = (index + 1) & (map->capacity - 1);              \
+    }                                                           \
+}                                                               \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRehash)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, uint32_t capacity) { \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *newEntries = HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, MapEntries)(capacity); \
+    if (newEntries == NULL) return false;   \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *oldEntries = map->entries;  \
+    uint32_t oldCapacity = map->capacity;   \
+    map->entries = newEntries;              \
+    map->capacity = capacity;               \
+    map->deletedItemsCount = 0;             \
+                                            \
+    for (uint32_t i = 0; i < oldCapacity; i++) {    \
+        if (!oldEntries[i].isEmptySlot) {           \
+            HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, oldEntries[i].key); \
+            *entry = oldEntries[i];                 \
+        }                                           \
+    }                                               \
+    free(oldEntries);                               \
+    return true;                                    \
+}                                                   \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapReserve)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, uint32_t count) { \
+    if (map == NULL) return false;                                              \
+    uint32_t capacity = HEAP_HASH_MAP_ALIGN_CAPACITY(count);                    \
+    if (capacity <= map->capacity) return true;   /* already fits `count` entries without growing */ \
+    return HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRehash)(map, capacity);     \
+}                                                                               \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapShrinkToFit)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) { \
+    if (map == NULL) return false;                                              \
+    uint32_t capacity = HEAP_HASH_MAP_ALIGN_CAPACITY(map->size);                \
+    if (capacity >= map->capacity && map->deletedItemsCount == 0) return true;  \
+    return HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRehash)(map, capacity < map->capacity ? capacity : map->capacity); \
+}                                                                               \
+\
+static inline HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(insert, KEY_NAME, VALUE_NAME, MapEntry)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE value) { \
+    if (map == NULL) return NULL;           \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key); \
+    if (!entry->isEmptySlot) return entry;  /* Existing key entry is returned as is */ \
+                                            \
+    if (!entry->isDeleted && (map->size + map->deletedItemsCount) >= (map->capacity / HASH_MAP_EXPAND_FACTOR)) { \
+        bool isMostlyDeleted = map->deletedItemsCount > map->size;  /* tombstones are dropped without growing */ \
+        uint32_t capacity = isMostlyDeleted ? map->capacity : HASH_MAP_BUFFER_EXPAND_FACTOR(map->capacity); \
+        if (!HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRehash)(map, capacity)) return NULL;                  \
+        entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key);                            \
+    }                                       \
+                                            \
+    if (entry->isDeleted) {                 \
+        map->deletedItemsCount--;           \
+    }                                       \
+    entry->key = key;                       \
+    entry->value = value;                   \
+    entry->isDeleted = false;               \
+    entry->isEmptySlot = false;             \
+    map->size++;                            \
+    return entry;                           \
+}                                           \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE value) {   \
+    uint32_t size = map != NULL ? map->size : 0;    \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(insert, KEY_NAME, VALUE_NAME, MapEntry)(map, key, value); \
+    if (entry == NULL) return false;        \
+    entry->value = value;                   \
+    return map->size != size;               \
+}                                           \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapUpsert)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE value, VALUE_TYPE (*merge)(VALUE_TYPE, VALUE_TYPE)) { \
+    uint32_t size = map != NULL ? map->size : 0;    \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(insert, KEY_NAME, VALUE_NAME, MapEntry)(map, key, value); \
+    if (entry == NULL) return false;                \
+    if (map->size == size) {    /* Existing key, merged with the new value in the same probe */ \
+        entry->value = merge != NULL ? merge(entry->value, value) : value; \
+    }                                               \
+    return true;                                    \
+}                                                   \
+\
+static inline VALUE_TYPE * HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetOrAddSlot)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE defaultValue) { \
+    HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(insert, KEY_NAME, VALUE_NAME, MapEntry)(map, key, defaultValue); \
+    return entry != NULL ? &entry->value : NULL;    /* Slot is valid until the next add or remove */ \
+}                                                   \
+\
+static inline HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) * HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, HeapMapOf)(uint32_t capacity, HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entries, uint32_t size) { \
+    HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map = HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, HeapMap)(capacity);   \
+    if (map == NULL || entries == NULL) return map;                                                 \
+    for (uint32_t i = 0; i < size; i++) {                                                           \
+        HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(map, entries[i].key, entries[i].value);       \
+    }                                                                                               \
+    return map;                                                                                     \
+}                                                                                                   \
+\
+static inline uint32_t HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapSize)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return map != NULL ? map->size : 0; \
+}   \
+\
+static inline bool HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {  \
+    return map != NULL ? map->size == 0 : true; \
+}   \
+\
+static inline bool HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {   \
+    return !HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(map);        \
+}   \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapContains)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapEmpty)(map)) return false;                                               \
+    return !HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key)->isEmptySlot;                                     \
+}  \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetOrDefault)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key, VALUE_TYPE defaultValue) { \
+    if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(map)) { \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key); \
+        return !entry->isEmptySlot ? entry->value : defaultValue;      \
+    }                               \
+    return defaultValue;            \
+}                                   \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGet)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) {    \
+    return HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapGetOrDefault)(map, key, (VALUE_TYPE) {0}); \
+}                                   \
+\
+static inline VALUE_TYPE HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapRemove)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map, KEY_TYPE key) { \
+    if (HASH_MAP_METHOD(is, KEY_NAME, VALUE_NAME, MapNotEmpty)(map)) {                                                          \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = HASH_MAP_METHOD(find, KEY_NAME, VALUE_NAME, MapEntry)(map, key);  \
+        if (entry->isEmptySlot) return (VALUE_TYPE) {0};                 \
+        VALUE_TYPE value = entry->value;    \
+        entry->key = (KEY_TYPE) {0};        \
+        entry->value = (VALUE_TYPE) {0};    \
+        entry->isDeleted = true;            \
+        entry->isEmptySlot = true;          \
+        map->size--;                        \
+        map->deletedItemsCount++;           \
+        return value;                       \
+    }                                       \
+    return (VALUE_TYPE) {0};                \
+}                                           \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAddAll)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *fromMap, HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *toMap) {  \
+    for (uint32_t i = 0; i < fromMap->capacity; i++) {                                        \
+        HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *entry = &fromMap->entries[i];           \
+        if (!entry->isEmptySlot) {                                                            \
+            HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapAdd)(toMap, entry->key, entry->value);   \
+        }   \
+    }       \
+}           \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapClear)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) {    \
+    if (map != NULL && map->entries != NULL) {          \
+        for (uint32_t i = 0; i < map->capacity; i++) {  \
+            map->entries[i].key = (KEY_TYPE) {0};       \
+            map->entries[i].value = (VALUE_TYPE) {0};   \
+            map->entries[i].isDeleted = false;          \
+            map->entries[i].isEmptySlot = true;         \
+        }                                               \
+        map->size = 0;                                  \
+        map->deletedItemsCount = 0;                     \
+    }                                                   \
+}                                                       \
+\
+static inline HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapIter)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) { \
+    HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) iterator = {.map = map, .index = 0};    \
+    return iterator;    \
+}                       \
+\
+static inline bool HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapHasNext)(HASH_MAP_ITERATOR_TYPEDEF(KEY_NAME, VALUE_NAME) *iterator) { \
+    if (iterator != NULL && iterator->map != NULL) {        \
+        HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map = iterator->map;  \
+        while (iterator->index < map->capacity) {           \
+            HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) *pair = &map->entries[iterator->index++]; \
+            if (!pair->isEmptySlot) {                       \
+                iterator->key = pair->key;                  \
+                iterator->value = pair->value;              \
+                return true;                                \
+            }                                               \
+        }                                                   \
+    }                                                       \
+    return false;                                           \
+}                                                           \
+\
+static inline void HASH_MAP_METHOD(KEY_NAME, VALUE_NAME, MapDelete)(HASH_MAP_TYPEDEF(KEY_NAME, VALUE_NAME) *map) { \
+    if (map != NULL) {          \
+        free(map->entries);     \
+        free(map);              \
+    }                           \
+}                               \
+
+
+
+#define CREATE_HEAP_HASH_MAP_TYPE_1(KEY_TYPE, VALUE_TYPE) CREATE_HEAP_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_TYPE, VALUE_TYPE, COMPARATOR_FOR_TYPE(KEY_TYPE), HASH_CODE_FOR_TYPE(KEY_TYPE))
+#define CREATE_HEAP_HASH_MAP_TYPE_2(KEY_TYPE, VALUE_TYPE, KEY_NAME) CREATE_HEAP_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, COMPARATOR_FOR_TYPE(KEY_TYPE), HASH_CODE_FOR_TYPE(KEY_TYPE))
+#define CREATE_HEAP_HASH_MAP_TYPE_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME) CREATE_HEAP_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARATOR_FOR_TYPE(KEY_TYPE), HASH_CODE_FOR_TYPE(KEY_TYPE))
+#define CREATE_HEAP_HASH_MAP_TYPE_4(KEY_TYPE, VALUE_TYPE, KEY_NAME, COMPARE_FUN, HASH_FUN) CREATE_HEAP_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, COMPARE_FUN, HASH_FUN)
+#define CREATE_HEAP_HASH_MAP_TYPE_5(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN) CREATE_HEAP_HASH_MAP_TYPE_NAME(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, COMPARE_FUN, HASH_FUN)
+
+#define CREATE_HEAP_HASH_MAP_TYPE(...)                                \
+    CREATE_HASH_MAP_TYPE_MACRO(__VA_ARGS__,                           \
+                        CREATE_HEAP_HASH_MAP_TYPE_5,                  \
+                        CREATE_HEAP_HASH_MAP_TYPE_4,                  \
+                        CREATE_HEAP_HASH_MAP_TYPE_3,                  \
+                        CREATE_HEAP_HASH_MAP_TYPE_2,                  \
+                        CREATE_HEAP_HASH_MAP_TYPE_1,                  \
+                        ERROR)(__VA_ARGS__)
+
+
+#define NEW_HEAP_HASH_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_NAME, CAPACITY) HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, HeapMap)(CAPACITY)
+#define NEW_HEAP_HASH_MAP_2(KEY_TYPE, VALUE_TYPE, KEY_NAME, CAPACITY) NEW_HEAP_HASH_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_NAME, VALUE_TYPE, CAPACITY)
+#define NEW_HEAP_HASH_MAP_1(KEY_TYPE, VALUE_TYPE, CAPACITY) NEW_HEAP_HASH_MAP_3(KEY_TYPE, VALUE_TYPE, KEY_TYPE, VALUE_TYPE, CAPACITY)
+
+#define NEW_HEAP_HASH_MAP(...)                                \
+    NEW_HASH_MAP_MACRO(__VA_ARGS__,                           \
+                        NEW_HEAP_HASH_MAP_3,                  \
+                        NEW_HEAP_HASH_MAP_2,                  \
+                        NEW_HEAP_HASH_MAP_1,                  \
+                        ERROR)(__VA_ARGS__)
+
+#define NEW_HEAP_HASH_MAP_OF(CAPACITY, KEY_NAME, VALUE_NAME, ...) \
+HASH_MAP_METHOD(new, KEY_NAME, VALUE_NAME, HeapMapOf)(CAPACITY,                                 \
+                                                      (HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME) []){__VA_ARGS__}, \
+                                                      VAR_ARGS_LENGTH(HASH_MAP_ENTRY_TYPEDEF(KEY_NAME, VALUE_NAME), __VA_ARGS__))
+
+#define HEAP_HASH_MAP_OF(KEY_NAME, VALUE_NAME, ...) HASH_MAP_OF_WITH(NEW_HEAP_HASH_MAP_OF, KEY_NAME, VALUE_NAME, __VA_ARGS__)
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ConcurrentHashMap.h"
+
+#ifndef READ_MOSTLY_HASH_MAP_MAX_READERS
+#define READ_MOSTLY_HASH_MAP_MAX_READERS 64  // Reader slots used when 0 passed on creation
+#endif
+
+#define READ_MOSTLY_READER_IDLE 0   // reader epoch outside of read section
+
+typedef struct ReadMostlyHashMap *ReadMostlyHashMap;
+
+typedef struct ReadMostlyReader {
+    uint64_t epoch;         // global epoch seen on read section start, READ_MOSTLY_READER_IDLE otherwise
+    uint32_t isRegistered;
+    char padding[CONCURRENT_HASH_MAP_CACHE_LINE_SIZE];  // each reader writes only own cache line
+} ReadMostlyReader;
+
+typedef struct RetiredHashMap {
+    HashMap hashMap;
+    uint64_t epoch;     // freed when all active readers started after this epoch
+    struct RetiredHashMap *next;
+} RetiredHashMap;
+
+struct ReadMostlyHashMap {
+    HashMap snapshot;   // published table, never changed after publish
+    uint64_t epoch;
+    uint32_t size;
+    pthread_mutex_t writeLock;  // writers copy snapshot one at a time
+    RetiredHashMap *retired;
+    ReadMostlyReader *readers;
+    uint32_t readerCount;
+};
+
+ReadMostlyHashMap getReadMostlyHashMapInstance(uint32_t capacity, uint32_t maxReaders);
+
+ReadMostlyReader *readMostlyHashMapRegisterReader(ReadMostlyHashMap map);    // once per reader thread, NULL when all reader slots taken
+void readMostlyHashMapUnregisterReader(ReadMostlyReader *reader);
+
+MapValueType readMostlyHashMapGet(ReadMostlyHashMap map, ReadMostlyReader *reader, const char *key);
+MapValueType readMostlyHashMapGetN(ReadMostlyHashMap map, ReadMostlyReader *reader, const char *key, uint32_t length);
+HashMap readMostlyHashMapReadBegin(ReadMostlyHashMap map, ReadMostlyReader *reader);  // snapshot stays valid until ReadEnd(), read only
+void readMostlyHashMapReadEnd(ReadMostlyReader *reader);
+
+bool readMostlyHashMapPut(ReadMostlyHashMap map, const char *key, MapValueType value);
+bool readMostlyHashMapPutAll(ReadMostlyHashMap map, HashMap from);  // many updates for the price of single table copy
+MapValueType readMostlyHashMapRemove(ReadMostlyHashMap map, const char *key);
+bool readMostlyHashMapClear(ReadMostlyHashMap map);
+uint32_t getReadMostlyHashMapSize(ReadMostlyHashMap map);
+
+void readMostlyHashMapDelete(ReadMostlyHashMap map);
@@ -0,0 +1,372 @@
+// Build time generator of minimal perfect hash map header for the fixed set of string keys.
+// Input file has one entry per line: key, whitespace and value as C expression, lines starting with '#' are skipped:
+//     start   startCommandHandler
+//     stop    stopCommandHandler
+// Usage: PerfectHashGenerator <input> <output.h> <name> <value type> [header to include]...
+// Lookup in generated table is one hash, one entry probe and one key compare, all data is `static const`.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <ctype.h>
+
+#define MAX_LINE_LENGTH 1024
+#define KEYS_PER_BUCKET 4
+#define MAX_SEED_ATTEMPTS 10000000
+
+// ${name}, ${type}, ${buckets} and ${size} are replaced with map name, value type, bucket count and key count
+static const char *LOOKUP_TEMPLATE =
+        "static inline uint32_t ${name}MapMix(uint32_t hash) {\n"
+        "    hash ^= hash >> 16;\n"
+        "    hash *= 0x85EBCA6B;\n"
+        "    hash ^= hash >> 13;\n"
+        "    hash *= 0xC2B2AE35;\n"
+        "    hash ^= hash >> 16;\n"
+        "    return hash;\n"
+        "}\n"
+        "\n"
+        "static inline const ${name}MapEntry *${name}MapFindEntry(const char *key, uint32_t length, uint32_t hash) {\n"
+        "    uint32_t bucket = (uint32_t) (((uint64_t) hash * ${buckets}) >> 32);\n"
+        "    uint32_t index = (uint32_t) (((uint64_t) ${name}MapMix(hash ^ ${name}MapSeeds[bucket]) * ${size}) >> 32);\n"
+        "    const ${name}MapEntry *entry = &${name}MapEntries[index];\n"
+        "    return entry->keyLength == length && memcmp(entry->key, key, length) == 0 ? entry : NULL;\n"
+        "}\n"
+        "\n"
+        "static inline const ${name}MapEntry *${name}MapGetEntry(const char *key, uint32_t length) {\n"
+        "    uint32_t hash = 2166136261u;\n"
+        "    for (uint32_t i = 0; i < length; i++) {\n"
+        "        hash ^= (uint8_t) key[i];\n"
+        "        hash *= 16777619;\n"
+        "    }\n"
+        "    return ${name}MapFindEntry(key, length, hash);\n"
+        "}\n"
+        "\n"
+        "static inline const ${name}MapEntry *${name}MapGetEntryOf(const char *key) {  // hash and length in one pass\n"
+        "    uint32_t hash = 2166136261u;\n"
+        "    uint32_t length = 0;\n"
+        "    for (; key[length] != '\\0'; length++) {\n"
+        "        hash ^= (uint8_t) key[length];\n"
+        "        hash *= 16777619;\n"
+        "    }\n"
+        "    return ${name}MapFindEntry(key, length, hash);\n"
+        "}\n"
+        "\n"
+        "static inline ${type} ${name}MapGetN(const char *key, uint32_t length) {\n"
+        "    const ${name}MapEntry *entry = ${name}MapGetEntry(key, length);\n"
+        "    return entry != NULL ? entry->value : (${type}) {0};\n"
+        "}\n"
+        "\n"
+        "static inline ${type} ${name}MapGet(const char *key) {\n"
+        "    const ${name}MapEntry *entry = ${name}MapGetEntryOf(key);\n"
+        "    return entry != NULL ? entry->value : (${type}) {0};\n"
+        "}\n"
+        "\n"
+        "static inline bool ${name}MapContains(const char *key) {\n"
+        "    return ${name}MapGetEntryOf(key) != NULL;\n"
+        "}\n";
+
+typedef struct KeyEntry {
+    char *key;
+    uint32_t keyLength;
+    char *value;
+    uint32_t hash;
+} KeyEntry;
+
+typedef struct Bucket {
+    uint32_t index;
+    uint32_t size;
+    uint32_t *keys;
+} Bucket;
+
+static uint32_t keyHash(const char *key, uint32_t length);
+static uint32_t mixHash(uint32_t hash);
+static uint32_t reduceHash(uint32_t hash, uint32_t range);
+static uint32_t readEntries(FILE *input, KeyEntry **entries);
+static bool findSeeds(KeyEntry *entries, uint32_t count, uint32_t bucketCount, uint32_t *seeds, uint32_t *slots);
+static int compareBucketsBySize(const void *one, const void *two);
+static bool writeHeader(FILE *output, const char *name, const char *valueType, char **includes, uint32_t includeCount,
+                        KeyEntry *entries, uint32_t count, const uint32_t *seeds, uint32_t bucketCount, const uint32_t *slots);
+static void writeCString(FILE *output, const char *text);
+static void writeTemplate(FILE *output, const char *template, const char *name, const char *valueType, uint32_t bucketCount, uint32_t count);
+static char *copyString(const char *text);
+static void freeEntries(KeyEntry *entries, uint32_t count);
+
+
+int main(int argc, char *argv[]) {
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <input> <output.h> <name> <value type> [header to include]...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE *input = fopen(argv[1], "r");
+    if (input == NULL) {
+        fprintf(stderr, "Can't open input file: %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    KeyEntry *entries = NULL;
+    uint32_t count = readEntries(input, &entries);
+    fclose(input);
+    if (count == 0) {
+        fprintf(stderr, "No keys found in: %s\n", argv[1]);
+        free(entries);
+        return EXIT_FAILURE;
+    }
+
+    uint32_t bucketCount = (count + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET;
+    uint32_t *seeds = calloc(bucketCount, sizeof(uint32_t));
+    uint32_t *slots = malloc(count * sizeof(uint32_t));
+    int status = EXIT_FAILURE;
+    FILE *output = NULL;
+    if (seeds == NULL || slots == NULL || !findSeeds(entries, count, bucketCount, seeds, slots)) {
+        fprintf(stderr, "Perfect hash not found for keys from: %s\n", argv[1]);
+    } else if ((output = fopen(argv[2], "w")) == NULL) {
+        fprintf(stderr, "Can't open output file: %s\n", argv[2]);
+    } else {
+        bool isWritten = writeHeader(output, argv[3], argv[4], &argv[5], argc - 5, entries, count, seeds, bucketCount, slots);
+        isWritten = !ferror(output) && isWritten;
+        if (fclose(output) == 0 && isWritten) {   // buffered data is flushed on close, so disk full shows up here
+            status = EXIT_SUCCESS;
+        } else {
+            fprintf(stderr, "Can't write output file: %s\n", argv[2]);
+            remove(argv[2]);    // don't leave truncated header for the next incremental build
+        }
+    }
+
+    free(seeds);
+    free(slots);
+    freeEntries(entries, count);
+    return status;
+}
+
+static uint32_t keyHash(const char *key, uint32_t length) {   // FNV-1a, must match hash in generated header
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < length; i++) {
+        hash ^= (uint8_t) key[i];
+        hash *= 16777619;
+    }
+    return hash;
+}
+
+static uint32_t mixHash(uint32_t hash) {  // murmur3 finalizer
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6B;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+static uint32_t reduceHash(uint32_t hash, uint32_t range) {    // maps hash to [0, range) without division
+    return (uint32_t) (((uint64_t) hash * range) >> 32);
+}
+
+static uint32_t readEntries(FILE *input, KeyEntry **entries) {
+    char line[MAX_LINE_LENGTH];
+    uint32_t count = 0;
+    uint32_t capacity = 0;
+    uint32_t lineNumber = 0;
+
+    while (fgets(line, sizeof(line), input) != NULL) {
+        lineNumber++;
+        size_t lineLength = strlen(line);
+        if (lineLength == sizeof(line) - 1 && line[lineLength - 1] != '\n') {
+            int next = fgetc(input);
+            if (next != EOF) {  // fgets would return rest of the line as next entry
+                fprintf(stderr, "Line %u: longer than %d characters\n", lineNumber, MAX_LINE_LENGTH - 2);
+                exit(EXIT_FAILURE);
+            }
+        }
+        char *key = line;
+        while (isspace((unsigned char) *key)) key++;
+        if (*key == '\0' || *key == '#') continue;
+
+        char *keyEnd = key;
+        while (*keyEnd != '\0' && !isspace((unsigned char) *keyEnd)) keyEnd++;
+        char *value = keyEnd;
+        while (isspace((unsigned char) *value)) value++;
+        char *valueEnd = value + strlen(value);
+        while (valueEnd > value && isspace((unsigned char) valueEnd[-1])) valueEnd--;
+        if (value == valueEnd) {
+            fprintf(stderr, "Line %u: value is missing for key\n", lineNumber);
+            exit(EXIT_FAILURE);
+        }
+        *keyEnd = '\0';
+        *valueEnd = '\0';
+
+        uint32_t keyLength = keyEnd - key;
+        for (uint32_t i = 0; i < count; i++) {
+            if ((*entries)[i].keyLength == keyLength && memcmp((*entries)[i].key, key, keyLength) == 0) {
+                fprintf(stderr, "Line %u: duplicated key: %s\n", lineNumber, key);
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        if (count == capacity) {
+            capacity = capacity == 0 ? 64 : capacity * 2;
+            *entries = realloc(*entries, capacity * sizeof(KeyEntry));
+            if (*entries == NULL) exit(EXIT_FAILURE);
+        }
+        KeyEntry *entry = &(*entries)[count++];
+        entry->key = copyString(key);
+        entry->keyLength = keyLength;
+        entry->value = copyString(value);
+        entry->hash = keyHash(key, keyLength);
+    }
+    return count;
+}
+
+static bool findSeeds(KeyEntry *entries, uint32_t count, uint32_t bucketCount, uint32_t *seeds, uint32_t *slots) {
+    Bucket *buckets = calloc(bucketCount, sizeof(Bucket));
+    uint32_t *bucketKeys = malloc(count * sizeof(uint32_t));
+    bool *isSlotUsed = calloc(count, sizeof(bool));
+    uint32_t *candidateSlots = malloc(count * sizeof(uint32_t));
+    bool isFound = buckets != NULL && bucketKeys != NULL && isSlotUsed != NULL && candidateSlots != NULL;
+    if (isFound) {
+        for (uint32_t i = 0; i < count; i++) {
+            buckets[reduceHash(entries[i].hash, bucketCount)].size++;
+        }
+        uint32_t offset = 0;
+        for (uint32_t i = 0; i < bucketCount; i++) {
+            buckets[i].index = i;
+            buckets[i].keys = &bucketKeys[offset];
+            offset += buckets[i].size;
+            buckets[i].size = 0;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            Bucket *bucket = &buckets[reduceHash(entries[i].hash, bucketCount)];
+            bucket->keys[bucket->size++] = i;
+        }
+        qsort(buckets, bucketCount, sizeof(Bucket), compareBucketsBySize);  // Largest buckets first, while most of slots are free
+    }
+
+    for (uint32_t i = 0; isFound && i < bucketCount && buckets[i].size > 0; i++) {
+        Bucket *bucket = &buckets[i];
+        bool isPlaced = false;
+        for (uint32_t seed = 1; seed <= MAX_SEED_ATTEMPTS && !isPlaced; seed++) {
+            isPlaced = true;
+            for (uint32_t j = 0; j < bucket->size && isPlaced; j++) {
+                uint32_t slot = reduceHash(mixHash(entries[bucket->keys[j]].hash ^ seed), count);
+                isPlaced = !isSlotUsed[slot];
+                for (uint32_t k = 0; k < j && isPlaced; k++) {
+                    isPlaced = candidateSlots[k] != slot;
+                }
+                candidateSlots[j] = slot;
+            }
+
+            if (isPlaced) {
+                seeds[bucket->index] = seed;
+                for (uint32_t j = 0; j < bucket->size; j++) {
+                    isSlotUsed[candidateSlots[j]] = true;
+                    slots[bucket->keys[j]] = candidateSlots[j];
+                }
+            }
+        }
+        isFound = isPlaced;    // Keys with equal 32 bit hash can't be separated by any seed
+    }
+
+    free(buckets);
+    free(bucketKeys);
+    free(isSlotUsed);
+    free(candidateSlots);
+    return isFound;
+}
+
+static int compareBucketsBySize(const void *one, const void *two) {
+    const Bucket *bucketOne = one;
+    const Bucket *bucketTwo = two;
+    if (bucketOne->size != bucketTwo->size) {
+        return bucketOne->size < bucketTwo->size ? 1 : -1;
+    }
+    return bucketOne->index < bucketTwo->index ? -1 : 1;
+}
+
+static bool writeHeader(FILE *output, const char *name, const char *valueType, char **includes, uint32_t includeCount,
+                        KeyEntry *entries, uint32_t count, const uint32_t *seeds, uint32_t bucketCount, const uint32_t *slots) {
+    fprintf(output, "// Generated by PerfectHashGenerator, do not edit\n");
+    fprintf(output, "#pragma once\n\n");
+    fprintf(output, "#include <stdint.h>\n#include <stdbool.h>\n#include <string.h>\n");
+    for (uint32_t i = 0; i < includeCount; i++) {
+        fprintf(output, "#include \"%s\"\n", includes[i]);
+    }
+
+    fprintf(output, "\n#define %sMapSize %u\n\n", name, count);
+    fprintf(output, "typedef struct %sMapEntry {\n", name);
+    fprintf(output, "    const char *key;\n    uint32_t keyLength;\n    %s value;\n", valueType);
+    fprintf(output, "} %sMapEntry;\n\n", name);
+
+    fprintf(output, "static const uint32_t %sMapSeeds[%u] = {", name, bucketCount);
+    for (uint32_t i = 0; i < bucketCount; i++) {
+        fprintf(output, "%s%u", i % 16 == 0 ? "\n        " : " ", seeds[i]);
+        if (i + 1 < bucketCount) fputc(',', output);
+    }
+    fprintf(output, "\n};\n\n");
+
+    KeyEntry **table = malloc(count * sizeof(KeyEntry *));
+    if (table == NULL) return false;
+    for (uint32_t i = 0; i < count; i++) {
+        table[slots[i]] = &entries[i];
+    }
+    fprintf(output, "static const %sMapEntry %sMapEntries[%u] = {\n", name, name, count);
+    for (uint32_t i = 0; i < count; i++) {
+        fprintf(output, "        {");
+        writeCString(output, table[i]->key);
+        fprintf(output, ", %u, %s}%s\n", table[i]->keyLength, table[i]->value, i + 1 < count ? "," : "");
+    }
+    fprintf(output, "};\n\n");
+    free(table);
+
+    writeTemplate(output, LOOKUP_TEMPLATE, name, valueType, bucketCount, count);
+    return true;
+}
+
+static void writeTemplate(FILE *output, const char *template, const char *name, const char *valueType, uint32_t bucketCount, uint32_t count) {
+    for (const char *ch = template; *ch != '\0'; ch++) {
+        if (strncmp(ch, "${name}", 7) == 0) {
+            fputs(name, output);
+            ch += 6;
+        } else if (strncmp(ch, "${type}", 7) == 0) {
+            fputs(valueType, output);
+            ch += 6;
+        } else if (strncmp(ch, "${buckets}", 10) == 0) {
+            fprintf(output, "%uu", bucketCount);
+            ch += 9;
+        } else if (strncmp(ch, "${size}", 7) == 0) {
+            fprintf(output, "%uu", count);
+            ch += 6;
+        } else {
+            fputc(*ch, output);
+        }
+    }
+}
+
+static char *copyString(const char *text) {
+    size_t length = strlen(text) + 1;
+    char *copy = malloc(length);
+    if (copy == NULL) exit(EXIT_FAILURE);
+    return memcpy(copy, text, length);
+}
+
+static void freeEntries(KeyEntry *entries, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        free(entries[i].key);
+        free(entries[i].value);
+    }
+    free(entries);
+}
+
+static void writeCString(FILE *output, const char *text) {
+    fputc('"', output);
+    for (const char *ch = text; *ch != '\0'; ch++) {
+        if (*ch == '"' || *ch == '\\') {
+            fputc('\\', output);
+            fputc(*ch, output);
+        } else if (isprint((unsigned char) *ch)) {
+            fputc(*ch, output);
+        } else {
+            fprintf(output, "\\%03o", (unsigned char) *ch);
+        }
+    }
+    fputc('"', output);
+}